@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON outputs and flags regressions.
+
+Usage: compare.py BASELINE CURRENT [--threshold 0.05] [--metric real_time]
+
+Benchmarks are matched by name. When the runs used repetitions, the median
+aggregate is compared; otherwise the single measurement. A benchmark whose
+time grew by more than the threshold is a regression, and the script exits
+with status 1 if there is any.
+"""
+
+import argparse
+import json
+import sys
+
+NANOSECONDS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path, metric):
+    """Returns {name: time in nanoseconds} for the benchmarks in path."""
+    with open(path, encoding="utf-8") as file:
+        benchmarks = json.load(file)["benchmarks"]
+
+    medians = {}
+    singles = {}
+    for benchmark in benchmarks:
+        if benchmark.get("error_occurred"):
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        unit = benchmark.get("time_unit", "ns")
+        time = benchmark[metric] * NANOSECONDS[unit]
+        if benchmark.get("run_type") == "aggregate":
+            if benchmark.get("aggregate_name") == "median":
+                medians[name] = time
+        else:
+            singles.setdefault(name, time)
+
+    singles.update(medians)
+    return singles
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown that counts as a regression")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"),
+                        default="real_time")
+    arguments = parser.parse_args()
+
+    baseline = load(arguments.baseline, arguments.metric)
+    current = load(arguments.current, arguments.metric)
+
+    regressions = 0
+    width = max((len(name) for name in current.keys() | baseline.keys()),
+                default=0)
+    for name, time in current.items():
+        if name not in baseline:
+            print(f"{name:<{width}}  new")
+            continue
+
+        change = time / baseline[name] - 1.0
+        verdict = ""
+        if change > arguments.threshold:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif change < -arguments.threshold:
+            verdict = "improvement"
+        print(f"{name:<{width}}  {baseline[name]:>14.0f} ns"
+              f"  {time:>14.0f} ns  {change:+8.1%}  {verdict}".rstrip())
+
+    for name in baseline.keys() - current.keys():
+        print(f"{name:<{width}}  missing")
+
+    print(f"{regressions} regression(s) beyond {arguments.threshold:.0%} "
+          f"out of {len(current.keys() & baseline.keys())} benchmarks")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
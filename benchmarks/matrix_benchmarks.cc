@@ -0,0 +1,313 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "../s21_matrix_oop.h"
+
+// Every public S21BasicMatrix operation over square sizes 2..4096, and
+// products over tall, wide and skinny shapes. Counters report FLOP/s where
+// the operation does arithmetic and bytes/s of the matrices it streams, so
+// results are comparable across sizes. Wall-clock time is measured because
+// the larger operations run on the thread pool.
+namespace s21 {
+namespace {
+constexpr int kMinSize{2};
+constexpr int kMaxSize{4096};
+
+// Diagonally dominant when square, so factorizations never pivot on tiny
+// values and the timings do not depend on the data.
+template <typename T>
+S21BasicMatrix<T> MakeMatrix(int rows, int cols, double seed) {
+  S21BasicMatrix<T> matrix{rows, cols};
+  for (int i{0}; i < rows; ++i) {
+    for (int j{0}; j < cols; ++j) {
+      matrix.AtUnchecked(i, j) =
+          static_cast<T>(0.5 * std::sin(seed + i * cols + j) / cols);
+    }
+    if (rows == cols) matrix.AtUnchecked(i, i) += T{1};
+  }
+
+  return matrix;
+}
+
+void ReportRates(benchmark::State& state, double flops, double bytes) {
+  if (flops > 0.0) {
+    state.counters["FLOP/s"] = benchmark::Counter{
+        flops, benchmark::Counter::kIsIterationInvariantRate,
+        benchmark::Counter::kIs1000};
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(
+      bytes * static_cast<double>(state.iterations())));
+}
+
+void SquareSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->RangeMultiplier(2)->Range(kMinSize, kMaxSize)->UseRealTime();
+}
+
+// m x k times k x n.
+void ProductShapes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({"m", "k", "n"});
+  for (int size{kMinSize}; size <= kMaxSize; size *= 2) {
+    benchmark->Args({size, size, size});
+  }
+  benchmark->Args({4096, 64, 4096})
+      ->Args({64, 4096, 64})
+      ->Args({4096, 4096, 1})
+      ->Args({1, 4096, 4096})
+      ->Args({4096, 1, 4096})
+      ->Args({1000, 333, 777});
+  benchmark->UseRealTime();
+}
+
+double Square(const benchmark::State& state) {
+  const double size{static_cast<double>(state.range(0))};
+  return size * size;
+}
+
+template <typename T>
+void BM_Copy(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  for (auto _ : state) {
+    S21BasicMatrix<T> copy{matrix};
+    benchmark::DoNotOptimize(copy.data());
+  }
+  ReportRates(state, 0.0, 2.0 * sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_EqMatrix(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> left{MakeMatrix<T>(size, size, 1.0)};
+  const S21BasicMatrix<T> right{left};
+  for (auto _ : state) benchmark::DoNotOptimize(left.EqMatrix(right));
+  ReportRates(state, 0.0, 2.0 * sizeof(T) * Square(state));
+}
+
+template <typename T, Tolerance kMode>
+void BM_Compare(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> left{MakeMatrix<T>(size, size, 1.0)};
+  const S21BasicMatrix<T> right{MakeMatrix<T>(size, size, 1.0)};
+  const CompareOptions options{kMode, 1e-7};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(left.Compare(right, options).max_error);
+  }
+  ReportRates(state, 0.0, 2.0 * sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_SumMatrix(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  S21BasicMatrix<T> left{MakeMatrix<T>(size, size, 1.0)};
+  const S21BasicMatrix<T> right{MakeMatrix<T>(size, size, 2.0)};
+  for (auto _ : state) {
+    left.SumMatrix(right);
+    benchmark::ClobberMemory();
+  }
+  ReportRates(state, Square(state), 3.0 * sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_SubMatrix(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  S21BasicMatrix<T> left{MakeMatrix<T>(size, size, 1.0)};
+  const S21BasicMatrix<T> right{MakeMatrix<T>(size, size, 2.0)};
+  for (auto _ : state) {
+    left.SubMatrix(right);
+    benchmark::ClobberMemory();
+  }
+  ReportRates(state, Square(state), 3.0 * sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_MulNumber(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  for (auto _ : state) {
+    matrix.MulNumber(T{1});
+    benchmark::ClobberMemory();
+  }
+  ReportRates(state, Square(state), 2.0 * sizeof(T) * Square(state));
+}
+
+// a + b * 2 - c through the expression templates, in one pass.
+template <typename T>
+void BM_Expression(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> a{MakeMatrix<T>(size, size, 1.0)};
+  const S21BasicMatrix<T> b{MakeMatrix<T>(size, size, 2.0)};
+  const S21BasicMatrix<T> c{MakeMatrix<T>(size, size, 3.0)};
+  S21BasicMatrix<T> result{size, size};
+  for (auto _ : state) {
+    result = a + b * T{2} - c;
+    benchmark::ClobberMemory();
+  }
+  ReportRates(state, 3.0 * Square(state),
+              4.0 * sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_ElementAccess(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  for (auto _ : state) {
+    T sum{};
+    for (int i{0}; i < size; ++i) {
+      for (int j{0}; j < size; ++j) sum += matrix(i, j);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  ReportRates(state, Square(state), sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_Transpose(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  for (auto _ : state) benchmark::DoNotOptimize(matrix.Transpose().data());
+  ReportRates(state, 0.0, 2.0 * sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_TransposeInPlace(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  for (auto _ : state) {
+    matrix.TransposeInPlace();
+    benchmark::ClobberMemory();
+  }
+  ReportRates(state, 0.0, 2.0 * sizeof(T) * Square(state));
+}
+
+// Grows and shrinks by a row and a column, copying the overlap each time.
+template <typename T>
+void BM_Resize(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  for (auto _ : state) {
+    matrix.SetRows(size + 1);
+    matrix.SetCols(size + 1);
+    matrix.SetRows(size);
+    matrix.SetCols(size);
+    benchmark::ClobberMemory();
+  }
+  ReportRates(state, 0.0, 8.0 * sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_MulMatrix(benchmark::State& state, MulAlgorithm algorithm) {
+  const int m{static_cast<int>(state.range(0))};
+  const int k{static_cast<int>(state.range(1))};
+  const int n{static_cast<int>(state.range(2))};
+  const S21BasicMatrix<T> left{MakeMatrix<T>(m, k, 1.0)};
+  const S21BasicMatrix<T> right{MakeMatrix<T>(k, n, 2.0)};
+  MulOptions options{GetDefaultMulOptions()};
+  options.algorithm = algorithm;
+  for (auto _ : state) {
+    S21BasicMatrix<T> product{left};
+    product.MulMatrix(right, options);
+    benchmark::DoNotOptimize(product.data());
+  }
+  ReportRates(state, 2.0 * m * k * n,
+              sizeof(T) * (2.0 * m * k + 1.0 * k * n + 1.0 * m * n));
+}
+
+template <typename T>
+void BM_MulClassic(benchmark::State& state) {
+  BM_MulMatrix<T>(state, MulAlgorithm::kClassic);
+}
+
+template <typename T>
+void BM_MulStrassenWinograd(benchmark::State& state) {
+  BM_MulMatrix<T>(state, MulAlgorithm::kStrassenWinograd);
+}
+
+double Cube(const benchmark::State& state) {
+  return Square(state) * static_cast<double>(state.range(0));
+}
+
+template <typename T>
+void BM_Determinant(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  for (auto _ : state) benchmark::DoNotOptimize(matrix.Determinant());
+  ReportRates(state, 2.0 / 3.0 * Cube(state),
+              sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_LUDecompose(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  for (auto _ : state) {
+    const LUDecomposition<T> lu{matrix.LUDecompose()};
+    benchmark::DoNotOptimize(lu.GetSign());
+  }
+  ReportRates(state, 2.0 / 3.0 * Cube(state),
+              2.0 * sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_Solve(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  const S21BasicMatrix<T> rhs{MakeMatrix<T>(size, 1, 2.0)};
+  for (auto _ : state) benchmark::DoNotOptimize(matrix.Solve(rhs).data());
+  ReportRates(state, 2.0 / 3.0 * Cube(state) + 2.0 * Square(state),
+              2.0 * sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_InverseMatrix(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix.InverseMatrix().data());
+  }
+  ReportRates(state, 2.0 * Cube(state),
+              2.0 * sizeof(T) * Square(state));
+}
+
+template <typename T>
+void BM_CalcComplements(benchmark::State& state) {
+  const int size{static_cast<int>(state.range(0))};
+  const S21BasicMatrix<T> matrix{MakeMatrix<T>(size, size, 1.0)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix.CalcComplements().data());
+  }
+  ReportRates(state, 2.0 * Cube(state) + Square(state),
+              2.0 * sizeof(T) * Square(state));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Copy, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_EqMatrix, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_Compare, double, Tolerance::kAbsolute)
+    ->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_Compare, double, Tolerance::kUlp)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_Compare, float, Tolerance::kRelative)
+    ->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_SumMatrix, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_SumMatrix, float)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_SubMatrix, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_MulNumber, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_Expression, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_ElementAccess, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_Transpose, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_TransposeInPlace, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_Resize, double)->Apply(SquareSizes);
+
+BENCHMARK_TEMPLATE(BM_MulClassic, double)->Apply(ProductShapes);
+BENCHMARK_TEMPLATE(BM_MulClassic, float)->Apply(ProductShapes);
+BENCHMARK_TEMPLATE(BM_MulStrassenWinograd, double)->Apply(ProductShapes);
+
+BENCHMARK_TEMPLATE(BM_Determinant, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_LUDecompose, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_Solve, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_InverseMatrix, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_CalcComplements, double)->Apply(SquareSizes);
+}  // namespace s21
+
+BENCHMARK_MAIN();
@@ -0,0 +1,356 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_FIXED_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_S21_FIXED_MATRIX_H_
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_traits.h"
+
+// Matrix with compile-time dimensions and inline storage. Nothing
+// allocates, arithmetic is constexpr, and determinants, inverses and
+// complements of matrices up to 4x4 use unrolled closed forms; larger ones
+// go through S21BasicMatrix. Converts implicitly to and from the
+// S21BasicMatrix of the same element type.
+namespace s21 {
+namespace fixed_matrix_internal {
+template <typename T>
+[[nodiscard]] constexpr typename ScalarTraits<T>::Real Magnitude(
+    const T& value) {
+  using Real = typename ScalarTraits<T>::Real;
+  if constexpr (std::is_same_v<T, std::complex<Real>>) {
+    return std::abs(value);
+  } else {
+    return static_cast<Real>(value < T{} ? -value : value);
+  }
+}
+
+// Closed forms of the determinant and the adjugate, the transpose of the
+// complements, of an N x N row-major matrix with N <= 4. Results are
+// written through pointers so that vector types work as T too, which is
+// how the batched kernels evaluate several matrices at once. The 1 x 1
+// adjugate is the scalar T{1}.
+template <int N, typename T>
+[[gnu::always_inline]] constexpr void ClosedFormDeterminant(const T* a,
+                                                           T* determinant) {
+  static_assert(N >= 1 && N <= 4, "Closed forms exist up to 4x4.");
+  if constexpr (N == 1) {
+    *determinant = a[0];
+  } else if constexpr (N == 2) {
+    *determinant = a[0] * a[3] - a[1] * a[2];
+  } else if constexpr (N == 3) {
+    *determinant = a[0] * (a[4] * a[8] - a[5] * a[7]) -
+                   a[1] * (a[3] * a[8] - a[5] * a[6]) +
+                   a[2] * (a[3] * a[7] - a[4] * a[6]);
+  } else {
+    const T s0{a[0] * a[5] - a[4] * a[1]};
+    const T s1{a[0] * a[6] - a[4] * a[2]};
+    const T s2{a[0] * a[7] - a[4] * a[3]};
+    const T s3{a[1] * a[6] - a[5] * a[2]};
+    const T s4{a[1] * a[7] - a[5] * a[3]};
+    const T s5{a[2] * a[7] - a[6] * a[3]};
+    const T c0{a[8] * a[13] - a[12] * a[9]};
+    const T c1{a[8] * a[14] - a[12] * a[10]};
+    const T c2{a[8] * a[15] - a[12] * a[11]};
+    const T c3{a[9] * a[14] - a[13] * a[10]};
+    const T c4{a[9] * a[15] - a[13] * a[11]};
+    const T c5{a[10] * a[15] - a[14] * a[11]};
+    *determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  }
+}
+
+template <int N, typename T>
+[[gnu::always_inline]] constexpr void ClosedFormAdjugate(const T* a,
+                                                        T* adjugate) {
+  static_assert(N >= 1 && N <= 4, "Closed forms exist up to 4x4.");
+  T* r{adjugate};
+  if constexpr (N == 1) {
+    r[0] = T{1};
+  } else if constexpr (N == 2) {
+    r[0] = a[3];
+    r[1] = -a[1];
+    r[2] = -a[2];
+    r[3] = a[0];
+  } else if constexpr (N == 3) {
+    r[0] = a[4] * a[8] - a[5] * a[7];
+    r[1] = a[2] * a[7] - a[1] * a[8];
+    r[2] = a[1] * a[5] - a[2] * a[4];
+    r[3] = a[5] * a[6] - a[3] * a[8];
+    r[4] = a[0] * a[8] - a[2] * a[6];
+    r[5] = a[2] * a[3] - a[0] * a[5];
+    r[6] = a[3] * a[7] - a[4] * a[6];
+    r[7] = a[1] * a[6] - a[0] * a[7];
+    r[8] = a[0] * a[4] - a[1] * a[3];
+  } else {
+    const T s0{a[0] * a[5] - a[4] * a[1]};
+    const T s1{a[0] * a[6] - a[4] * a[2]};
+    const T s2{a[0] * a[7] - a[4] * a[3]};
+    const T s3{a[1] * a[6] - a[5] * a[2]};
+    const T s4{a[1] * a[7] - a[5] * a[3]};
+    const T s5{a[2] * a[7] - a[6] * a[3]};
+    const T c0{a[8] * a[13] - a[12] * a[9]};
+    const T c1{a[8] * a[14] - a[12] * a[10]};
+    const T c2{a[8] * a[15] - a[12] * a[11]};
+    const T c3{a[9] * a[14] - a[13] * a[10]};
+    const T c4{a[9] * a[15] - a[13] * a[11]};
+    const T c5{a[10] * a[15] - a[14] * a[11]};
+    r[0] = a[5] * c5 - a[6] * c4 + a[7] * c3;
+    r[1] = -a[1] * c5 + a[2] * c4 - a[3] * c3;
+    r[2] = a[13] * s5 - a[14] * s4 + a[15] * s3;
+    r[3] = -a[9] * s5 + a[10] * s4 - a[11] * s3;
+    r[4] = -a[4] * c5 + a[6] * c2 - a[7] * c1;
+    r[5] = a[0] * c5 - a[2] * c2 + a[3] * c1;
+    r[6] = -a[12] * s5 + a[14] * s2 - a[15] * s1;
+    r[7] = a[8] * s5 - a[10] * s2 + a[11] * s1;
+    r[8] = a[4] * c4 - a[5] * c2 + a[7] * c0;
+    r[9] = -a[0] * c4 + a[1] * c2 - a[3] * c0;
+    r[10] = a[12] * s4 - a[13] * s2 + a[15] * s0;
+    r[11] = -a[8] * s4 + a[9] * s2 - a[11] * s0;
+    r[12] = -a[4] * c3 + a[5] * c1 - a[6] * c0;
+    r[13] = a[0] * c3 - a[1] * c1 + a[2] * c0;
+    r[14] = -a[12] * s3 + a[13] * s1 - a[14] * s0;
+    r[15] = a[8] * s3 - a[9] * s1 + a[10] * s0;
+  }
+}
+
+// The pivot rule of LUDecomposition applied to the product of the pivots:
+// the determinant counts as zero up to ScalarTraits<T>::PivotTolerance(N)
+// times the product of the largest elements of the rows.
+template <int N, typename T>
+[[nodiscard]] constexpr bool IsSingular(const T* a, const T& determinant) {
+  using Real = typename ScalarTraits<T>::Real;
+  Real bound{ScalarTraits<T>::PivotTolerance(N)};
+  for (int i{0}; i < N; ++i) {
+    Real row_max{0};
+    for (int j{0}; j < N; ++j) {
+      row_max = std::max(row_max, Magnitude(a[i * N + j]));
+    }
+    bound *= row_max;
+  }
+  return Magnitude(determinant) <= bound;
+}
+}  // namespace fixed_matrix_internal
+
+template <typename T, int R, int C>
+class FixedMatrix {
+  static_assert(R > 0 && C > 0, "FixedMatrix dimensions must be positive.");
+
+ public:
+  using value_type = T;
+  using Factor = typename ScalarTraits<T>::Factor;
+
+  constexpr FixedMatrix() = default;
+  // Row-major elements; missing trailing elements are zero.
+  constexpr FixedMatrix(std::initializer_list<T> elements) {
+    if (elements.size() > static_cast<std::size_t>(R * C)) {
+      throw std::invalid_argument{
+          "FixedMatrix::FixedMatrix(std::initializer_list<T>): Too many "
+          "elements. "
+          "At most rows * columns elements can be given."};
+    }
+
+    std::size_t index{0};
+    for (const T& element : elements) {
+      elements_[index++] = element;
+    }
+  }
+  FixedMatrix(const S21BasicMatrix<T>& matrix) {
+    if (matrix.GetRows() != R || matrix.GetCols() != C) {
+      throw std::invalid_argument{
+          "FixedMatrix::FixedMatrix(const S21BasicMatrix&): Matrix dimensions "
+          "are not compatible for conversion. "
+          "The matrix must have the same number of rows and columns."};
+    }
+
+    std::copy_n(matrix.data(), R * C, elements_);
+  }
+
+  operator S21BasicMatrix<T>() const {
+    S21BasicMatrix<T> matrix{R, C};
+    std::copy_n(elements_, R * C, matrix.data());
+    return matrix;
+  }
+
+  [[nodiscard]] static constexpr int GetRows() { return R; }
+  [[nodiscard]] static constexpr int GetCols() { return C; }
+  [[nodiscard]] constexpr T* data() noexcept { return elements_; }
+  [[nodiscard]] constexpr const T* data() const noexcept { return elements_; }
+
+  [[nodiscard]] constexpr T& operator()(int row, int column) {
+    if (row < 0 || column < 0 || row >= R || column >= C) {
+      throw std::out_of_range{
+          "FixedMatrix::operator()(int, int): Index out of range. "
+          "Row and column indices must be non-negative and within the matrix "
+          "dimensions."};
+    }
+
+    return elements_[row * C + column];
+  }
+
+  [[nodiscard]] constexpr const T& operator()(int row, int column) const {
+    if (row < 0 || column < 0 || row >= R || column >= C) {
+      throw std::out_of_range{
+          "FixedMatrix::operator()(int, int) const: Index out of range. "
+          "Row and column indices must be non-negative and within the matrix "
+          "dimensions."};
+    }
+
+    return elements_[row * C + column];
+  }
+
+  [[nodiscard]] constexpr bool EqMatrix(const FixedMatrix& other) const {
+    for (int i{0}; i < R * C; ++i) {
+      if (fixed_matrix_internal::Magnitude(elements_[i] - other.elements_[i]) >
+          ScalarTraits<T>::Precision()) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  constexpr FixedMatrix& operator+=(const FixedMatrix& other) {
+    for (int i{0}; i < R * C; ++i) {
+      elements_[i] += other.elements_[i];
+    }
+    return *this;
+  }
+
+  constexpr FixedMatrix& operator-=(const FixedMatrix& other) {
+    for (int i{0}; i < R * C; ++i) {
+      elements_[i] -= other.elements_[i];
+    }
+    return *this;
+  }
+
+  constexpr FixedMatrix& operator*=(const T number) {
+    for (T& element : elements_) {
+      element *= number;
+    }
+    return *this;
+  }
+
+  [[nodiscard]] constexpr FixedMatrix<T, C, R> Transpose() const {
+    FixedMatrix<T, C, R> transposed;
+    for (int i{0}; i < R; ++i) {
+      for (int j{0}; j < C; ++j) {
+        transposed.data()[j * R + i] = elements_[i * C + j];
+      }
+    }
+    return transposed;
+  }
+
+  [[nodiscard]] constexpr T Determinant() const {
+    static_assert(R == C, "The determinant needs a square matrix.");
+    if constexpr (R <= 4) {
+      T determinant{};
+      fixed_matrix_internal::ClosedFormDeterminant<R>(elements_,
+                                                     &determinant);
+      return determinant;
+    } else {
+      return S21BasicMatrix<T>{*this}.Determinant();
+    }
+  }
+
+  [[nodiscard]] constexpr FixedMatrix CalcComplements() const {
+    static_assert(R == C, "Complements need a square matrix.");
+    if constexpr (R <= 4) {
+      return Adjugate().Transpose();
+    } else {
+      return FixedMatrix{S21BasicMatrix<T>{*this}.CalcComplements()};
+    }
+  }
+
+  [[nodiscard]] constexpr FixedMatrix<Factor, R, C> InverseMatrix() const {
+    static_assert(R == C, "The inverse needs a square matrix.");
+    if constexpr (R <= 4) {
+      const T determinant{Determinant()};
+      if (IsSingular(determinant)) {
+        throw std::runtime_error{
+            "FixedMatrix::InverseMatrix(): Matrix is singular, and its "
+            "inverse does not exist. "
+            "The determinant of the matrix is zero."};
+      }
+
+      const FixedMatrix adjugate{Adjugate()};
+      FixedMatrix<Factor, R, C> inverse;
+      for (int i{0}; i < R * C; ++i) {
+        inverse.data()[i] = static_cast<Factor>(adjugate.elements_[i]) /
+                            static_cast<Factor>(determinant);
+      }
+      return inverse;
+    } else {
+      return FixedMatrix<Factor, R, C>{
+          S21BasicMatrix<T>{*this}.InverseMatrix()};
+    }
+  }
+
+  [[nodiscard]] friend constexpr FixedMatrix operator+(
+      FixedMatrix left, const FixedMatrix& right) {
+    return left += right;
+  }
+
+  [[nodiscard]] friend constexpr FixedMatrix operator-(
+      FixedMatrix left, const FixedMatrix& right) {
+    return left -= right;
+  }
+
+  [[nodiscard]] friend constexpr FixedMatrix operator-(FixedMatrix operand) {
+    for (T& element : operand.elements_) {
+      element = -element;
+    }
+    return operand;
+  }
+
+  [[nodiscard]] friend constexpr FixedMatrix operator*(FixedMatrix operand,
+                                                       const T number) {
+    return operand *= number;
+  }
+
+  [[nodiscard]] friend constexpr FixedMatrix operator*(const T number,
+                                                       FixedMatrix operand) {
+    return operand *= number;
+  }
+
+  template <int K>
+  [[nodiscard]] friend constexpr FixedMatrix<T, R, K> operator*(
+      const FixedMatrix& left, const FixedMatrix<T, C, K>& right) {
+    FixedMatrix<T, R, K> product;
+    for (int i{0}; i < R; ++i) {
+      for (int p{0}; p < C; ++p) {
+        const T value{left.elements_[i * C + p]};
+        for (int j{0}; j < K; ++j) {
+          product.data()[i * K + j] += value * right.data()[p * K + j];
+        }
+      }
+    }
+    return product;
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const FixedMatrix& left,
+                                                 const FixedMatrix& right) {
+    return left.EqMatrix(right);
+  }
+
+ private:
+  // Transpose of the complements, i.e. determinant times the inverse.
+  [[nodiscard]] constexpr FixedMatrix Adjugate() const {
+    FixedMatrix adjugate;
+    fixed_matrix_internal::ClosedFormAdjugate<R>(elements_,
+                                                 adjugate.elements_);
+    return adjugate;
+  }
+
+  [[nodiscard]] constexpr bool IsSingular(const T& determinant) const {
+    return fixed_matrix_internal::IsSingular<R>(elements_, determinant);
+  }
+
+  T elements_[R * C]{};
+};
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_FIXED_MATRIX_H_
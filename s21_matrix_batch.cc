@@ -0,0 +1,626 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <climits>
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "s21_fixed_matrix.h"
+#include "s21_matrix_kernels.h"
+#include "s21_thread_pool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define S21_MATRIX_X86_SIMD
+#endif
+
+namespace s21 {
+namespace {
+// Matrices per task, a multiple of every vector width.
+constexpr std::size_t kBatchChunk{4096};
+
+[[nodiscard]] int PlaneCount(int rows, int cols) {
+  if (rows <= 0 || cols <= 0 || rows > INT_MAX / cols) {
+    throw std::invalid_argument{
+        "MatrixBatch::MatrixBatch(size_t, int, int): Matrix has improper "
+        "dimensions. "
+        "Rows and columns must be greater than zero."};
+  }
+
+  return rows * cols;
+}
+
+template <typename T>
+[[nodiscard]] int PaddedCount(std::size_t count) {
+  constexpr std::size_t kPlaneElements{
+      std::max<std::size_t>(1, kMatrixStorageAlignment / sizeof(T))};
+  const std::size_t padded{
+      std::max(kPlaneElements, (count + kPlaneElements - 1) /
+                                   kPlaneElements * kPlaneElements)};
+  if (padded > static_cast<std::size_t>(INT_MAX)) {
+    throw std::invalid_argument{
+        "MatrixBatch::MatrixBatch(size_t, int, int): Batch is too large. "
+        "The padded count must fit in an int."};
+  }
+
+  return static_cast<int>(padded);
+}
+
+// Lanes evaluate an operation on kWidth consecutive matrices. Loads convert
+// the element type to the one the operation computes in. Vectors are only
+// passed by pointer or reference, since the operations are compiled for
+// the baseline instruction set and inlined into the wider ones.
+template <typename Input, typename Output>
+struct ScalarLanes {
+  using Vector = Output;
+  static constexpr std::size_t kWidth{1};
+
+  static void Load(const Input* source, Vector* value) {
+    *value = static_cast<Output>(*source);
+  }
+  static void Splat(Output number, Vector* value) { *value = number; }
+  static void Store(Output* destination, const Vector& value) {
+    *destination = value;
+  }
+};
+
+#ifdef S21_MATRIX_X86_SIMD
+template <typename T>
+struct Sse2Lanes;
+template <typename T>
+struct Avx2Lanes;
+template <typename T>
+struct Avx512Lanes;
+
+#define S21_DEFINE_LANES(Name, T, VectorType, width, target_name, load, \
+                         splat, store)                                  \
+  template <>                                                           \
+  struct Name<T> {                                                      \
+    using Vector = VectorType;                                          \
+    static constexpr std::size_t kWidth{width};                         \
+                                                                        \
+    __attribute__((target(target_name))) static void Load(              \
+        const T* source, Vector* value) {                               \
+      *value = load(source);                                            \
+    }                                                                   \
+    __attribute__((target(target_name))) static void Splat(             \
+        T number, Vector* value) {                                      \
+      *value = splat(number);                                           \
+    }                                                                   \
+    __attribute__((target(target_name))) static void Store(             \
+        T* destination, const Vector& value) {                          \
+      store(destination, value);                                        \
+    }                                                                   \
+  };
+
+S21_DEFINE_LANES(Sse2Lanes, double, __m128d, 2, "sse2", _mm_loadu_pd,
+                 _mm_set1_pd, _mm_storeu_pd)
+S21_DEFINE_LANES(Sse2Lanes, float, __m128, 4, "sse2", _mm_loadu_ps,
+                 _mm_set1_ps, _mm_storeu_ps)
+S21_DEFINE_LANES(Avx2Lanes, double, __m256d, 4, "avx2", _mm256_loadu_pd,
+                 _mm256_set1_pd, _mm256_storeu_pd)
+S21_DEFINE_LANES(Avx2Lanes, float, __m256, 8, "avx2", _mm256_loadu_ps,
+                 _mm256_set1_ps, _mm256_storeu_ps)
+S21_DEFINE_LANES(Avx512Lanes, double, __m512d, 8, "avx512f",
+                 _mm512_loadu_pd, _mm512_set1_pd, _mm512_storeu_pd)
+S21_DEFINE_LANES(Avx512Lanes, float, __m512, 16, "avx512f", _mm512_loadu_ps,
+                 _mm512_set1_ps, _mm512_storeu_ps)
+
+#undef S21_DEFINE_LANES
+#endif
+
+// The operations read matrices from planes of Input and compute in
+// Scalar. Apply handles the matrices [index, index + Lanes::kWidth).
+template <int N, typename T>
+struct DeterminantOperation {
+  using Input = T;
+  using Scalar = T;
+
+  template <typename Lanes>
+  [[gnu::always_inline]] void Apply(std::size_t index) const {
+    typename Lanes::Vector a[N * N];
+    for (int k{0}; k < N * N; ++k) {
+      Lanes::Load(planes + k * stride + index, &a[k]);
+    }
+    typename Lanes::Vector determinant;
+    fixed_matrix_internal::ClosedFormDeterminant<N>(a, &determinant);
+    Lanes::Store(determinants + index, determinant);
+  }
+
+  const T* planes;
+  std::size_t stride;
+  T* determinants;
+};
+
+// Also stores the determinants, from index first on, for the singularity
+// test.
+template <int N, typename T>
+struct InverseOperation {
+  using Input = T;
+  using Scalar = typename ScalarTraits<T>::Factor;
+
+  template <typename Lanes>
+  [[gnu::always_inline]] void Apply(std::size_t index) const {
+    typename Lanes::Vector a[N * N];
+    for (int k{0}; k < N * N; ++k) {
+      Lanes::Load(planes + k * stride + index, &a[k]);
+    }
+    typename Lanes::Vector determinant;
+    fixed_matrix_internal::ClosedFormDeterminant<N>(a, &determinant);
+    typename Lanes::Vector reciprocal;
+    Lanes::Splat(Scalar{1}, &reciprocal);
+    reciprocal = reciprocal / determinant;
+    if constexpr (N == 1) {
+      Lanes::Store(inverse + index, reciprocal);
+    } else {
+      typename Lanes::Vector adjugate[N * N];
+      fixed_matrix_internal::ClosedFormAdjugate<N>(a, adjugate);
+      for (int k{0}; k < N * N; ++k) {
+        Lanes::Store(inverse + k * inverse_stride + index,
+                     adjugate[k] * reciprocal);
+      }
+    }
+    Lanes::Store(determinants + (index - first), determinant);
+  }
+
+  const T* planes;
+  std::size_t stride;
+  Scalar* inverse;
+  std::size_t inverse_stride;
+  Scalar* determinants;
+  std::size_t first;
+};
+
+template <typename T>
+struct ProductOperation {
+  using Input = T;
+  using Scalar = T;
+
+  template <typename Lanes>
+  [[gnu::always_inline]] void Apply(std::size_t index) const {
+    for (int i{0}; i < rows; ++i) {
+      for (int j{0}; j < cols; ++j) {
+        typename Lanes::Vector sum;
+        typename Lanes::Vector factor;
+        typename Lanes::Vector other;
+        Lanes::Splat(T{}, &sum);
+        for (int p{0}; p < inner; ++p) {
+          Lanes::Load(left + (i * inner + p) * left_stride + index, &factor);
+          Lanes::Load(right + (p * cols + j) * right_stride + index, &other);
+          sum = sum + factor * other;
+        }
+        Lanes::Store(product + (i * cols + j) * product_stride + index, sum);
+      }
+    }
+  }
+
+  const T* left;
+  std::size_t left_stride;
+  const T* right;
+  std::size_t right_stride;
+  T* product;
+  std::size_t product_stride;
+  int rows;
+  int inner;
+  int cols;
+};
+
+template <typename Lanes, typename Operation>
+[[gnu::always_inline]] inline void ApplyLanes(const Operation& operation,
+                                              std::size_t& index,
+                                              std::size_t end) {
+  for (; index + Lanes::kWidth <= end; index += Lanes::kWidth) {
+    operation.template Apply<Lanes>(index);
+  }
+}
+
+#ifdef S21_MATRIX_X86_SIMD
+template <typename Operation>
+__attribute__((target("sse2"))) void ApplySse2(const Operation& operation,
+                                               std::size_t& index,
+                                               std::size_t end) {
+  ApplyLanes<Sse2Lanes<typename Operation::Scalar>>(operation, index, end);
+}
+
+template <typename Operation>
+__attribute__((target("avx2"))) void ApplyAvx2(const Operation& operation,
+                                               std::size_t& index,
+                                               std::size_t end) {
+  ApplyLanes<Avx2Lanes<typename Operation::Scalar>>(operation, index, end);
+}
+
+template <typename Operation>
+__attribute__((target("avx512f"))) void ApplyAvx512(
+    const Operation& operation, std::size_t& index, std::size_t end) {
+  ApplyLanes<Avx512Lanes<typename Operation::Scalar>>(operation, index, end);
+}
+#endif
+
+// Vector lanes for float and double, then scalar ones for the remainder.
+template <typename Operation>
+void ApplyRange(const Operation& operation, std::size_t begin,
+                std::size_t end) {
+  using Input = typename Operation::Input;
+  using Scalar = typename Operation::Scalar;
+  std::size_t index{begin};
+#ifdef S21_MATRIX_X86_SIMD
+  if constexpr (std::is_same_v<Input, Scalar> &&
+                (std::is_same_v<Scalar, float> ||
+                 std::is_same_v<Scalar, double>)) {
+    switch (kernels::GetSimdLevel()) {
+      case kernels::SimdLevel::kAvx512:
+        ApplyAvx512(operation, index, end);
+        break;
+      case kernels::SimdLevel::kAvx2:
+        ApplyAvx2(operation, index, end);
+        break;
+      case kernels::SimdLevel::kSse2:
+        ApplySse2(operation, index, end);
+        break;
+      case kernels::SimdLevel::kScalar:
+        break;
+    }
+  }
+#endif
+  ApplyLanes<ScalarLanes<Input, Scalar>>(operation, index, end);
+}
+
+// Calls body(begin, end) for chunks of the batch on up to num_threads
+// threads.
+void ForEachChunk(std::size_t count, int num_threads,
+                  const std::function<void(std::size_t, std::size_t)>& body) {
+  const std::size_t chunks{(count + kBatchChunk - 1) / kBatchChunk};
+  ThreadPool::Global().ParallelFor(
+      static_cast<int>(chunks),
+      [&](int chunk) {
+        const std::size_t begin{static_cast<std::size_t>(chunk) *
+                                kBatchChunk};
+        body(begin, std::min(count, begin + kBatchChunk));
+      },
+      num_threads > 0 ? num_threads : GetNumThreads());
+}
+
+template <int N, typename T>
+void ClosedFormDeterminants(const MatrixBatch<T>& batch, int num_threads,
+                            std::vector<T>& determinants) {
+  const DeterminantOperation<N, T> operation{
+      batch.Plane(0, 0), batch.GetPlaneStride(), determinants.data()};
+  ForEachChunk(batch.GetCount(), num_threads,
+               [&](std::size_t begin, std::size_t end) {
+                 ApplyRange(operation, begin, end);
+               });
+}
+
+template <int N, typename T>
+void ClosedFormInverses(const MatrixBatch<T>& batch, int num_threads,
+                        MatrixBatch<typename ScalarTraits<T>::Factor>& inverse,
+                        std::vector<unsigned char>& singular) {
+  using Factor = typename ScalarTraits<T>::Factor;
+  const T* planes{batch.Plane(0, 0)};
+  const std::size_t stride{batch.GetPlaneStride()};
+  Factor* inverse_planes{inverse.Plane(0, 0)};
+  const std::size_t inverse_stride{inverse.GetPlaneStride()};
+
+  ForEachChunk(
+      batch.GetCount(), num_threads, [&](std::size_t begin, std::size_t end) {
+        std::vector<Factor> determinants(end - begin);
+        ApplyRange(InverseOperation<N, T>{planes, stride, inverse_planes,
+                                          inverse_stride, determinants.data(),
+                                          begin},
+                   begin, end);
+
+        // Integer matrices are tested with their exact determinant.
+        for (std::size_t index{begin}; index < end; ++index) {
+          T a[N * N];
+          for (int k{0}; k < N * N; ++k) {
+            a[k] = planes[k * stride + index];
+          }
+          T determinant{};
+          if constexpr (std::is_integral_v<T>) {
+            fixed_matrix_internal::ClosedFormDeterminant<N>(a, &determinant);
+          } else {
+            determinant = determinants[index - begin];
+          }
+          if (!fixed_matrix_internal::IsSingular<N>(a, determinant)) continue;
+
+          singular[index] = 1;
+          for (int k{0}; k < N * N; ++k) {
+            inverse_planes[k * inverse_stride + index] = Factor{};
+          }
+        }
+      });
+}
+
+// Square matrices too large for the closed forms.
+template <typename T>
+void FactorizedInverses(const MatrixBatch<T>& batch, int num_threads,
+                        MatrixBatch<typename ScalarTraits<T>::Factor>& inverse,
+                        std::vector<unsigned char>& singular) {
+  using Factor = typename ScalarTraits<T>::Factor;
+  const int size{batch.GetRows()};
+  Factor* inverse_planes{inverse.Plane(0, 0)};
+  const std::size_t inverse_stride{inverse.GetPlaneStride()};
+
+  ForEachChunk(
+      batch.GetCount(), num_threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index{begin}; index < end; ++index) {
+          const auto lu{batch.Get(index).LUDecompose()};
+          if (lu.IsSingular()) {
+            singular[index] = 1;
+            continue;
+          }
+
+          const S21BasicMatrix<Factor> matrix{lu.Inverse()};
+          for (int i{0}; i < size; ++i) {
+            for (int j{0}; j < size; ++j) {
+              inverse_planes[(i * size + j) * inverse_stride + index] =
+                  matrix.AtUnchecked(i, j);
+            }
+          }
+        }
+      });
+}
+
+template <typename T>
+[[nodiscard]] MatrixBatch<typename ScalarTraits<T>::Factor> Inverses(
+    const MatrixBatch<T>& batch, int num_threads,
+    std::vector<unsigned char>& singular, const std::string& function) {
+  const int size{batch.GetRows()};
+  if (size != batch.GetCols()) {
+    throw std::invalid_argument{
+        function +
+        ": Matrix dimensions are not compatible for inverse matrix "
+        "calculation. "
+        "The matrices must be square."};
+  }
+
+  MatrixBatch<typename ScalarTraits<T>::Factor> inverse{batch.GetCount(),
+                                                        size, size};
+  singular.assign(batch.GetCount(), 0);
+  switch (size) {
+    case 1:
+      ClosedFormInverses<1>(batch, num_threads, inverse, singular);
+      break;
+    case 2:
+      ClosedFormInverses<2>(batch, num_threads, inverse, singular);
+      break;
+    case 3:
+      ClosedFormInverses<3>(batch, num_threads, inverse, singular);
+      break;
+    case 4:
+      ClosedFormInverses<4>(batch, num_threads, inverse, singular);
+      break;
+    default:
+      FactorizedInverses(batch, num_threads, inverse, singular);
+      break;
+  }
+
+  return inverse;
+}
+}  // namespace
+
+template <typename T>
+MatrixBatch<T>::MatrixBatch(std::size_t count, int rows, int cols)
+    : count_{count},
+      rows_{rows},
+      cols_{cols},
+      planes_{PlaneCount(rows, cols), PaddedCount<T>(count)} {}
+
+template <typename T>
+[[nodiscard]] std::size_t MatrixBatch<T>::GetCount() const noexcept {
+  return count_;
+}
+
+template <typename T>
+[[nodiscard]] int MatrixBatch<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <typename T>
+[[nodiscard]] int MatrixBatch<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <typename T>
+[[nodiscard]] std::size_t MatrixBatch<T>::GetPlaneStride() const noexcept {
+  return static_cast<std::size_t>(planes_.stride());
+}
+
+template <typename T>
+[[nodiscard]] T& MatrixBatch<T>::operator()(std::size_t index, int row,
+                                            int column) {
+  if (index >= count_ || row < 0 || column < 0 || row >= rows_ ||
+      column >= cols_) {
+    throw std::out_of_range{
+        "MatrixBatch::operator()(size_t, int, int): Index out of range. "
+        "The matrix index must be less than the count, and row and column "
+        "indices must be non-negative and within the matrix dimensions."};
+  }
+
+  return Plane(row, column)[index];
+}
+
+template <typename T>
+[[nodiscard]] const T& MatrixBatch<T>::operator()(std::size_t index, int row,
+                                                  int column) const {
+  if (index >= count_ || row < 0 || column < 0 || row >= rows_ ||
+      column >= cols_) {
+    throw std::out_of_range{
+        "MatrixBatch::operator()(size_t, int, int) const: Index out of range. "
+        "The matrix index must be less than the count, and row and column "
+        "indices must be non-negative and within the matrix dimensions."};
+  }
+
+  return Plane(row, column)[index];
+}
+
+template <typename T>
+[[nodiscard]] T* MatrixBatch<T>::Plane(int row, int column) {
+  return &planes_.AtUnchecked(row * cols_ + column, 0);
+}
+
+template <typename T>
+[[nodiscard]] const T* MatrixBatch<T>::Plane(int row,
+                                             int column) const noexcept {
+  return &planes_.AtUnchecked(row * cols_ + column, 0);
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> MatrixBatch<T>::Get(std::size_t index) const {
+  if (index >= count_) {
+    throw std::out_of_range{
+        "MatrixBatch::Get(size_t): Index out of range. "
+        "The matrix index must be less than the count."};
+  }
+
+  S21BasicMatrix<T> matrix{rows_, cols_};
+  for (int i{0}; i < rows_; ++i) {
+    for (int j{0}; j < cols_; ++j) {
+      matrix.AtUnchecked(i, j) = Plane(i, j)[index];
+    }
+  }
+
+  return matrix;
+}
+
+template <typename T>
+void MatrixBatch<T>::Set(std::size_t index, const S21BasicMatrix<T>& matrix) {
+  if (index >= count_) {
+    throw std::out_of_range{
+        "MatrixBatch::Set(size_t, const S21BasicMatrix&): Index out of "
+        "range. "
+        "The matrix index must be less than the count."};
+  }
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::invalid_argument{
+        "MatrixBatch::Set(size_t, const S21BasicMatrix&): Matrix dimensions "
+        "are not compatible. "
+        "The matrix must have the dimensions of the batch."};
+  }
+
+  for (int i{0}; i < rows_; ++i) {
+    for (int j{0}; j < cols_; ++j) {
+      Plane(i, j)[index] = matrix.AtUnchecked(i, j);
+    }
+  }
+}
+
+template <typename T>
+[[nodiscard]] std::vector<T> BatchDeterminant(const MatrixBatch<T>& batch,
+                                              int num_threads) {
+  const int size{batch.GetRows()};
+  if (size != batch.GetCols()) {
+    throw std::invalid_argument{
+        "BatchDeterminant(const MatrixBatch&, int): Matrix dimensions are "
+        "not compatible for determinant calculation. "
+        "The matrices must be square."};
+  }
+
+  std::vector<T> determinants(batch.GetCount());
+  switch (size) {
+    case 1:
+      ClosedFormDeterminants<1>(batch, num_threads, determinants);
+      break;
+    case 2:
+      ClosedFormDeterminants<2>(batch, num_threads, determinants);
+      break;
+    case 3:
+      ClosedFormDeterminants<3>(batch, num_threads, determinants);
+      break;
+    case 4:
+      ClosedFormDeterminants<4>(batch, num_threads, determinants);
+      break;
+    default:
+      ForEachChunk(batch.GetCount(), num_threads,
+                   [&](std::size_t begin, std::size_t end) {
+                     for (std::size_t index{begin}; index < end; ++index) {
+                       determinants[index] = batch.Get(index).Determinant();
+                     }
+                   });
+      break;
+  }
+
+  return determinants;
+}
+
+template <typename T>
+[[nodiscard]] MatrixBatch<typename ScalarTraits<T>::Factor> BatchInverse(
+    const MatrixBatch<T>& batch, int num_threads) {
+  const std::string function{"BatchInverse(const MatrixBatch&, int)"};
+  std::vector<unsigned char> singular;
+  auto inverse{Inverses(batch, num_threads, singular, function)};
+  const auto first{std::find(singular.begin(), singular.end(), 1)};
+  if (first != singular.end()) {
+    throw std::runtime_error{
+        function + ": Matrix " +
+        std::to_string(first - singular.begin()) +
+        " is singular, and its inverse does not exist. "
+        "The determinant of the matrix is zero."};
+  }
+
+  return inverse;
+}
+
+template <typename T>
+[[nodiscard]] MatrixBatch<typename ScalarTraits<T>::Factor> BatchInverse(
+    const MatrixBatch<T>& batch, std::vector<bool>& singular,
+    int num_threads) {
+  std::vector<unsigned char> flags;
+  auto inverse{Inverses(batch, num_threads, flags,
+                        "BatchInverse(const MatrixBatch&, vector<bool>&, "
+                        "int)")};
+  singular.assign(flags.begin(), flags.end());
+  return inverse;
+}
+
+template <typename T>
+[[nodiscard]] MatrixBatch<T> BatchMul(const MatrixBatch<T>& left,
+                                      const MatrixBatch<T>& right,
+                                      int num_threads) {
+  if (left.GetCount() != right.GetCount() ||
+      left.GetCols() != right.GetRows()) {
+    throw std::invalid_argument{
+        "BatchMul(const MatrixBatch&, const MatrixBatch&, int): Matrix "
+        "dimensions are not compatible for multiplication. "
+        "Both batches must hold the same number of matrices, and the number "
+        "of columns in the first must be equal to the number of rows in the "
+        "second."};
+  }
+
+  MatrixBatch<T> product{left.GetCount(), left.GetRows(), right.GetCols()};
+  const ProductOperation<T> operation{
+      left.Plane(0, 0),    left.GetPlaneStride(),    right.Plane(0, 0),
+      right.GetPlaneStride(), product.Plane(0, 0), product.GetPlaneStride(),
+      left.GetRows(),      left.GetCols(),           right.GetCols()};
+  ForEachChunk(left.GetCount(), num_threads,
+               [&](std::size_t begin, std::size_t end) {
+                 ApplyRange(operation, begin, end);
+               });
+
+  return product;
+}
+
+#define S21_INSTANTIATE_MATRIX_BATCH(T)                                      \
+  template class MatrixBatch<T>;                                             \
+  template std::vector<T> BatchDeterminant(const MatrixBatch<T>&, int);      \
+  template MatrixBatch<ScalarTraits<T>::Factor> BatchInverse(                \
+      const MatrixBatch<T>&, int);                                           \
+  template MatrixBatch<ScalarTraits<T>::Factor> BatchInverse(                \
+      const MatrixBatch<T>&, std::vector<bool>&, int);                       \
+  template MatrixBatch<T> BatchMul(const MatrixBatch<T>&,                    \
+                                   const MatrixBatch<T>&, int);
+
+S21_INSTANTIATE_MATRIX_BATCH(float)
+S21_INSTANTIATE_MATRIX_BATCH(double)
+S21_INSTANTIATE_MATRIX_BATCH(long double)
+S21_INSTANTIATE_MATRIX_BATCH(std::int32_t)
+S21_INSTANTIATE_MATRIX_BATCH(std::int64_t)
+S21_INSTANTIATE_MATRIX_BATCH(std::complex<float>)
+S21_INSTANTIATE_MATRIX_BATCH(std::complex<double>)
+
+#undef S21_INSTANTIATE_MATRIX_BATCH
+}  // namespace s21
@@ -0,0 +1,74 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_BATCH_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_BATCH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_traits.h"
+
+// Batches of many independent matrices of the same size, stored as a
+// struct of arrays: element (i, j) of every matrix is contiguous. The
+// batched operations below evaluate the closed forms of FixedMatrix on
+// several matrices per vector instruction, picked like the element-wise
+// kernels, and split the batch between threads. Matrices larger than 4x4
+// are factorized one by one. A thread count of zero means GetNumThreads().
+namespace s21 {
+// Instantiated for the same element types as S21BasicMatrix.
+template <typename T>
+class MatrixBatch {
+ public:
+  using value_type = T;
+
+  // count zero matrices of rows x cols.
+  MatrixBatch(std::size_t count, int rows, int cols);
+
+  [[nodiscard]] std::size_t GetCount() const noexcept;
+  [[nodiscard]] int GetRows() const noexcept;
+  [[nodiscard]] int GetCols() const noexcept;
+
+  [[nodiscard]] T& operator()(std::size_t index, int row, int column);
+  [[nodiscard]] const T& operator()(std::size_t index, int row,
+                                    int column) const;
+
+  // Element (row, column) of every matrix: GetCount() contiguous values,
+  // 64-byte aligned, at Plane(0, 0) + (row * cols + column) *
+  // GetPlaneStride(). Indices are not checked.
+  [[nodiscard]] T* Plane(int row, int column);
+  [[nodiscard]] const T* Plane(int row, int column) const noexcept;
+  [[nodiscard]] std::size_t GetPlaneStride() const noexcept;
+
+  [[nodiscard]] S21BasicMatrix<T> Get(std::size_t index) const;
+  void Set(std::size_t index, const S21BasicMatrix<T>& matrix);
+
+ private:
+  std::size_t count_;
+  int rows_;
+  int cols_;
+  // One row per plane, padded to whole cache lines.
+  S21BasicMatrix<T> planes_;
+};
+
+template <typename T>
+[[nodiscard]] std::vector<T> BatchDeterminant(const MatrixBatch<T>& batch,
+                                              int num_threads = 0);
+
+// Throws std::runtime_error naming the first singular matrix, by the rule
+// of LUDecomposition and FixedMatrix. The overload taking
+// singular reports them there instead and leaves their inverses zero.
+template <typename T>
+[[nodiscard]] MatrixBatch<typename ScalarTraits<T>::Factor> BatchInverse(
+    const MatrixBatch<T>& batch, int num_threads = 0);
+template <typename T>
+[[nodiscard]] MatrixBatch<typename ScalarTraits<T>::Factor> BatchInverse(
+    const MatrixBatch<T>& batch, std::vector<bool>& singular,
+    int num_threads = 0);
+
+// The products left[b] * right[b].
+template <typename T>
+[[nodiscard]] MatrixBatch<T> BatchMul(const MatrixBatch<T>& left,
+                                      const MatrixBatch<T>& right,
+                                      int num_threads = 0);
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_BATCH_H_
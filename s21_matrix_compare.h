@@ -0,0 +1,36 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_COMPARE_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_COMPARE_H_
+
+// How EqMatrix and Compare measure the difference of two elements a and b.
+// Equal elements, including equal infinities, differ by zero; a NaN on
+// either side differs by infinity and so never compares equal.
+namespace s21 {
+enum class Tolerance {
+  // |a - b|.
+  kAbsolute,
+  // |a - b| / max(|a|, |b|), so zero only ever equals zero.
+  kRelative,
+  // |a - b| in units in the last place of max(|a|, |b|). Counts exactly
+  // within a binade and at most halves the count across a power of two.
+  // Integer elements differ by |a - b| units.
+  kUlp
+};
+
+struct CompareOptions {
+  Tolerance mode{Tolerance::kAbsolute};
+  // Largest difference, in the unit of mode, that still counts as equal.
+  double tolerance{0.0};
+};
+
+// Outcome of comparing two matrices of the same size element by element.
+struct Comparison {
+  bool equal{true};
+  // Position of the first mismatch in row-major order, -1 if equal.
+  int row{-1};
+  int column{-1};
+  // Largest difference over all elements, in the unit of the mode.
+  double max_error{0.0};
+};
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_COMPARE_H_
@@ -0,0 +1,222 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_EXPRESSION_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_EXPRESSION_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Lazy element-wise arithmetic. operator+, operator- and multiplication by a
+// number return lightweight expression nodes that reference their operands;
+// the whole chain is evaluated in a single loop when it is assigned to or
+// used to construct a matrix. Nodes must not outlive the matrices they
+// reference, so prefer a matrix type over auto when storing a result.
+//
+// A temporary matrix operand lends its storage to the result: the chain is
+// evaluated in place into it and the new matrix takes it over, so
+// (a * b) * 2.0 - c allocates only for the product. Element-wise evaluation
+// reads every element before writing it, so this is safe even when the
+// temporary also appears as another operand.
+namespace s21 {
+template <typename T>
+class S21BasicMatrix;
+
+template <typename Derived>
+class MatrixExpression {
+ public:
+  [[nodiscard]] const Derived& Self() const {
+    return static_cast<const Derived&>(*this);
+  }
+};
+
+// Matrices are referenced by their nodes, intermediate nodes are copied so
+// that a chain stays valid after the full expression that created it.
+template <typename Operand>
+struct ExpressionOperand {
+  using Type = const Operand;
+};
+
+struct SumOperation {
+  template <typename Value>
+  [[nodiscard]] static Value Apply(const Value& left, const Value& right) {
+    return left + right;
+  }
+};
+
+struct DifferenceOperation {
+  template <typename Value>
+  [[nodiscard]] static Value Apply(const Value& left, const Value& right) {
+    return left - right;
+  }
+};
+
+// The matrix whose storage can receive the value of an expression, or
+// nullptr when no operand is expiring.
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T>* OwnedMatrix(const S21BasicMatrix<T>&) {
+  return nullptr;
+}
+
+template <typename Node>
+[[nodiscard]] auto* OwnedMatrix(const Node& node) {
+  return node.Owned();
+}
+
+// A temporary matrix passed to an operator, referenced until the full
+// expression ends.
+template <typename Matrix>
+class ExpiringMatrix : public MatrixExpression<ExpiringMatrix<Matrix>> {
+ public:
+  using value_type = typename Matrix::value_type;
+
+  explicit ExpiringMatrix(Matrix& matrix) : matrix_{&matrix} {}
+
+  [[nodiscard]] int GetRows() const { return matrix_->GetRows(); }
+  [[nodiscard]] int GetCols() const { return matrix_->GetCols(); }
+  [[nodiscard]] value_type Element(std::size_t index) const {
+    return matrix_->Element(index);
+  }
+  [[nodiscard]] Matrix* Owned() const { return matrix_; }
+
+ private:
+  Matrix* matrix_;
+};
+
+template <typename Argument>
+inline constexpr bool kIsExpression{std::is_base_of_v<
+    MatrixExpression<std::decay_t<Argument>>, std::decay_t<Argument>>};
+
+// Operand type of a node built from an argument of type Argument&&.
+template <typename Argument>
+struct NodeOperandOf {
+  using Type = std::decay_t<Argument>;
+};
+
+template <typename T>
+struct NodeOperandOf<S21BasicMatrix<T>> {
+  using Type = ExpiringMatrix<S21BasicMatrix<T>>;
+};
+
+template <typename Argument>
+using NodeOperand = typename NodeOperandOf<Argument>::Type;
+
+template <typename Argument>
+[[nodiscard]] decltype(auto) AsOperand(Argument&& argument) {
+  if constexpr (std::is_same_v<NodeOperand<Argument>,
+                               std::decay_t<Argument>>) {
+    return static_cast<const std::decay_t<Argument>&>(argument);
+  } else {
+    return NodeOperand<Argument>{argument};
+  }
+}
+
+template <typename Left, typename Right, typename Operation>
+class BinaryMatrixExpression
+    : public MatrixExpression<BinaryMatrixExpression<Left, Right, Operation>> {
+ public:
+  using value_type = typename Left::value_type;
+
+  BinaryMatrixExpression(const Left& left, const Right& right)
+      : left_{left}, right_{right} {}
+
+  [[nodiscard]] int GetRows() const { return left_.GetRows(); }
+  [[nodiscard]] int GetCols() const { return left_.GetCols(); }
+  [[nodiscard]] value_type Element(std::size_t index) const {
+    return Operation::Apply(left_.Element(index), right_.Element(index));
+  }
+  [[nodiscard]] S21BasicMatrix<value_type>* Owned() const {
+    S21BasicMatrix<value_type>* const owned{OwnedMatrix(left_)};
+    return owned != nullptr ? owned : OwnedMatrix(right_);
+  }
+
+ private:
+  typename ExpressionOperand<Left>::Type left_;
+  typename ExpressionOperand<Right>::Type right_;
+};
+
+template <typename Operand>
+class ScaledMatrixExpression
+    : public MatrixExpression<ScaledMatrixExpression<Operand>> {
+ public:
+  using value_type = typename Operand::value_type;
+
+  ScaledMatrixExpression(const Operand& operand, value_type number)
+      : operand_{operand}, number_{number} {}
+
+  [[nodiscard]] int GetRows() const { return operand_.GetRows(); }
+  [[nodiscard]] int GetCols() const { return operand_.GetCols(); }
+  [[nodiscard]] value_type Element(std::size_t index) const {
+    return operand_.Element(index) * number_;
+  }
+  [[nodiscard]] S21BasicMatrix<value_type>* Owned() const {
+    return OwnedMatrix(operand_);
+  }
+
+ private:
+  typename ExpressionOperand<Operand>::Type operand_;
+  value_type number_;
+};
+
+// Element-wise operands must share one element type; convert explicitly
+// between S21BasicMatrix instantiations first.
+template <typename Left, typename Right>
+inline constexpr bool kSameElementType{
+    std::is_same_v<typename Left::value_type, typename Right::value_type>};
+
+template <typename Left, typename Right,
+          typename = std::enable_if_t<kIsExpression<Left> &&
+                                      kIsExpression<Right>>>
+[[nodiscard]] BinaryMatrixExpression<NodeOperand<Left>, NodeOperand<Right>,
+                                     SumOperation>
+operator+(Left&& left, Right&& right) {
+  static_assert(kSameElementType<std::decay_t<Left>, std::decay_t<Right>>,
+                "Matrices of different element types cannot be added.");
+  if (left.GetRows() != right.GetRows() || left.GetCols() != right.GetCols()) {
+    throw std::invalid_argument{
+        "s21::operator+(const MatrixExpression&, const MatrixExpression&): "
+        "Matrix dimensions are not compatible for addition. "
+        "Both matrices must have the same number of rows and columns."};
+  }
+
+  return {AsOperand(std::forward<Left>(left)),
+          AsOperand(std::forward<Right>(right))};
+}
+
+template <typename Left, typename Right,
+          typename = std::enable_if_t<kIsExpression<Left> &&
+                                      kIsExpression<Right>>>
+[[nodiscard]] BinaryMatrixExpression<NodeOperand<Left>, NodeOperand<Right>,
+                                     DifferenceOperation>
+operator-(Left&& left, Right&& right) {
+  static_assert(kSameElementType<std::decay_t<Left>, std::decay_t<Right>>,
+                "Matrices of different element types cannot be subtracted.");
+  if (left.GetRows() != right.GetRows() || left.GetCols() != right.GetCols()) {
+    throw std::invalid_argument{
+        "s21::operator-(const MatrixExpression&, const MatrixExpression&): "
+        "Matrix dimensions are not compatible for subtraction. "
+        "Both matrices must have the same number of rows and columns."};
+  }
+
+  return {AsOperand(std::forward<Left>(left)),
+          AsOperand(std::forward<Right>(right))};
+}
+
+// Neither operator modifies the matrix or allocates.
+template <typename Operand,
+          typename = std::enable_if_t<kIsExpression<Operand>>>
+[[nodiscard]] ScaledMatrixExpression<NodeOperand<Operand>> operator*(
+    Operand&& operand,
+    const typename std::decay_t<Operand>::value_type number) {
+  return {AsOperand(std::forward<Operand>(operand)), number};
+}
+
+template <typename Operand,
+          typename = std::enable_if_t<kIsExpression<Operand>>>
+[[nodiscard]] ScaledMatrixExpression<NodeOperand<Operand>> operator*(
+    const typename std::decay_t<Operand>::value_type number,
+    Operand&& operand) {
+  return {AsOperand(std::forward<Operand>(operand)), number};
+}
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_EXPRESSION_H_
@@ -0,0 +1,469 @@
+#include "s21_matrix_io.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+namespace {
+// Header layout: field offsets in bytes. Multi-byte fields are stored in
+// the byte order given at kByteOrderOffset.
+constexpr std::size_t kHeaderSize{64};
+constexpr char kMagic[8]{'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::size_t kVersionOffset{8};
+constexpr std::size_t kDataOffsetOffset{12};
+constexpr std::size_t kElementTypeOffset{16};
+constexpr std::size_t kByteOrderOffset{17};
+constexpr std::size_t kElementSizeOffset{18};
+constexpr std::size_t kRowsOffset{24};
+constexpr std::size_t kColsOffset{32};
+
+constexpr std::uint32_t kFormatVersion{1};
+constexpr std::uint8_t kLittleEndian{1};
+constexpr std::uint8_t kBigEndian{2};
+constexpr std::uint8_t kNativeByteOrder{
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ ? kLittleEndian : kBigEndian};
+
+template <typename T>
+struct ElementTypeCode;
+template <>
+struct ElementTypeCode<float> : std::integral_constant<std::uint8_t, 1> {};
+template <>
+struct ElementTypeCode<double> : std::integral_constant<std::uint8_t, 2> {};
+template <>
+struct ElementTypeCode<long double>
+    : std::integral_constant<std::uint8_t, 3> {};
+template <>
+struct ElementTypeCode<std::int32_t>
+    : std::integral_constant<std::uint8_t, 4> {};
+template <>
+struct ElementTypeCode<std::int64_t>
+    : std::integral_constant<std::uint8_t, 5> {};
+template <>
+struct ElementTypeCode<std::complex<float>>
+    : std::integral_constant<std::uint8_t, 6> {};
+template <>
+struct ElementTypeCode<std::complex<double>>
+    : std::integral_constant<std::uint8_t, 7> {};
+
+// Byte order applies to each real component of a complex element.
+template <typename T>
+struct ComponentSize : std::integral_constant<std::size_t, sizeof(T)> {};
+template <typename T>
+struct ComponentSize<std::complex<T>>
+    : std::integral_constant<std::size_t, sizeof(T)> {};
+
+void ReverseBytes(void* data, std::size_t count, std::size_t width) {
+  auto* bytes{static_cast<unsigned char*>(data)};
+  for (std::size_t i{0}; i < count; ++i) {
+    std::reverse(bytes + i * width, bytes + (i + 1) * width);
+  }
+}
+
+template <typename Field>
+[[nodiscard]] Field ReadField(const unsigned char* header, std::size_t offset,
+                              bool swapped) {
+  Field value;
+  std::memcpy(&value, header + offset, sizeof(Field));
+  if (swapped) ReverseBytes(&value, 1, sizeof(Field));
+  return value;
+}
+
+template <typename Field>
+void WriteField(unsigned char* header, std::size_t offset, Field value) {
+  std::memcpy(header + offset, &value, sizeof(Field));
+}
+
+struct FileLayout {
+  int rows;
+  int cols;
+  std::size_t data_offset;
+  bool swapped;
+};
+
+[[noreturn]] void ThrowSystemError(const std::string& function,
+                                   const std::string& description,
+                                   const std::string& path) {
+  throw std::system_error{errno, std::generic_category(),
+                          function + ": " + description + " " + path};
+}
+
+template <typename T>
+[[nodiscard]] FileLayout ParseHeader(const unsigned char* header,
+                                     const std::string& function) {
+  if (std::memcmp(header, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error{function +
+                             ": File is not a matrix file. "
+                             "It must start with S21MATRX."};
+  }
+
+  const std::uint8_t byte_order{header[kByteOrderOffset]};
+  if (byte_order != kLittleEndian && byte_order != kBigEndian) {
+    throw std::runtime_error{function +
+                             ": File header is corrupt. "
+                             "Byte order must be little or big endian."};
+  }
+  const bool swapped{byte_order != kNativeByteOrder};
+
+  if (ReadField<std::uint32_t>(header, kVersionOffset, swapped) !=
+      kFormatVersion) {
+    throw std::runtime_error{function +
+                             ": File format version is not supported. "
+                             "Only version 1 can be read."};
+  }
+
+  if (header[kElementTypeOffset] != ElementTypeCode<T>::value ||
+      ReadField<std::uint16_t>(header, kElementSizeOffset, swapped) !=
+          sizeof(T)) {
+    throw std::runtime_error{function +
+                             ": Element type does not match. "
+                             "The file must hold elements of the matrix "
+                             "type."};
+  }
+
+  const std::uint32_t data_offset{
+      ReadField<std::uint32_t>(header, kDataOffsetOffset, swapped)};
+  const std::int64_t rows{ReadField<std::int64_t>(header, kRowsOffset,
+                                                  swapped)};
+  const std::int64_t cols{ReadField<std::int64_t>(header, kColsOffset,
+                                                  swapped)};
+  if (data_offset < kHeaderSize || rows <= 0 || cols <= 0 ||
+      rows > INT_MAX || cols > INT_MAX) {
+    throw std::runtime_error{function +
+                             ": File header is corrupt. "
+                             "Dimensions must be positive and fit in int."};
+  }
+
+  return {static_cast<int>(rows), static_cast<int>(cols), data_offset,
+          swapped};
+}
+}  // namespace
+
+template <typename T>
+MappedMatrix<T>::MappedMatrix(void* mapping, std::size_t length,
+                              std::size_t data_offset, int rows, int cols,
+                              MapMode mode) noexcept
+    : mapping_{mapping},
+      length_{length},
+      data_{reinterpret_cast<T*>(static_cast<unsigned char*>(mapping) +
+                                 data_offset)},
+      rows_{rows},
+      cols_{cols},
+      mode_{mode} {}
+
+template <typename T>
+MappedMatrix<T>::MappedMatrix(MappedMatrix&& other) noexcept
+    : mapping_{std::exchange(other.mapping_, nullptr)},
+      length_{std::exchange(other.length_, 0)},
+      data_{std::exchange(other.data_, nullptr)},
+      rows_{std::exchange(other.rows_, 0)},
+      cols_{std::exchange(other.cols_, 0)},
+      mode_{other.mode_} {}
+
+template <typename T>
+MappedMatrix<T>& MappedMatrix<T>::operator=(MappedMatrix&& other) noexcept {
+  if (this == &other) return *this;
+
+  Unmap();
+  mapping_ = std::exchange(other.mapping_, nullptr);
+  length_ = std::exchange(other.length_, 0);
+  data_ = std::exchange(other.data_, nullptr);
+  rows_ = std::exchange(other.rows_, 0);
+  cols_ = std::exchange(other.cols_, 0);
+  mode_ = other.mode_;
+
+  return *this;
+}
+
+template <typename T>
+MappedMatrix<T>::~MappedMatrix() {
+  Unmap();
+}
+
+template <typename T>
+[[nodiscard]] int MappedMatrix<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <typename T>
+[[nodiscard]] int MappedMatrix<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <typename T>
+[[nodiscard]] MapMode MappedMatrix<T>::GetMode() const noexcept {
+  return mode_;
+}
+
+template <typename T>
+[[nodiscard]] const T* MappedMatrix<T>::data() const noexcept {
+  return data_;
+}
+
+template <typename T>
+[[nodiscard]] const T& MappedMatrix<T>::operator()(int row,
+                                                   int column) const {
+  if (row < 0 || column < 0 || row >= rows_ || column >= cols_) {
+    throw std::out_of_range{
+        "MappedMatrix::operator()(int, int): Index out of range. "
+        "Row and column must lie within the matrix."};
+  }
+
+  return data_[static_cast<std::ptrdiff_t>(row) * cols_ + column];
+}
+
+template <typename T>
+[[nodiscard]] SubMatrixView<const T> MappedMatrix<T>::View() const noexcept {
+  return {data_, rows_, cols_, cols_};
+}
+
+template <typename T>
+[[nodiscard]] SubMatrixView<T> MappedMatrix<T>::MutableView() {
+  if (mode_ == MapMode::kReadOnly) {
+    throw std::logic_error{
+        "MappedMatrix::MutableView(): Mapping is read-only. "
+        "Map the file with MapMode::kCopyOnWrite to modify its elements."};
+  }
+
+  return {data_, rows_, cols_, cols_};
+}
+
+template <typename T>
+void MappedMatrix<T>::Unmap() noexcept {
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, length_);
+    mapping_ = nullptr;
+  }
+}
+
+template <typename T>
+MatrixFileWriter<T>::MatrixFileWriter(const std::string& path, int rows,
+                                      int cols)
+    : file_{nullptr}, path_{path}, cols_{cols}, remaining_{0} {
+  const std::string function{
+      "MatrixFileWriter::MatrixFileWriter(const string&, int, int)"};
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument{function +
+                                ": Matrix has improper dimensions. "
+                                "Rows and columns must be greater than zero."};
+  }
+
+  unsigned char header[kHeaderSize]{};
+  std::memcpy(header, kMagic, sizeof(kMagic));
+  WriteField(header, kVersionOffset, kFormatVersion);
+  WriteField(header, kDataOffsetOffset,
+             static_cast<std::uint32_t>(kHeaderSize));
+  WriteField(header, kElementTypeOffset, ElementTypeCode<T>::value);
+  WriteField(header, kByteOrderOffset, kNativeByteOrder);
+  WriteField(header, kElementSizeOffset,
+             static_cast<std::uint16_t>(sizeof(T)));
+  WriteField(header, kRowsOffset, static_cast<std::int64_t>(rows));
+  WriteField(header, kColsOffset, static_cast<std::int64_t>(cols));
+
+  file_ = std::fopen(path.c_str(), "wb");
+  if (file_ == nullptr) ThrowSystemError(function, "Cannot open file.", path);
+  if (std::fwrite(header, 1, kHeaderSize, file_) != kHeaderSize) {
+    const int error{errno};
+    std::fclose(file_);
+    errno = error;
+    ThrowSystemError(function, "Cannot write file.", path);
+  }
+  remaining_ = static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols);
+}
+
+template <typename T>
+MatrixFileWriter<T>::~MatrixFileWriter() {
+  if (file_ != nullptr) std::fclose(file_);
+}
+
+template <typename T>
+void MatrixFileWriter<T>::Write(const T* elements, std::size_t count) {
+  const std::string function{"MatrixFileWriter::Write(const T*, size_t)"};
+  if (file_ == nullptr) {
+    throw std::logic_error{function +
+                           ": Writer is closed. "
+                           "Elements can only be written before Close()."};
+  }
+  if (count > remaining_) {
+    throw std::invalid_argument{function +
+                                ": Too many elements. "
+                                "At most rows * cols elements can be "
+                                "written."};
+  }
+
+  if (std::fwrite(elements, sizeof(T), count, file_) != count) {
+    ThrowSystemError(function, "Cannot write file.", path_);
+  }
+  remaining_ -= count;
+}
+
+template <typename T>
+void MatrixFileWriter<T>::WriteRows(SubMatrixView<const T> rows) {
+  if (rows.GetCols() != cols_) {
+    throw std::invalid_argument{
+        "MatrixFileWriter::WriteRows(SubMatrixView): Row length does not "
+        "match. "
+        "The view must have as many columns as the matrix."};
+  }
+
+  for (int i{0}; i < rows.GetRows(); ++i) {
+    Write(rows.Row(i).data(), static_cast<std::size_t>(cols_));
+  }
+}
+
+template <typename T>
+void MatrixFileWriter<T>::Close() {
+  const std::string function{"MatrixFileWriter::Close()"};
+  if (file_ == nullptr) return;
+
+  const bool failed{std::fclose(std::exchange(file_, nullptr)) != 0};
+  if (failed) ThrowSystemError(function, "Cannot write file.", path_);
+  if (remaining_ != 0) {
+    throw std::runtime_error{function +
+                             ": File is incomplete. "
+                             "Exactly rows * cols elements must be written."};
+  }
+}
+
+template <typename T>
+[[nodiscard]] std::size_t MatrixFileWriter<T>::GetRemaining() const noexcept {
+  return remaining_;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Save(const std::string& path) const {
+  MatrixFileWriter<T> writer{path, rows_, cols_};
+  writer.Write(matrix_, ElementCount());
+  writer.Close();
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> S21BasicMatrix<T>::Load(
+    const std::string& path) {
+  const std::string function{"S21BasicMatrix::Load(const string&)"};
+  const std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{
+      std::fopen(path.c_str(), "rb"), &std::fclose};
+  if (file == nullptr) ThrowSystemError(function, "Cannot open file.", path);
+
+  unsigned char header[kHeaderSize];
+  if (std::fread(header, 1, kHeaderSize, file.get()) != kHeaderSize) {
+    throw std::runtime_error{function +
+                             ": File is truncated. "
+                             "It must hold a complete header."};
+  }
+  const FileLayout layout{ParseHeader<T>(header, function)};
+  if (std::fseek(file.get(), static_cast<long>(layout.data_offset),
+                 SEEK_SET) != 0) {
+    ThrowSystemError(function, "Cannot read file.", path);
+  }
+
+  S21BasicMatrix matrix{layout.rows, layout.cols};
+  const std::size_t count{matrix.ElementCount()};
+  if (std::fread(matrix.matrix_, sizeof(T), count, file.get()) != count) {
+    throw std::runtime_error{function +
+                             ": File is truncated. "
+                             "It must hold rows * cols elements."};
+  }
+  if (layout.swapped) {
+    ReverseBytes(matrix.matrix_, count * sizeof(T) / ComponentSize<T>::value,
+                 ComponentSize<T>::value);
+  }
+
+  return matrix;
+}
+
+template <typename T>
+[[nodiscard]] MappedMatrix<T> S21BasicMatrix<T>::MapFile(
+    const std::string& path, MapMode mode) {
+  const std::string function{
+      "S21BasicMatrix::MapFile(const string&, MapMode)"};
+  const int descriptor{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (descriptor < 0) ThrowSystemError(function, "Cannot open file.", path);
+
+  struct stat status {};
+  if (::fstat(descriptor, &status) != 0) {
+    const int error{errno};
+    ::close(descriptor);
+    errno = error;
+    ThrowSystemError(function, "Cannot read file.", path);
+  }
+  const std::size_t length{static_cast<std::size_t>(status.st_size)};
+  if (length < kHeaderSize) {
+    ::close(descriptor);
+    throw std::runtime_error{function +
+                             ": File is truncated. "
+                             "It must hold a complete header."};
+  }
+
+  const bool copy_on_write{mode == MapMode::kCopyOnWrite};
+  void* mapping{::mmap(nullptr, length,
+                       copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ,
+                       copy_on_write ? MAP_PRIVATE : MAP_SHARED, descriptor,
+                       0)};
+  const int error{errno};
+  ::close(descriptor);
+  if (mapping == MAP_FAILED) {
+    errno = error;
+    ThrowSystemError(function, "Cannot map file.", path);
+  }
+
+  // Owns the mapping from here on, so that the checks below unmap it when
+  // they throw.
+  MappedMatrix<T> mapped{mapping, length, 0, 0, 0, mode};
+  const FileLayout layout{
+      ParseHeader<T>(static_cast<const unsigned char*>(mapping), function)};
+  if (layout.swapped) {
+    throw std::runtime_error{function +
+                             ": Byte order is not native. "
+                             "Use Load() to read files written on machines "
+                             "with the other byte order."};
+  }
+  const std::size_t bytes{static_cast<std::size_t>(layout.rows) *
+                          static_cast<std::size_t>(layout.cols) * sizeof(T)};
+  if (length < layout.data_offset || length - layout.data_offset < bytes ||
+      layout.data_offset % alignof(T) != 0) {
+    throw std::runtime_error{function +
+                             ": File is truncated. "
+                             "It must hold rows * cols elements."};
+  }
+
+  mapped.data_ = reinterpret_cast<T*>(static_cast<unsigned char*>(mapping) +
+                                      layout.data_offset);
+  mapped.rows_ = layout.rows;
+  mapped.cols_ = layout.cols;
+
+  return mapped;
+}
+
+#define S21_INSTANTIATE_MATRIX_IO(T)                                        \
+  template class MappedMatrix<T>;                                           \
+  template class MatrixFileWriter<T>;                                       \
+  template void S21BasicMatrix<T>::Save(const std::string&) const;         \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::Load(const std::string&);   \
+  template MappedMatrix<T> S21BasicMatrix<T>::MapFile(const std::string&,   \
+                                                      MapMode);
+
+S21_INSTANTIATE_MATRIX_IO(float)
+S21_INSTANTIATE_MATRIX_IO(double)
+S21_INSTANTIATE_MATRIX_IO(long double)
+S21_INSTANTIATE_MATRIX_IO(std::int32_t)
+S21_INSTANTIATE_MATRIX_IO(std::int64_t)
+S21_INSTANTIATE_MATRIX_IO(std::complex<float>)
+S21_INSTANTIATE_MATRIX_IO(std::complex<double>)
+#undef S21_INSTANTIATE_MATRIX_IO
+}  // namespace s21
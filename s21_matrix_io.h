@@ -0,0 +1,91 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_IO_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_IO_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+#include "s21_matrix_view.h"
+
+// Binary matrix files. A file is a 64-byte header followed by the elements
+// in row-major order, starting at a 64-byte aligned offset. The header
+// holds the magic "S21MATRX", the format version, the element type and
+// size, the byte order the file was written in, the offset of the elements
+// and the dimensions. Files are written in the byte order of the machine;
+// S21BasicMatrix::Load reads either order, MapFile only the native one.
+namespace s21 {
+template <typename T>
+class S21BasicMatrix;
+
+enum class MapMode {
+  // Pages are shared with the file and cannot be written.
+  kReadOnly,
+  // Writes go to private copies of the touched pages; the file never
+  // changes.
+  kCopyOnWrite
+};
+
+// Matrix whose elements are a memory mapping of a matrix file. Pages are
+// read from disk on first access, so mapping takes the same time for any
+// file size. Copy the view into an S21BasicMatrix for a regular matrix.
+template <typename T>
+class MappedMatrix {
+ public:
+  MappedMatrix(MappedMatrix&& other) noexcept;
+  MappedMatrix& operator=(MappedMatrix&& other) noexcept;
+  MappedMatrix(const MappedMatrix&) = delete;
+  MappedMatrix& operator=(const MappedMatrix&) = delete;
+  ~MappedMatrix();
+
+  [[nodiscard]] int GetRows() const noexcept;
+  [[nodiscard]] int GetCols() const noexcept;
+  [[nodiscard]] MapMode GetMode() const noexcept;
+  [[nodiscard]] const T* data() const noexcept;
+  [[nodiscard]] const T& operator()(int row, int column) const;
+
+  [[nodiscard]] SubMatrixView<const T> View() const noexcept;
+  // Throws std::logic_error for read-only mappings.
+  [[nodiscard]] SubMatrixView<T> MutableView();
+
+ private:
+  friend class S21BasicMatrix<T>;
+
+  MappedMatrix(void* mapping, std::size_t length, std::size_t data_offset,
+               int rows, int cols, MapMode mode) noexcept;
+  void Unmap() noexcept;
+
+  void* mapping_;
+  std::size_t length_;
+  T* data_;
+  int rows_;
+  int cols_;
+  MapMode mode_;
+};
+
+// Writes a matrix file row by row, so that matrices larger than memory
+// can be produced piecewise. Elements are appended in row-major order.
+template <typename T>
+class MatrixFileWriter {
+ public:
+  MatrixFileWriter(const std::string& path, int rows, int cols);
+  MatrixFileWriter(const MatrixFileWriter&) = delete;
+  MatrixFileWriter& operator=(const MatrixFileWriter&) = delete;
+  // Closes the file without checking that it is complete.
+  ~MatrixFileWriter();
+
+  void Write(const T* elements, std::size_t count);
+  void WriteRows(SubMatrixView<const T> rows);
+  // Throws unless exactly rows * cols elements were written.
+  void Close();
+
+  [[nodiscard]] std::size_t GetRemaining() const noexcept;
+
+ private:
+  std::FILE* file_;
+  std::string path_;
+  int cols_;
+  std::size_t remaining_;
+};
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_IO_H_
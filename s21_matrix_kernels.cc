@@ -0,0 +1,412 @@
+#include "s21_matrix_kernels.h"
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace s21::kernels {
+namespace {
+// Register tile of the micro-kernel and cache blocking of the packed panels:
+// a kMc x kKc block of A stays in L2, a kKc x kNr sliver of B in L1. A row
+// of the tile spans one cache line whatever the element type, so float
+// kernels work on twice as many columns as double ones.
+constexpr int kMr{4};
+template <typename T>
+constexpr int kNr{static_cast<int>(64 / sizeof(T))};
+constexpr int kMc{96};
+constexpr int kKc{256};
+constexpr int kNc{2048};
+constexpr long long kSmallGemmVolume{32LL * 32 * 32};
+// Products below this volume run on the calling thread only; dispatching
+// them to the pool costs more than it saves.
+constexpr long long kParallelGemmVolume{128LL * 128 * 128};
+constexpr int kMinParallelTileCols{128};
+
+int RoundUp(int value, int multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+template <typename T>
+void SmallGemm(int m, int n, int k, const T* a, std::ptrdiff_t lda,
+               const T* b, std::ptrdiff_t ldb, T* c,
+               std::ptrdiff_t ldc) {
+  for (int i{0}; i < m; ++i) {
+    T* c_row{c + i * ldc};
+    for (int p{0}; p < k; ++p) {
+      const T a_value{a[i * lda + p]};
+      const T* b_row{b + p * ldb};
+      for (int j{0}; j < n; ++j) {
+        c_row[j] += a_value * b_row[j];
+      }
+    }
+  }
+}
+
+template <typename T>
+void PackA(int mc, int kc, const T* a, std::ptrdiff_t lda,
+           T* packed) {
+  for (int i{0}; i < mc; i += kMr) {
+    const int rows{std::min(kMr, mc - i)};
+    for (int p{0}; p < kc; ++p) {
+      for (int r{0}; r < kMr; ++r) {
+        *packed++ = r < rows ? a[(i + r) * lda + p] : T{};
+      }
+    }
+  }
+}
+
+template <typename T>
+void PackB(int kc, int nc, const T* b, std::ptrdiff_t ldb,
+           T* packed) {
+  for (int j{0}; j < nc; j += kNr<T>) {
+    const int cols{std::min(kNr<T>, nc - j)};
+    for (int p{0}; p < kc; ++p) {
+      const T* b_row{b + p * ldb + j};
+      for (int col{0}; col < kNr<T>; ++col) {
+        *packed++ = col < cols ? b_row[col] : T{};
+      }
+    }
+  }
+}
+
+template <typename T>
+void MicroKernel(int kc, const T* a, const T* b, T* c,
+                 std::ptrdiff_t ldc, int rows, int cols) {
+  T accumulator[kMr][kNr<T>]{};
+  for (int p{0}; p < kc; ++p, a += kMr, b += kNr<T>) {
+    for (int r{0}; r < kMr; ++r) {
+      const T a_value{a[r]};
+      for (int col{0}; col < kNr<T>; ++col) {
+        accumulator[r][col] += a_value * b[col];
+      }
+    }
+  }
+
+  for (int r{0}; r < rows; ++r) {
+    for (int col{0}; col < cols; ++col) {
+      c[r * ldc + col] += accumulator[r][col];
+    }
+  }
+}
+
+template <typename T>
+void MacroKernel(int mc, int nc, int kc, const T* packed_a,
+                 const T* packed_b, T* c, std::ptrdiff_t ldc) {
+  for (int j{0}; j < nc; j += kNr<T>) {
+    for (int i{0}; i < mc; i += kMr) {
+      MicroKernel(kc, packed_a + static_cast<std::ptrdiff_t>(i) * kc,
+                  packed_b + static_cast<std::ptrdiff_t>(j) * kc,
+                  c + i * ldc + j, ldc, std::min(kMr, mc - i),
+                  std::min(kNr<T>, nc - j));
+    }
+  }
+}
+
+template <typename T>
+void BlockedGemm(int m, int n, int k, const T* a, std::ptrdiff_t a_stride,
+                 const T* b, std::ptrdiff_t b_stride, T* c,
+                 std::ptrdiff_t c_stride) {
+  thread_local std::vector<T> packed_a;
+  thread_local std::vector<T> packed_b;
+  const int max_kc{std::min(k, kKc)};
+  packed_a.resize(
+      static_cast<std::size_t>(RoundUp(std::min(m, kMc), kMr)) * max_kc);
+  packed_b.resize(
+      static_cast<std::size_t>(RoundUp(std::min(n, kNc), kNr<T>)) * max_kc);
+
+  for (int jc{0}; jc < n; jc += kNc) {
+    const int nc{std::min(kNc, n - jc)};
+    for (int pc{0}; pc < k; pc += kKc) {
+      const int kc{std::min(kKc, k - pc)};
+      PackB(kc, nc, b + pc * b_stride + jc, b_stride, packed_b.data());
+      for (int ic{0}; ic < m; ic += kMc) {
+        const int mc{std::min(kMc, m - ic)};
+        PackA(mc, kc, a + ic * a_stride + pc, a_stride, packed_a.data());
+        MacroKernel(mc, nc, kc, packed_a.data(), packed_b.data(),
+                    c + ic * c_stride + jc, c_stride);
+      }
+    }
+  }
+}
+}  // namespace
+
+template <typename T>
+void Gemm(int m, int n, int k, const T* a, int lda, const T* b,
+          int ldb, T* c, int ldc, int num_threads) {
+  if (m <= 0 || n <= 0 || k <= 0) return;
+
+  const long long volume{static_cast<long long>(m) * n * k};
+  if (volume <= kSmallGemmVolume) {
+    SmallGemm(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+  if (num_threads <= 1 || volume < kParallelGemmVolume) {
+    BlockedGemm(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+
+  // Output tiles are independent, so each task packs its own panels and
+  // runs the full k loop for one tile of C.
+  const int row_tiles{(m + kMc - 1) / kMc};
+  const int wanted_col_tiles{(4 * num_threads + row_tiles - 1) / row_tiles};
+  const int tile_cols{std::min(
+      kNc, std::max(kMinParallelTileCols,
+                    RoundUp((n + wanted_col_tiles - 1) / wanted_col_tiles,
+                            kNr<T>)))};
+  const int col_tiles{(n + tile_cols - 1) / tile_cols};
+
+  const std::ptrdiff_t a_stride{lda};
+  const std::ptrdiff_t b_stride{ldb};
+  const std::ptrdiff_t c_stride{ldc};
+  ThreadPool::Global().ParallelFor(
+      row_tiles * col_tiles,
+      [&](int tile) {
+        const int row{tile / col_tiles * kMc};
+        const int col{tile % col_tiles * tile_cols};
+        BlockedGemm(std::min(kMc, m - row), std::min(tile_cols, n - col), k,
+                    a + row * a_stride, a_stride, b + col, b_stride,
+                    c + row * c_stride + col, c_stride);
+      },
+      num_threads);
+}
+
+namespace {
+// Block operations of the Strassen-Winograd step on rows x cols blocks.
+template <typename T>
+void CopyBlock(int rows, int cols, const T* source, std::ptrdiff_t ls,
+               T* destination, std::ptrdiff_t ld) {
+  for (int i{0}; i < rows; ++i) {
+    std::copy_n(source + i * ls, cols, destination + i * ld);
+  }
+}
+
+// destination = left + right.
+template <typename T>
+void SumBlocks(int rows, int cols, const T* left, std::ptrdiff_t ll,
+               const T* right, std::ptrdiff_t lr, T* destination,
+               std::ptrdiff_t ld) {
+  for (int i{0}; i < rows; ++i) {
+    std::copy_n(left + i * ll, cols, destination + i * ld);
+    Add(static_cast<std::size_t>(cols), right + i * lr, destination + i * ld);
+  }
+}
+
+// destination = left - right.
+template <typename T>
+void SubtractBlocks(int rows, int cols, const T* left, std::ptrdiff_t ll,
+                    const T* right, std::ptrdiff_t lr, T* destination,
+                    std::ptrdiff_t ld) {
+  for (int i{0}; i < rows; ++i) {
+    std::copy_n(left + i * ll, cols, destination + i * ld);
+    Subtract(static_cast<std::size_t>(cols), right + i * lr,
+             destination + i * ld);
+  }
+}
+
+// destination += source.
+template <typename T>
+void AccumulateBlock(int rows, int cols, const T* source, std::ptrdiff_t ls,
+                     T* destination, std::ptrdiff_t ld) {
+  for (int i{0}; i < rows; ++i) {
+    Add(static_cast<std::size_t>(cols), source + i * ls, destination + i * ld);
+  }
+}
+
+// destination -= source.
+template <typename T>
+void SubtractBlockInPlace(int rows, int cols, const T* source,
+                          std::ptrdiff_t ls, T* destination,
+                          std::ptrdiff_t ld) {
+  for (int i{0}; i < rows; ++i) {
+    Subtract(static_cast<std::size_t>(cols), source + i * ls,
+             destination + i * ld);
+  }
+}
+
+// destination = source - destination.
+template <typename T>
+void SubtractFromBlock(int rows, int cols, const T* source,
+                       std::ptrdiff_t ls, T* destination, std::ptrdiff_t ld) {
+  for (int i{0}; i < rows; ++i) {
+    Scale(static_cast<std::size_t>(cols), T{-1}, destination + i * ld);
+    Add(static_cast<std::size_t>(cols), source + i * ls, destination + i * ld);
+  }
+}
+
+template <typename T>
+void ZeroBlock(int rows, int cols, T* destination, std::ptrdiff_t ld) {
+  for (int i{0}; i < rows; ++i) {
+    std::fill_n(destination + i * ld, cols, T{});
+  }
+}
+
+template <typename T>
+void Strassen(int m, int n, int k, const T* a, std::ptrdiff_t lda,
+              const T* b, std::ptrdiff_t ldb, T* c, std::ptrdiff_t ldc,
+              int cutoff, int num_threads);
+
+// C = A * B for even m, n and k by Winograd's variant: seven half-size
+// products and fifteen block additions. Four temporaries of a quarter of
+// the operands each are live at once.
+template <typename T>
+void WinogradStep(int m, int n, int k, const T* a, std::ptrdiff_t lda,
+                  const T* b, std::ptrdiff_t ldb, T* c, std::ptrdiff_t ldc,
+                  int cutoff, int num_threads) {
+  const int h{m / 2};
+  const int w{n / 2};
+  const int d{k / 2};
+  const T* a11{a};
+  const T* a12{a + d};
+  const T* a21{a + h * lda};
+  const T* a22{a21 + d};
+  const T* b11{b};
+  const T* b12{b + w};
+  const T* b21{b + d * ldb};
+  const T* b22{b21 + w};
+  T* c11{c};
+  T* c12{c + w};
+  T* c21{c + h * ldc};
+  T* c22{c21 + w};
+
+  std::vector<T> s(static_cast<std::size_t>(h) * d);
+  std::vector<T> t(static_cast<std::size_t>(d) * w);
+  std::vector<T> x1(static_cast<std::size_t>(h) * w);
+  std::vector<T> x2(static_cast<std::size_t>(h) * w);
+  const auto product{[&](const T* left, std::ptrdiff_t ll, const T* right,
+                         std::ptrdiff_t lr, T* destination,
+                         std::ptrdiff_t ld) {
+    Strassen(h, w, d, left, ll, right, lr, destination, ld, cutoff,
+             num_threads);
+  }};
+
+  // P1 = A11 B11 and C11 = P1 + P2 with P2 = A12 B21.
+  product(a11, lda, b11, ldb, x1.data(), w);
+  product(a12, lda, b21, ldb, c11, ldc);
+  AccumulateBlock(h, w, x1.data(), w, c11, ldc);
+  // P5 = S1 T1 with S1 = A21 + A22 and T1 = B12 - B11, kept in C22.
+  SumBlocks(h, d, a21, lda, a22, lda, s.data(), d);
+  SubtractBlocks(d, w, b12, ldb, b11, ldb, t.data(), w);
+  product(s.data(), d, t.data(), w, c22, ldc);
+  // U2 = P1 + P6 with P6 = S2 T2, S2 = S1 - A11 and T2 = B22 - T1.
+  SubtractBlockInPlace(h, d, a11, lda, s.data(), d);
+  SubtractFromBlock(d, w, b22, ldb, t.data(), w);
+  product(s.data(), d, t.data(), w, x2.data(), w);
+  AccumulateBlock(h, w, x2.data(), w, x1.data(), w);
+  // P3 = S4 B22 with S4 = A12 - S2, kept in C12.
+  SubtractFromBlock(h, d, a12, lda, s.data(), d);
+  product(s.data(), d, b22, ldb, c12, ldc);
+  // P4 = A22 T4 with T4 = T2 - B21, kept in C21.
+  SubtractBlockInPlace(d, w, b21, ldb, t.data(), w);
+  product(a22, lda, t.data(), w, c21, ldc);
+  // U3 = U2 + P7 with P7 = S3 T3, S3 = A11 - A21 and T3 = B22 - B12.
+  SubtractBlocks(h, d, a11, lda, a21, lda, s.data(), d);
+  SubtractBlocks(d, w, b22, ldb, b12, ldb, t.data(), w);
+  product(s.data(), d, t.data(), w, x2.data(), w);
+  AccumulateBlock(h, w, x1.data(), w, x2.data(), w);
+  // C12 = U4 + P3 with U4 = U2 + P5, C22 = U3 + P5 and C21 = U3 - P4.
+  AccumulateBlock(h, w, c22, ldc, x1.data(), w);
+  AccumulateBlock(h, w, x1.data(), w, c12, ldc);
+  AccumulateBlock(h, w, x2.data(), w, c22, ldc);
+  SubtractFromBlock(h, w, x2.data(), w, c21, ldc);
+}
+
+// An odd dimension is peeled off: the even core goes through WinogradStep
+// and the last row, column or inner index through Gemm.
+template <typename T>
+void Strassen(int m, int n, int k, const T* a, std::ptrdiff_t lda,
+              const T* b, std::ptrdiff_t ldb, T* c, std::ptrdiff_t ldc,
+              int cutoff, int num_threads) {
+  if (m <= cutoff || n <= cutoff || k <= cutoff) {
+    ZeroBlock(m, n, c, ldc);
+    Gemm(m, n, k, a, static_cast<int>(lda), b, static_cast<int>(ldb), c,
+         static_cast<int>(ldc), num_threads);
+    return;
+  }
+
+  const int even_m{m & ~1};
+  const int even_n{n & ~1};
+  const int even_k{k & ~1};
+  WinogradStep(even_m, even_n, even_k, a, lda, b, ldb, c, ldc, cutoff,
+               num_threads);
+  if (even_k != k) {
+    Gemm(even_m, even_n, 1, a + even_k, static_cast<int>(lda),
+         b + even_k * ldb, static_cast<int>(ldb), c, static_cast<int>(ldc),
+         num_threads);
+  }
+  if (even_n != n) {
+    ZeroBlock(even_m, 1, c + even_n, ldc);
+    Gemm(even_m, 1, k, a, static_cast<int>(lda), b + even_n,
+         static_cast<int>(ldb), c + even_n, static_cast<int>(ldc),
+         num_threads);
+  }
+  if (even_m != m) {
+    ZeroBlock(1, n, c + even_m * ldc, ldc);
+    Gemm(1, n, k, a + even_m * lda, static_cast<int>(lda), b,
+         static_cast<int>(ldb), c + even_m * ldc, static_cast<int>(ldc),
+         num_threads);
+  }
+}
+}  // namespace
+
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T* a, int lda, const T* b,
+                  int ldb, T* c, int ldc, int cutoff, int num_threads) {
+  if (m <= 0 || n <= 0) return;
+
+  Strassen(m, n, k, a, lda, b, ldb, c, ldc, std::max(cutoff, 1),
+           num_threads);
+}
+
+[[nodiscard]] int StrassenLevels(int m, int n, int k, int cutoff) {
+  cutoff = std::max(cutoff, 1);
+  int levels{0};
+  while (m > cutoff && n > cutoff && k > cutoff) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    ++levels;
+  }
+
+  return levels;
+}
+
+template void Gemm(int, int, int, const float*, int, const float*, int, float*,
+                   int, int);
+template void Gemm(int, int, int, const double*, int, const double*, int,
+                   double*, int, int);
+template void Gemm(int, int, int, const long double*, int, const long double*,
+                   int, long double*, int, int);
+template void Gemm(int, int, int, const std::int32_t*, int,
+                   const std::int32_t*, int, std::int32_t*, int, int);
+template void Gemm(int, int, int, const std::int64_t*, int,
+                   const std::int64_t*, int, std::int64_t*, int, int);
+template void Gemm(int, int, int, const std::complex<float>*, int,
+                   const std::complex<float>*, int, std::complex<float>*, int,
+                   int);
+template void Gemm(int, int, int, const std::complex<double>*, int,
+                   const std::complex<double>*, int, std::complex<double>*,
+                   int, int);
+template void StrassenGemm(int, int, int, const float*, int, const float*,
+                           int, float*, int, int, int);
+template void StrassenGemm(int, int, int, const double*, int, const double*,
+                           int, double*, int, int, int);
+template void StrassenGemm(int, int, int, const long double*, int,
+                           const long double*, int, long double*, int, int,
+                           int);
+template void StrassenGemm(int, int, int, const std::int32_t*, int,
+                           const std::int32_t*, int, std::int32_t*, int, int,
+                           int);
+template void StrassenGemm(int, int, int, const std::int64_t*, int,
+                           const std::int64_t*, int, std::int64_t*, int, int,
+                           int);
+template void StrassenGemm(int, int, int, const std::complex<float>*, int,
+                           const std::complex<float>*, int,
+                           std::complex<float>*, int, int, int);
+template void StrassenGemm(int, int, int, const std::complex<double>*, int,
+                           const std::complex<double>*, int,
+                           std::complex<double>*, int, int, int);
+}  // namespace s21::kernels
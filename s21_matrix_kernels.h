@@ -0,0 +1,91 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_KERNELS_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_KERNELS_H_
+
+#include <cstddef>
+
+#include "s21_matrix_compare.h"
+
+namespace s21::kernels {
+enum class SimdLevel { kScalar, kSse2, kAvx2, kAvx512 };
+
+// The element-wise kernels below pick an implementation for the best
+// instruction set reported by the CPU at first use. SetSimdLevel() lowers
+// the choice, e.g. to compare implementations; levels the CPU lacks are
+// clamped to the detected one.
+[[nodiscard]] SimdLevel DetectSimdLevel();
+[[nodiscard]] SimdLevel GetSimdLevel();
+void SetSimdLevel(SimdLevel level);
+
+// The kernels below are instantiated for float, double, long double,
+// std::int32_t, std::int64_t, std::complex<float> and std::complex<double>;
+// float and double use the vector implementations.
+
+// destination[i] += source[i], destination[i] -= source[i] and
+// destination[i] *= number for i in [0, size).
+template <typename T>
+void Add(std::size_t size, const T* source, T* destination);
+template <typename T>
+void Subtract(std::size_t size, const T* source, T* destination);
+template <typename T>
+void Scale(std::size_t size, T number, T* destination);
+
+// Whether |left[i] - right[i]| <= tolerance for every i in [0, size).
+template <typename T>
+[[nodiscard]] bool AllClose(std::size_t size, const T* left, const T* right,
+                            double tolerance);
+
+struct ElementComparison {
+  // size if every element is within the tolerance.
+  std::size_t first_mismatch;
+  // Over the elements compared, see Compare.
+  double max_error;
+};
+
+// Compares left[i] with right[i] for i in [0, size) as described in
+// s21_matrix_compare.h. The vector implementations reduce blocks of a few
+// kilobytes without branching and look for the mismatch only inside a
+// block that has one. With stop_at_mismatch the scan ends after that
+// block, and max_error covers the elements up to there.
+template <typename T>
+[[nodiscard]] ElementComparison Compare(std::size_t size, const T* left,
+                                        const T* right,
+                                        const CompareOptions& options,
+                                        bool stop_at_mismatch);
+
+// Writes the transpose of the rows x cols source into destination,
+// recursively halving the larger dimension so that every level of the
+// memory hierarchy sees blocks that fit.
+template <typename T>
+void Transpose(int rows, int cols, const T* source, int source_stride,
+               T* destination, int destination_stride);
+
+// Transposes a square block in place.
+template <typename T>
+void TransposeInPlace(int size, T* data, int stride);
+
+// Rearranges a contiguous rows x cols matrix into its cols x rows transpose
+// in place by following the cycles of the index permutation. The only extra
+// memory is one bit per element.
+template <typename T>
+void TransposeInPlace(int rows, int cols, T* data);
+
+// Computes C += A * B for row-major A (m x k), B (k x n) and C (m x n) with
+// leading dimensions lda, ldb and ldc on up to num_threads threads. C must
+// not alias A or B.
+template <typename T>
+void Gemm(int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c,
+          int ldc, int num_threads);
+
+// Overwrites C with A * B by Strassen-Winograd recursion while m, n and k
+// all exceed cutoff, and Gemm below it. Odd dimensions are peeled off at
+// every level and handled by Gemm, so any size works. Each level holds
+// temporaries of about a quarter of A, B and twice C.
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T* a, int lda, const T* b,
+                  int ldb, T* c, int ldc, int cutoff, int num_threads);
+
+// Number of halvings StrassenGemm performs before reaching Gemm.
+[[nodiscard]] int StrassenLevels(int m, int n, int k, int cutoff);
+}  // namespace s21::kernels
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_KERNELS_H_
@@ -0,0 +1,233 @@
+#include "s21_matrix_memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+namespace s21 {
+namespace {
+// Size classes are the powers of two from 1 << kMinClassShift to
+// 1 << kMaxClassShift bytes. A thread caches at most kMaxCachedBlocks
+// blocks and kMaxCachedBytes bytes of each class.
+constexpr std::size_t kMinClassShift{6};
+constexpr std::size_t kMaxClassShift{22};
+constexpr std::size_t kClassCount{kMaxClassShift - kMinClassShift + 1};
+constexpr std::size_t kMaxCachedBlocks{64};
+constexpr std::size_t kMaxCachedBytes{std::size_t{8} << 20};
+
+std::atomic<std::size_t> upstream_allocations{0};
+std::atomic<std::size_t> upstream_deallocations{0};
+
+void* AllocateUpstream(std::size_t bytes, std::size_t alignment) {
+  ++upstream_allocations;
+  return ::operator new(bytes, std::align_val_t{alignment});
+}
+
+void DeallocateUpstream(void* pointer, std::size_t bytes,
+                        std::size_t alignment) {
+  ++upstream_deallocations;
+  ::operator delete(pointer, bytes, std::align_val_t{alignment});
+}
+
+[[nodiscard]] bool IsPooled(std::size_t bytes, std::size_t alignment) {
+  return bytes <= (std::size_t{1} << kMaxClassShift) &&
+         alignment <= kMatrixStorageAlignment;
+}
+
+[[nodiscard]] std::size_t SizeClass(std::size_t bytes) {
+  std::size_t size_class{0};
+  while ((std::size_t{1} << (size_class + kMinClassShift)) < bytes) {
+    ++size_class;
+  }
+
+  return size_class;
+}
+
+[[nodiscard]] std::size_t ClassSize(std::size_t size_class) {
+  return std::size_t{1} << (size_class + kMinClassShift);
+}
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+// Trivially destructible, so it stays readable while other thread-local
+// and static objects that own matrices are destroyed after the cache.
+thread_local bool cache_destroyed{false};
+
+struct ThreadCache {
+  ~ThreadCache() {
+    for (std::size_t size_class{0}; size_class < kClassCount; ++size_class) {
+      while (FreeBlock* block{heads[size_class]}) {
+        heads[size_class] = block->next;
+        DeallocateUpstream(block, ClassSize(size_class),
+                           kMatrixStorageAlignment);
+      }
+    }
+    cache_destroyed = true;
+  }
+
+  FreeBlock* heads[kClassCount]{};
+  std::size_t counts[kClassCount]{};
+};
+
+ThreadCache* LocalCache() {
+  if (cache_destroyed) return nullptr;
+
+  thread_local ThreadCache cache;
+  return &cache;
+}
+
+class ThreadCachingPool : public std::pmr::memory_resource {
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    if (!IsPooled(bytes, alignment)) {
+      return AllocateUpstream(bytes,
+                              std::max(alignment, kMatrixStorageAlignment));
+    }
+
+    const std::size_t size_class{SizeClass(bytes)};
+    ThreadCache* cache{LocalCache()};
+    if (cache != nullptr && cache->heads[size_class] != nullptr) {
+      FreeBlock* block{cache->heads[size_class]};
+      cache->heads[size_class] = block->next;
+      --cache->counts[size_class];
+      return block;
+    }
+
+    return AllocateUpstream(ClassSize(size_class), kMatrixStorageAlignment);
+  }
+
+  void do_deallocate(void* pointer, std::size_t bytes,
+                     std::size_t alignment) override {
+    if (!IsPooled(bytes, alignment)) {
+      DeallocateUpstream(pointer, bytes,
+                         std::max(alignment, kMatrixStorageAlignment));
+      return;
+    }
+
+    const std::size_t size_class{SizeClass(bytes)};
+    const std::size_t class_size{ClassSize(size_class)};
+    ThreadCache* cache{LocalCache()};
+    if (cache == nullptr ||
+        cache->counts[size_class] >=
+            std::min(kMaxCachedBlocks,
+                     std::max(std::size_t{1}, kMaxCachedBytes / class_size))) {
+      DeallocateUpstream(pointer, class_size, kMatrixStorageAlignment);
+      return;
+    }
+
+    FreeBlock* block{::new (pointer) FreeBlock{cache->heads[size_class]}};
+    cache->heads[size_class] = block;
+    ++cache->counts[size_class];
+  }
+
+  [[nodiscard]] bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+thread_local std::pmr::memory_resource* default_resource{nullptr};
+}  // namespace
+
+[[nodiscard]] std::pmr::memory_resource* ThreadLocalPool() noexcept {
+  static ThreadCachingPool pool;
+  return &pool;
+}
+
+[[nodiscard]] PoolStatistics GetPoolStatistics() noexcept {
+  return {upstream_allocations, upstream_deallocations};
+}
+
+MatrixArena::MatrixArena(std::size_t initial_size,
+                         std::pmr::memory_resource* upstream)
+    : upstream_{upstream},
+      next_chunk_size_{std::max(initial_size, kMatrixStorageAlignment)} {}
+
+MatrixArena::~MatrixArena() {
+  for (const Chunk& chunk : chunks_) {
+    upstream_->deallocate(chunk.data, chunk.size, kMatrixStorageAlignment);
+  }
+}
+
+void MatrixArena::Reset() noexcept {
+  if (chunks_.empty()) return;
+
+  auto largest{std::max_element(
+      chunks_.begin(), chunks_.end(),
+      [](const Chunk& left, const Chunk& right) {
+        return left.size < right.size;
+      })};
+  std::iter_swap(chunks_.begin(), largest);
+  for (auto chunk{chunks_.begin() + 1}; chunk != chunks_.end(); ++chunk) {
+    upstream_->deallocate(chunk->data, chunk->size, kMatrixStorageAlignment);
+  }
+  chunks_.resize(1);
+  offset_ = 0;
+  bytes_allocated_ = 0;
+}
+
+[[nodiscard]] std::size_t MatrixArena::GetBytesAllocated() const noexcept {
+  return bytes_allocated_;
+}
+
+[[nodiscard]] std::size_t MatrixArena::GetCapacity() const noexcept {
+  std::size_t capacity{0};
+  for (const Chunk& chunk : chunks_) {
+    capacity += chunk.size;
+  }
+
+  return capacity;
+}
+
+void* MatrixArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  if (!chunks_.empty()) {
+    const Chunk& chunk{chunks_.back()};
+    const std::uintptr_t base{reinterpret_cast<std::uintptr_t>(chunk.data)};
+    const std::uintptr_t start{(base + offset_ + alignment - 1) &
+                               ~(std::uintptr_t{alignment} - 1)};
+    if (start + bytes <= base + chunk.size) {
+      offset_ = start + bytes - base;
+      bytes_allocated_ += bytes;
+      return reinterpret_cast<void*>(start);
+    }
+  }
+
+  const std::size_t chunk_size{std::max(next_chunk_size_, bytes + alignment)};
+  chunks_.push_back({static_cast<std::byte*>(upstream_->allocate(
+                         chunk_size, kMatrixStorageAlignment)),
+                     chunk_size});
+  next_chunk_size_ = chunk_size * 2;
+  offset_ = 0;
+
+  return do_allocate(bytes, alignment);
+}
+
+void MatrixArena::do_deallocate(void*, std::size_t, std::size_t) {}
+
+[[nodiscard]] bool MatrixArena::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+[[nodiscard]] std::pmr::memory_resource* GetDefaultMatrixResource() noexcept {
+  return default_resource != nullptr ? default_resource : ThreadLocalPool();
+}
+
+std::pmr::memory_resource* SetDefaultMatrixResource(
+    std::pmr::memory_resource* resource) noexcept {
+  std::pmr::memory_resource* previous{GetDefaultMatrixResource()};
+  default_resource = resource;
+  return previous;
+}
+
+ScopedMatrixResource::ScopedMatrixResource(
+    std::pmr::memory_resource* resource) noexcept
+    : previous_{SetDefaultMatrixResource(resource)} {}
+
+ScopedMatrixResource::~ScopedMatrixResource() {
+  SetDefaultMatrixResource(previous_);
+}
+}  // namespace s21
@@ -0,0 +1,88 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_MEMORY_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_MEMORY_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Memory resources for matrix storage. Every matrix allocates from the
+// resource it was created with; matrices created without one use the
+// calling thread's default, which starts out as ThreadLocalPool().
+namespace s21 {
+// Alignment of every matrix allocation, one cache line.
+inline constexpr std::size_t kMatrixStorageAlignment{64};
+
+// Process-wide resource that keeps a small cache of freed blocks per size
+// class (powers of two from 64 bytes to 4 MiB) in every thread, so that
+// matrices of recurring sizes are recycled without touching the global
+// heap or taking a lock. Larger blocks, and blocks freed while a thread's
+// cache is full, go straight to aligned operator new and delete. Blocks
+// may be freed on any thread.
+[[nodiscard]] std::pmr::memory_resource* ThreadLocalPool() noexcept;
+
+struct PoolStatistics {
+  std::size_t upstream_allocations;
+  std::size_t upstream_deallocations;
+};
+
+// Number of blocks ThreadLocalPool() has requested from and returned to
+// the global heap so far, over all threads.
+[[nodiscard]] PoolStatistics GetPoolStatistics() noexcept;
+
+// Bump allocator for request-scoped work: allocations advance a pointer
+// through large chunks, deallocations are ignored, and Reset() releases
+// everything at once while keeping the largest chunk for the next request.
+// Not thread-safe; use one arena per thread.
+class MatrixArena : public std::pmr::memory_resource {
+ public:
+  explicit MatrixArena(
+      std::size_t initial_size = std::size_t{1} << 20,
+      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+  MatrixArena(const MatrixArena&) = delete;
+  MatrixArena& operator=(const MatrixArena&) = delete;
+  ~MatrixArena() override;
+
+  // Invalidates every matrix allocated from the arena.
+  void Reset() noexcept;
+  [[nodiscard]] std::size_t GetBytesAllocated() const noexcept;
+  [[nodiscard]] std::size_t GetCapacity() const noexcept;
+
+ private:
+  struct Chunk {
+    std::byte* data;
+    std::size_t size;
+  };
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* pointer, std::size_t bytes,
+                     std::size_t alignment) override;
+  [[nodiscard]] bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override;
+
+  std::pmr::memory_resource* upstream_;
+  std::vector<Chunk> chunks_;
+  std::size_t next_chunk_size_;
+  std::size_t offset_{0};
+  std::size_t bytes_allocated_{0};
+};
+
+// Resource used by matrices created on this thread without an explicit one.
+[[nodiscard]] std::pmr::memory_resource* GetDefaultMatrixResource() noexcept;
+// Returns the previous default; nullptr restores ThreadLocalPool().
+std::pmr::memory_resource* SetDefaultMatrixResource(
+    std::pmr::memory_resource* resource) noexcept;
+
+// Makes resource the thread's default for the lifetime of the object.
+class ScopedMatrixResource {
+ public:
+  explicit ScopedMatrixResource(std::pmr::memory_resource* resource) noexcept;
+  ScopedMatrixResource(const ScopedMatrixResource&) = delete;
+  ScopedMatrixResource& operator=(const ScopedMatrixResource&) = delete;
+  ~ScopedMatrixResource();
+
+ private:
+  std::pmr::memory_resource* previous_;
+};
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_MEMORY_H_
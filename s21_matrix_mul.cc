@@ -0,0 +1,42 @@
+#include "s21_matrix_mul.h"
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_matrix_kernels.h"
+
+namespace s21 {
+namespace {
+std::atomic<MulAlgorithm> default_algorithm{MulAlgorithm::kClassic};
+std::atomic<int> default_strassen_cutoff{MulOptions{}.strassen_cutoff};
+std::atomic<int> default_num_threads{0};
+}  // namespace
+
+void SetDefaultMulOptions(const MulOptions& options) {
+  if (options.strassen_cutoff < 1 || options.num_threads < 0) {
+    throw std::invalid_argument{
+        "SetDefaultMulOptions(const MulOptions&): Options are out of range. "
+        "The Strassen cutoff must be positive and the thread count must not "
+        "be negative."};
+  }
+
+  default_algorithm = options.algorithm;
+  default_strassen_cutoff = options.strassen_cutoff;
+  default_num_threads = options.num_threads;
+}
+
+[[nodiscard]] MulOptions GetDefaultMulOptions() {
+  return {default_algorithm, default_strassen_cutoff, default_num_threads};
+}
+
+[[nodiscard]] double MulErrorGrowth(int m, int n, int k,
+                                    const MulOptions& options) {
+  const double inner{static_cast<double>(k)};
+  if (options.algorithm == MulAlgorithm::kClassic) return inner * inner;
+
+  const int levels{kernels::StrassenLevels(m, n, k, options.strassen_cutoff)};
+  const double leaf{inner / std::pow(2.0, levels)};
+  return std::pow(18.0, levels) * (leaf * leaf + 6.0 * leaf) - 6.0 * inner;
+}
+}  // namespace s21
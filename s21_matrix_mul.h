@@ -0,0 +1,52 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_MUL_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_MUL_H_
+
+// How dense products are computed. operator*, operator*= and MulMatrix
+// without options follow the process-wide defaults; MulMatrix also takes
+// options per call.
+namespace s21 {
+enum class MulAlgorithm {
+  // Blocked O(n^3) kernel.
+  kClassic,
+  // Winograd's variant of Strassen's algorithm, O(n^2.81) down to the
+  // cutoff. Faster for large products at the price of a weaker,
+  // normwise error bound; see MulErrorBound.
+  kStrassenWinograd
+};
+
+struct MulOptions {
+  MulAlgorithm algorithm{MulAlgorithm::kClassic};
+  // Strassen-Winograd halves the product while all three dimensions
+  // exceed this, then switches to the classic kernel.
+  int strassen_cutoff{512};
+  // Zero means GetNumThreads().
+  int num_threads{0};
+};
+
+// First-order a priori bound on the error of every element of a product
+// C = AB: |c_ij - computed c_ij| <= bound = growth * u * max|a_ij| *
+// max|b_ij|, with u the unit roundoff of the element type. Classic
+// products have growth k^2 for inner dimension k; Strassen-Winograd with
+// l levels down to inner dimension k0 = k / 2^l has 18^l (k0^2 + 6 k0) -
+// 6k (Higham, Accuracy and Stability of Numerical Algorithms, 23.2.2).
+// Complex products double the growth. Integer products are exact unless
+// they overflow, so their bound is zero.
+struct MulErrorBound {
+  MulAlgorithm algorithm;
+  int recursion_levels;
+  double growth;
+  double bound;
+};
+
+// Throws std::invalid_argument for a cutoff below one or a negative thread
+// count.
+void SetDefaultMulOptions(const MulOptions& options);
+[[nodiscard]] MulOptions GetDefaultMulOptions();
+
+// Growth factor of MulErrorBound for an m x k times k x n product of real
+// elements.
+[[nodiscard]] double MulErrorGrowth(int m, int n, int k,
+                                    const MulOptions& options);
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_MUL_H_
@@ -1,307 +1,743 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_profile.h"
+
 namespace s21::constants {
-constexpr double kPrecision{1e-7};
 constexpr int kDefaultMatrixSize{3};
 }  // namespace s21::constants
 
 namespace s21 {
-S21Matrix::S21Matrix()
-    : S21Matrix{constants::kDefaultMatrixSize, constants::kDefaultMatrixSize} {}
+namespace {
+// Fraction-free Gaussian elimination: every intermediate entry is a minor
+// of the matrix, so the determinant of an integer matrix is exact as long
+// as the products of two minors fit in T.
+template <typename T>
+T BareissDeterminant(const S21BasicMatrix<T>& matrix) {
+  const int size{matrix.GetRows()};
+  S21BasicMatrix<T> work{matrix};
+  T sign{1};
+  T previous_pivot{1};
+  for (int k{0}; k < size - 1; ++k) {
+    if (work.AtUnchecked(k, k) == 0) {
+      int pivot_row{k + 1};
+      while (pivot_row < size && work.AtUnchecked(pivot_row, k) == 0) {
+        ++pivot_row;
+      }
+      if (pivot_row == size) return T{};
+
+      for (int j{k}; j < size; ++j) {
+        std::swap(work.AtUnchecked(k, j), work.AtUnchecked(pivot_row, j));
+      }
+      sign = -sign;
+    }
+
+    const T pivot{work.AtUnchecked(k, k)};
+    for (int i{k + 1}; i < size; ++i) {
+      for (int j{k + 1}; j < size; ++j) {
+        work.AtUnchecked(i, j) = (work.AtUnchecked(i, j) * pivot -
+                                  work.AtUnchecked(i, k) *
+                                      work.AtUnchecked(k, j)) /
+                                 previous_pivot;
+      }
+    }
+    previous_pivot = pivot;
+  }
+
+  return sign * work.AtUnchecked(size - 1, size - 1);
+}
+
+// Adjugate of a singular square matrix. Complete pivoting gives PAQ = LU
+// with the rank revealed by the trailing pivots: below rank n - 1 the
+// adjugate vanishes, at rank n - 1 it is the rank-one matrix
+// sign * Q adj(U) L^-1 P with adj(U) = c x e_n^T, Ux = 0 and c the product
+// of the first n - 1 pivots. Pivots are taken as zero by the rule of
+// LUDecomposition; a last pivot left over from rounding changes the
+// adjugate by no more than its size.
+template <typename T>
+S21BasicMatrix<T> RankDeficientAdjugate(const S21BasicMatrix<T>& matrix) {
+  using Real = typename ScalarTraits<T>::Real;
+  const int size{matrix.GetRows()};
+  S21BasicMatrix<T> lu{matrix};
+  S21BasicMatrix<T> adjugate{size, size};
+  std::vector<int> row_permutation(static_cast<std::size_t>(size));
+  std::vector<int> col_permutation(static_cast<std::size_t>(size));
+  std::iota(row_permutation.begin(), row_permutation.end(), 0);
+  std::iota(col_permutation.begin(), col_permutation.end(), 0);
+
+  std::vector<Real> thresholds(static_cast<std::size_t>(size));
+  for (int i{0}; i < size; ++i) {
+    for (int j{0}; j < size; ++j) {
+      thresholds[i] = std::max(thresholds[i], std::abs(lu.AtUnchecked(i, j)));
+    }
+    thresholds[i] *= ScalarTraits<T>::PivotTolerance(size);
+  }
+
+  int sign{1};
+  int rank{0};
+  for (int k{0}; k < size; ++k) {
+    int pivot_row{k};
+    int pivot_col{k};
+    for (int i{k}; i < size; ++i) {
+      for (int j{k}; j < size; ++j) {
+        if (std::abs(lu.AtUnchecked(i, j)) >
+            std::abs(lu.AtUnchecked(pivot_row, pivot_col))) {
+          pivot_row = i;
+          pivot_col = j;
+        }
+      }
+    }
+    if (std::abs(lu.AtUnchecked(pivot_row, pivot_col)) <=
+        thresholds[pivot_row]) {
+      break;
+    }
+
+    if (pivot_row != k) {
+      for (int j{0}; j < size; ++j) {
+        std::swap(lu.AtUnchecked(k, j), lu.AtUnchecked(pivot_row, j));
+      }
+      std::swap(row_permutation[k], row_permutation[pivot_row]);
+      std::swap(thresholds[k], thresholds[pivot_row]);
+      sign = -sign;
+    }
+    if (pivot_col != k) {
+      for (int i{0}; i < size; ++i) {
+        std::swap(lu.AtUnchecked(i, k), lu.AtUnchecked(i, pivot_col));
+      }
+      std::swap(col_permutation[k], col_permutation[pivot_col]);
+      sign = -sign;
+    }
+
+    for (int i{k + 1}; i < size; ++i) {
+      const T factor{lu.AtUnchecked(i, k) / lu.AtUnchecked(k, k)};
+      lu.AtUnchecked(i, k) = factor;
+      for (int j{k + 1}; j < size; ++j) {
+        lu.AtUnchecked(i, j) -= factor * lu.AtUnchecked(k, j);
+      }
+    }
+    ++rank;
+  }
+  if (rank < size - 1) return adjugate;
+
+  const int last{size - 1};
+  std::vector<T> x(static_cast<std::size_t>(size));
+  std::vector<T> w(static_cast<std::size_t>(size));
+  x[last] = T{1};
+  for (int i{last - 1}; i >= 0; --i) {
+    T sum{};
+    for (int j{i + 1}; j < size; ++j) {
+      sum += lu.AtUnchecked(i, j) * x[j];
+    }
+    x[i] = -sum / lu.AtUnchecked(i, i);
+  }
+  w[last] = T{1};
+  for (int i{last - 1}; i >= 0; --i) {
+    for (int j{i + 1}; j < size; ++j) {
+      w[i] -= lu.AtUnchecked(j, i) * w[j];
+    }
+  }
+
+  T scale{static_cast<T>(sign)};
+  for (int i{0}; i < last; ++i) {
+    scale *= lu.AtUnchecked(i, i);
+  }
+  for (int j{0}; j < size; ++j) {
+    for (int i{0}; i < size; ++i) {
+      adjugate.AtUnchecked(col_permutation[j], row_permutation[i]) =
+          scale * x[j] * w[i];
+    }
+  }
+
+  return adjugate;
+}
+}  // namespace
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix()
+    : S21BasicMatrix{constants::kDefaultMatrixSize,
+                     constants::kDefaultMatrixSize} {}
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_{rows}, cols_{cols} {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_{rows}, cols_{cols} {
   if (rows_ <= 0 || cols_ <= 0) {
     throw std::invalid_argument{
-        "S21Matrix::S21Matrix(int, int): Matrix has improper dimensions. "
+        "S21BasicMatrix::S21BasicMatrix(int, int): Matrix has improper "
+        "dimensions. "
         "Rows and columns must be greater than zero."};
   }
 
   AllocateMemory();
+  std::fill_n(matrix_, ElementCount(), T{});
 }
 
-S21Matrix::S21Matrix(const S21Matrix& other)
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols,
+                                  std::pmr::memory_resource* resource)
+    : rows_{rows}, cols_{cols}, resource_{resource} {
+  if (rows_ <= 0 || cols_ <= 0) {
+    throw std::invalid_argument{
+        "S21BasicMatrix::S21BasicMatrix(int, int, memory_resource*): Matrix "
+        "has improper dimensions. "
+        "Rows and columns must be greater than zero."};
+  }
+
+  AllocateMemory();
+  std::fill_n(matrix_, ElementCount(), T{});
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other)
     : rows_{other.rows_}, cols_{other.cols_} {
+  S21_PROFILE_OPERATION(kCopy, other.ElementCount());
+  if (CanShare(other)) {
+    ShareStorage(other);
+    return;
+  }
+
+  AllocateMemory();
+  CopyElements(other);
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other,
+                                  std::pmr::memory_resource* resource)
+    : rows_{other.rows_}, cols_{other.cols_}, resource_{resource} {
+  S21_PROFILE_OPERATION(kCopy, other.ElementCount());
   AllocateMemory();
   CopyElements(other);
 }
 
-S21Matrix::S21Matrix(S21Matrix&& other) noexcept
-    : rows_{std::exchange(other.rows_, 0)},
-      cols_{std::exchange(other.cols_, 0)},
-      matrix_{std::exchange(other.matrix_, nullptr)} {}
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other) noexcept
+    : rows_{other.rows_}, cols_{other.cols_}, resource_{other.resource_} {
+  S21_PROFILE_OPERATION(kMove, other.ElementCount());
+  TakeStorage(other);
+}
 
-S21Matrix::~S21Matrix() { FreeMemory(); }
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(SubMatrixView<const T> view)
+    : rows_{view.GetRows()}, cols_{view.GetCols()} {
+  AllocateMemory();
+  StorageView().Assign(view);
+}
 
-[[nodiscard]] bool S21Matrix::EqMatrix(const S21Matrix& other) const {
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() { FreeMemory(); }
+
+template <typename T>
+[[nodiscard]] bool S21BasicMatrix<T>::EqMatrix(
+    const S21BasicMatrix& other) const {
+  return EqMatrix(other,
+                  {Tolerance::kAbsolute,
+                   static_cast<double>(ScalarTraits<T>::Precision())});
+}
+
+template <typename T>
+[[nodiscard]] bool S21BasicMatrix<T>::EqMatrix(
+    const S21BasicMatrix& other, const CompareOptions& options) const {
   if (rows_ != other.rows_ || cols_ != other.cols_) return false;
 
-  bool are_equal{true};
-  for (int i{0}; i < rows_ && are_equal; ++i) {
-    for (int j{0}; j < cols_ && are_equal; ++j) {
-      if (std::abs(matrix_[i][j] - other(i, j)) > constants::kPrecision)
-        are_equal = false;
-    }
+  const std::size_t size{ElementCount()};
+  return kernels::Compare(size, matrix_, other.matrix_, options, true)
+             .first_mismatch == size;
+}
+
+template <typename T>
+[[nodiscard]] Comparison S21BasicMatrix<T>::Compare(
+    const S21BasicMatrix& other, const CompareOptions& options) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument{
+        "S21BasicMatrix::Compare(const S21BasicMatrix&, const "
+        "CompareOptions&): Matrix dimensions are not compatible for "
+        "comparison. Both matrices must have the same number of rows and "
+        "columns."};
   }
 
-  return are_equal;
+  const std::size_t size{ElementCount()};
+  const kernels::ElementComparison elements{
+      kernels::Compare(size, matrix_, other.matrix_, options, false)};
+  Comparison comparison;
+  comparison.max_error = elements.max_error;
+  if (elements.first_mismatch != size) {
+    comparison.equal = false;
+    comparison.row = static_cast<int>(elements.first_mismatch / cols_);
+    comparison.column = static_cast<int>(elements.first_mismatch % cols_);
+  }
+
+  return comparison;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument{
-        "S21Matrix::SumMatrix(const S21Matrix&): Matrix dimensions are not "
-        "compatible for addition. "
+        "S21BasicMatrix::SumMatrix(const S21BasicMatrix&): Matrix dimensions "
+        "are not compatible for addition. "
         "Both matrices must have the same number of rows and columns."};
   }
 
-  for (int i{0}; i < rows_; ++i) {
-    for (int j{0}; j < cols_; ++j) {
-      matrix_[i][j] += other(i, j);
-    }
-  }
+  Detach();
+  kernels::Add(ElementCount(), other.matrix_, matrix_);
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument{
-        "S21Matrix::SubMatrix(const S21Matrix&): Matrix dimensions are not "
-        "compatible for addition. "
+        "S21BasicMatrix::SubMatrix(const S21BasicMatrix&): Matrix dimensions "
+        "are not compatible for addition. "
         "Both matrices must have the same number of rows and columns."};
   }
 
-  for (int i{0}; i < rows_; ++i) {
-    for (int j{0}; j < cols_; ++j) {
-      matrix_[i][j] -= other(i, j);
-    }
-  }
+  Detach();
+  kernels::Subtract(ElementCount(), other.matrix_, matrix_);
 }
 
-void S21Matrix::MulNumber(const double number) {
-  for (int i{0}; i < rows_; ++i) {
-    for (int j{0}; j < cols_; ++j) {
-      matrix_[i][j] *= number;
-    }
-  }
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T number) {
+  Detach();
+  kernels::Scale(ElementCount(), number, matrix_);
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other) {
+  MulMatrix(other, GetDefaultMulOptions());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other,
+                                  int num_threads) {
   if (cols_ != other.rows_) {
     throw std::invalid_argument{
-        "S21Matrix::MulMatrix(const S21Matrix&): Matrix dimensions are not "
-        "compatible for multiplication. "
+        "S21BasicMatrix::MulMatrix(const S21BasicMatrix&, int): Matrix "
+        "dimensions are not compatible for multiplication. "
         "Number of columns in the first matrix must be equal to the number of "
         "rows in the second matrix."};
   }
 
-  S21Matrix result{other.rows_, cols_};
-  for (int i{0}; i < rows_; ++i) {
-    for (int j{0}; j < other.cols_; ++j) {
-      double element{0.0};
-      for (int k{0}; k < other.rows_; ++k) {
-        element += matrix_[i][k] * other(k, j);
-      }
-      result(i, j) = element;
-    }
+  MulOptions options{GetDefaultMulOptions()};
+  if (num_threads > 0) options.num_threads = num_threads;
+  *this = Product(other, options);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other,
+                                  const MulOptions& options) {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument{
+        "S21BasicMatrix::MulMatrix(const S21BasicMatrix&, const MulOptions&): "
+        "Matrix dimensions are not compatible for multiplication. "
+        "Number of columns in the first matrix must be equal to the number of "
+        "rows in the second matrix."};
+  }
+  if (options.strassen_cutoff < 1 || options.num_threads < 0) {
+    throw std::invalid_argument{
+        "S21BasicMatrix::MulMatrix(const S21BasicMatrix&, const MulOptions&): "
+        "Options are out of range. "
+        "The Strassen cutoff must be positive and the thread count must not "
+        "be negative."};
   }
 
-  *this = result;
+  *this = Product(other, options);
 }
 
-[[nodiscard]] S21Matrix S21Matrix::Transpose() const {
-  S21Matrix transposed{cols_, rows_};
-
-  for (int i{0}; i < rows_; ++i) {
-    for (int j{0}; j < cols_; ++j) {
-      transposed(j, i) = matrix_[i][j];
-    }
-  }
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const {
+  S21BasicMatrix transposed{cols_, rows_};
+  kernels::Transpose(rows_, cols_, matrix_, stride(), transposed.matrix_,
+                     transposed.stride());
 
   return transposed;
 }
 
-[[nodiscard]] S21Matrix S21Matrix::CalcComplements() const {
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  Detach();
+  if (rows_ == cols_) {
+    kernels::TransposeInPlace(rows_, matrix_, stride());
+  } else {
+    kernels::TransposeInPlace(rows_, cols_, matrix_);
+    std::swap(rows_, cols_);
+  }
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() const {
   if (cols_ != rows_) {
     throw std::invalid_argument{
-        "S21Matrix::CalcComplements(): Matrix dimensions are not compatible "
-        "for complements calculation. "
+        "S21BasicMatrix::CalcComplements(): Matrix dimensions are not "
+        "compatible for complements calculation. "
         "The matrix must be square."};
   }
 
-  S21Matrix complements{rows_, cols_};
-  if (rows_ == 1) {
-    complements(0, 0) = 1;
+  S21_PROFILE_OPERATION(kCalcComplements, ElementCount());
+  if constexpr (std::is_integral_v<T>) {
+    // The complements of an integer matrix are integers; compute them in
+    // the factorization type and round.
+    const S21BasicMatrix<Factor> complements{
+        S21BasicMatrix<Factor>{*this}.CalcComplements()};
+    S21BasicMatrix rounded{rows_, cols_};
+    std::transform(complements.data(), complements.data() + ElementCount(),
+                   rounded.matrix_, [](Factor value) {
+                     return static_cast<T>(std::llround(value));
+                   });
+    return rounded;
   } else {
-    for (int row{0}; row < rows_; ++row) {
-      for (int column{0}; column < cols_; ++column) {
-        S21Matrix minor_matrix{GetMinorMatrix(row, column)};
-        complements(row, column) =
-            pow(-1, row + column) * minor_matrix.Determinant();
-      }
-    }
-  }
+    LUDecomposition<T> lu{*this};
+    if (lu.IsSingular()) return RankDeficientAdjugate(*this).Transpose();
 
-  return complements;
+    S21BasicMatrix complements{lu.Inverse().Transpose()};
+    complements.MulNumber(lu.Determinant());
+    return complements;
+  }
 }
 
-[[nodiscard]] double S21Matrix::Determinant() const {
+template <typename T>
+[[nodiscard]] T S21BasicMatrix<T>::Determinant() const {
   if (cols_ != rows_) {
     throw std::invalid_argument{
-        "S21Matrix::Determinant(): Matrix dimensions are not compatible for "
-        "determinant calculation. "
+        "S21BasicMatrix::Determinant(): Matrix dimensions are not compatible "
+        "for determinant calculation. "
         "The matrix must be square."};
   }
 
-  double determinant{0.0};
-
-  int matrix_size{rows_};
-  if (matrix_size == 1) {
-    determinant = matrix_[0][0];
-  } else if (matrix_size == 2) {
-    determinant += matrix_[0][0] * matrix_[1][1];
-    determinant -= matrix_[0][1] * matrix_[1][0];
+  S21_PROFILE_OPERATION(kDeterminant, ElementCount());
+  if constexpr (std::is_integral_v<T>) {
+    return BareissDeterminant(*this);
   } else {
-    for (int row{0}, column{0}; row < matrix_size; ++row) {
-      S21Matrix cofactor_matrix{GetMinorMatrix(row, column)};
-      double cofactor{cofactor_matrix.Determinant()};
-      cofactor *= std::pow(-1, row + column) * matrix_[row][column];
-      determinant += cofactor;
-    }
+    return LUDecompose().Determinant();
   }
-
-  return determinant;
 }
 
-[[nodiscard]] S21Matrix S21Matrix::InverseMatrix() const {
+template <typename T>
+[[nodiscard]] S21BasicMatrix<typename S21BasicMatrix<T>::Factor>
+S21BasicMatrix<T>::InverseMatrix() const {
   if (cols_ != rows_) {
     throw std::invalid_argument{
-        "S21Matrix::InverseMatrix(): Matrix dimensions are not compatible for "
-        "inverse matrix calculation. "
+        "S21BasicMatrix::InverseMatrix(): Matrix dimensions are not "
+        "compatible for inverse matrix calculation. "
         "The matrix must be square."};
   }
-  if (Determinant() == 0.0) {
+
+  S21_PROFILE_OPERATION(kInverseMatrix, ElementCount());
+  LUDecomposition<Factor> lu{LUDecompose()};
+  if (lu.IsSingular()) {
     throw std::runtime_error{
-        "S21Matrix::InverseMatrix(): Matrix is singular, and its inverse does "
-        "not exist. "
+        "S21BasicMatrix::InverseMatrix(): Matrix is singular, and its inverse "
+        "does not exist. "
         "The determinant of the matrix is zero."};
   }
 
-  S21Matrix inverse{rows_, cols_};
-  if (rows_ == 1) {
-    inverse(0, 0) = 1.0 / matrix_[0][0];
-  } else {
-    inverse = CalcComplements().Transpose();
-    inverse.MulNumber(1.0 / Determinant());
+  return lu.Inverse();
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<typename S21BasicMatrix<T>::Factor>
+S21BasicMatrix<T>::Solve(const S21BasicMatrix& b) const {
+  if (cols_ != rows_) {
+    throw std::invalid_argument{
+        "S21BasicMatrix::Solve(const S21BasicMatrix&): Matrix dimensions are "
+        "not compatible for solving a linear system. "
+        "The matrix must be square."};
+  }
+  if (b.rows_ != rows_) {
+    throw std::invalid_argument{
+        "S21BasicMatrix::Solve(const S21BasicMatrix&): Matrix dimensions are "
+        "not compatible for solving a linear system. "
+        "The right-hand side must have as many rows as the matrix."};
   }
 
-  return inverse;
-}
+  LUDecomposition<Factor> lu{LUDecompose()};
+  if (lu.IsSingular()) {
+    throw std::runtime_error{
+        "S21BasicMatrix::Solve(const S21BasicMatrix&): Matrix is singular, "
+        "and the system has no unique solution."};
+  }
 
-[[nodiscard]] S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
-  S21Matrix result{*this};
-  result.SumMatrix(other);
-  return result;
+  if constexpr (std::is_same_v<T, Factor>) {
+    return lu.Solve(b);
+  } else {
+    return lu.Solve(S21BasicMatrix<Factor>{b});
+  }
 }
 
-[[nodiscard]] S21Matrix S21Matrix::operator-(const S21Matrix& other) const {
-  S21Matrix result{*this};
-  result.SubMatrix(other);
-  return result;
+template <typename T>
+[[nodiscard]] MulErrorBound S21BasicMatrix<T>::EstimateMulError(
+    const S21BasicMatrix& other, const MulOptions& options) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument{
+        "S21BasicMatrix::EstimateMulError(const S21BasicMatrix&, const "
+        "MulOptions&): Matrix dimensions are not compatible for "
+        "multiplication. "
+        "Number of columns in the first matrix must be equal to the number of "
+        "rows in the second matrix."};
+  }
+
+  using Real = typename ScalarTraits<T>::Real;
+  MulErrorBound estimate{
+      options.algorithm,
+      options.algorithm == MulAlgorithm::kStrassenWinograd
+          ? kernels::StrassenLevels(rows_, other.cols_, cols_,
+                                    options.strassen_cutoff)
+          : 0,
+      0.0, 0.0};
+  if constexpr (!std::is_integral_v<T>) {
+    const auto max_magnitude{[](const S21BasicMatrix& matrix) {
+      Real magnitude{0};
+      for (std::size_t i{0}; i < matrix.ElementCount(); ++i) {
+        magnitude = std::max(magnitude, Real{std::abs(matrix.matrix_[i])});
+      }
+      return static_cast<double>(magnitude);
+    }};
+    estimate.growth = MulErrorGrowth(rows_, other.cols_, cols_, options);
+    if constexpr (!std::is_same_v<T, Real>) estimate.growth *= 2.0;
+    estimate.bound = estimate.growth *
+                     static_cast<double>(std::numeric_limits<Real>::epsilon() /
+                                         2) *
+                     max_magnitude(*this) * max_magnitude(other);
+  }
+
+  return estimate;
 }
 
-[[nodiscard]] S21Matrix S21Matrix::operator*(const S21Matrix& other) const {
-  S21Matrix result{*this};
-  result.MulMatrix(other);
-  return result;
+template <typename T>
+[[nodiscard]] LUDecomposition<typename S21BasicMatrix<T>::Factor>
+S21BasicMatrix<T>::LUDecompose() const {
+  return LUDecompose(ScalarTraits<Factor>::PivotTolerance(rows_));
 }
 
-[[nodiscard]] S21Matrix S21Matrix::operator*(const double number) const {
-  S21Matrix result{*this};
-  result.MulNumber(number);
-  return result;
+template <typename T>
+[[nodiscard]] LUDecomposition<typename S21BasicMatrix<T>::Factor>
+S21BasicMatrix<T>::LUDecompose(double tolerance) const {
+  if constexpr (std::is_same_v<T, Factor>) {
+    return LUDecomposition<Factor>{*this, tolerance};
+  } else {
+    return LUDecomposition<Factor>{S21BasicMatrix<Factor>{*this}, tolerance};
+  }
 }
 
-S21Matrix operator*(const double number, S21Matrix& matrix) {
-  matrix.MulNumber(number);
-  return matrix;
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix& other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument{
+        "S21BasicMatrix::operator*(const S21BasicMatrix&): Matrix dimensions "
+        "are not compatible for multiplication. "
+        "Number of columns in the first matrix must be equal to the number of "
+        "rows in the second matrix."};
+  }
+
+  return Product(other, GetDefaultMulOptions());
 }
 
-[[nodiscard]] bool S21Matrix::operator==(const S21Matrix& other) const {
+template <typename T>
+[[nodiscard]] bool S21BasicMatrix<T>::operator==(
+    const S21BasicMatrix& other) const {
   return EqMatrix(other);
 }
 
-S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21BasicMatrix& other) {
   if (this == &other) return *this;
 
-  FreeMemory();
-  rows_ = other.rows_;
-  cols_ = other.cols_;
-  AllocateMemory();
+  S21_PROFILE_OPERATION(kCopy, other.ElementCount());
+  if (CanShare(other)) {
+    FreeMemory();
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    ShareStorage(other);
+    return *this;
+  }
+
+  if (ElementCount() != other.ElementCount() || IsShared()) {
+    FreeMemory();
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    AllocateMemory();
+  } else {
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+  }
   CopyElements(other);
 
   return *this;
 }
 
-S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(S21BasicMatrix&& other) {
   if (this == &other) return *this;
+  // Storage is only adopted from the resource this matrix frees into.
+  if (resource_ != other.resource_) {
+    return *this = static_cast<const S21BasicMatrix&>(other);
+  }
 
+  S21_PROFILE_OPERATION(kMove, other.ElementCount());
   FreeMemory();
-  rows_ = std::exchange(other.rows_, 0);
-  cols_ = std::exchange(other.cols_, 0);
-  matrix_ = std::exchange(other.matrix_, nullptr);
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  TakeStorage(other);
 
   return *this;
 }
 
-S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21BasicMatrix& other) {
   SumMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21BasicMatrix& other) {
   SubMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const S21BasicMatrix& other) {
   MulMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const double number) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const T number) {
   MulNumber(number);
   return *this;
 }
 
-[[nodiscard]] double& S21Matrix::operator()(int row, int column) {
+template <typename T>
+[[nodiscard]] T& S21BasicMatrix<T>::operator()(int row, int column) {
   if (row < 0 || column < 0 || row >= rows_ || column >= cols_) {
     throw std::out_of_range{
-        "S21Matrix::operator()(int, int): Index out of range. "
+        "S21BasicMatrix::operator()(int, int): Index out of range. "
         "Row and column indices must be non-negative and within the matrix "
         "dimensions."};
   }
 
-  return matrix_[row][column];
+  Detach();
+  return matrix_[static_cast<std::size_t>(row) * cols_ + column];
 }
 
-[[nodiscard]] const double& S21Matrix::operator()(int row, int column) const {
+template <typename T>
+[[nodiscard]] const T& S21BasicMatrix<T>::operator()(int row,
+                                                     int column) const {
   if (row < 0 || column < 0 || row >= rows_ || column >= cols_) {
     throw std::out_of_range{
-        "S21Matrix::operator()(int, int) const: Index out of range. "
+        "S21BasicMatrix::operator()(int, int) const: Index out of range. "
         "Row and column indices must be non-negative and within the matrix "
         "dimensions."};
   }
 
-  return matrix_[row][column];
+  return matrix_[static_cast<std::size_t>(row) * cols_ + column];
+}
+
+template <typename T>
+[[nodiscard]] RowView<T> S21BasicMatrix<T>::Row(int row) {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range{
+        "S21BasicMatrix::Row(int): Index out of range. "
+        "Row index must be non-negative and less than the number of rows."};
+  }
+
+  return View().Row(row);
+}
+
+template <typename T>
+[[nodiscard]] RowView<const T> S21BasicMatrix<T>::Row(int row) const {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range{
+        "S21BasicMatrix::Row(int) const: Index out of range. "
+        "Row index must be non-negative and less than the number of rows."};
+  }
+
+  return View().Row(row);
+}
+
+template <typename T>
+[[nodiscard]] ColView<T> S21BasicMatrix<T>::Col(int column) {
+  if (column < 0 || column >= cols_) {
+    throw std::out_of_range{
+        "S21BasicMatrix::Col(int): Index out of range. "
+        "Column index must be non-negative and less than the number of "
+        "columns."};
+  }
+
+  return View().Col(column);
+}
+
+template <typename T>
+[[nodiscard]] ColView<const T> S21BasicMatrix<T>::Col(int column) const {
+  if (column < 0 || column >= cols_) {
+    throw std::out_of_range{
+        "S21BasicMatrix::Col(int) const: Index out of range. "
+        "Column index must be non-negative and less than the number of "
+        "columns."};
+  }
+
+  return View().Col(column);
+}
+
+template <typename T>
+[[nodiscard]] SubMatrixView<T> S21BasicMatrix<T>::Block(int row, int column,
+                                                       int rows, int cols) {
+  return View().Block(row, column, rows, cols);
+}
+
+template <typename T>
+[[nodiscard]] SubMatrixView<const T> S21BasicMatrix<T>::Block(
+    int row, int column, int rows, int cols) const {
+  return View().Block(row, column, rows, cols);
 }
 
-[[nodiscard]] int S21Matrix::GetCols() const { return cols_; }
+template <typename T>
+[[nodiscard]] SubMatrixView<T> S21BasicMatrix<T>::View() {
+  Detach();
+  shareable_ = false;
+  return StorageView();
+}
+
+template <typename T>
+[[nodiscard]] SubMatrixView<const T> S21BasicMatrix<T>::View() const noexcept {
+  return {matrix_, rows_, cols_, stride()};
+}
+
+template <typename T>
+[[nodiscard]] int S21BasicMatrix<T>::GetCols() const { return cols_; }
+
+template <typename T>
+[[nodiscard]] int S21BasicMatrix<T>::GetRows() const { return rows_; }
+
+template <typename T>
+[[nodiscard]] T* S21BasicMatrix<T>::data() {
+  Detach();
+  return matrix_;
+}
+
+template <typename T>
+[[nodiscard]] const T* S21BasicMatrix<T>::data() const noexcept {
+  return matrix_;
+}
 
-[[nodiscard]] int S21Matrix::GetRows() const { return rows_; }
+template <typename T>
+[[nodiscard]] int S21BasicMatrix<T>::stride() const noexcept { return cols_; }
 
-void S21Matrix::SetRows(int new_rows) {
+template <typename T>
+[[nodiscard]] std::pmr::memory_resource* S21BasicMatrix<T>::GetResource()
+    const noexcept {
+  return resource_;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int new_rows) {
   if (new_rows <= 0) {
     throw std::out_of_range{
-        "S21Matrix::SetRows(int): New number of rows is out of range. "
+        "S21BasicMatrix::SetRows(int): New number of rows is out of range. "
         "It must be a positive integer."};
   }
   if (new_rows == rows_) return;
@@ -309,10 +745,11 @@ void S21Matrix::SetRows(int new_rows) {
   ChangeSize(new_rows, cols_);
 }
 
-void S21Matrix::SetCols(int new_cols) {
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int new_cols) {
   if (new_cols <= 0) {
     throw std::out_of_range{
-        "S21Matrix::SetCols(int): New number of columns is out of range. "
+        "S21BasicMatrix::SetCols(int): New number of columns is out of range. "
         "It must be a positive integer."};
   }
   if (new_cols == cols_) return;
@@ -320,64 +757,378 @@ void S21Matrix::SetCols(int new_cols) {
   ChangeSize(rows_, new_cols);
 }
 
-void S21Matrix::ChangeSize(int new_rows, int new_cols) {
-  S21Matrix result{new_rows, new_cols};
+template <typename T>
+void S21BasicMatrix<T>::ChangeSize(int new_rows, int new_cols) {
+  S21_PROFILE_OPERATION(kChangeSize, ElementCount());
+  S21BasicMatrix result{new_rows, new_cols, resource_};
   int number_of_rows_to_copy{std::min(new_rows, rows_)};
   int number_of_cols_to_copy{std::min(new_cols, cols_)};
-  for (int i{0}; i < number_of_rows_to_copy; ++i) {
-    for (int j{0}; j < number_of_cols_to_copy; ++j) {
-      result(i, j) = matrix_[i][j];
+  result.StorageView()
+      .Block(0, 0, number_of_rows_to_copy, number_of_cols_to_copy)
+      .Assign(std::as_const(*this).Block(0, 0, number_of_rows_to_copy,
+                                         number_of_cols_to_copy));
+
+  *this = std::move(result);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Product(
+    const S21BasicMatrix& other, const MulOptions& options) const {
+  S21_PROFILE_OPERATION(kMulMatrix, ElementCount() + other.ElementCount());
+  S21BasicMatrix result{rows_, other.cols_};
+  const int num_threads{options.num_threads > 0 ? options.num_threads
+                                                : GetNumThreads()};
+  if (options.algorithm == MulAlgorithm::kStrassenWinograd) {
+    kernels::StrassenGemm(rows_, other.cols_, cols_, matrix_, stride(),
+                          other.matrix_, other.stride(), result.matrix_,
+                          result.stride(), options.strassen_cutoff,
+                          num_threads);
+  } else {
+    kernels::Gemm(rows_, other.cols_, cols_, matrix_, stride(), other.matrix_,
+                  other.stride(), result.matrix_, result.stride(),
+                  num_threads);
+  }
+
+  return result;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::AllocateMemory() {
+  if (ElementCount() <= kInlineCapacity) {
+    matrix_ = reinterpret_cast<T*>(inline_storage_);
+    return;
+  }
+
+  S21_PROFILE_ALLOCATION(ElementCount() * sizeof(T));
+  matrix_ = static_cast<T*>(resource_->allocate(ElementCount() * sizeof(T),
+                                                kMatrixStorageAlignment));
+  references_.store(nullptr, std::memory_order_relaxed);
+  shareable_ = true;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::FreeMemory() {
+  if (IsInline()) {
+    matrix_ = nullptr;
+  } else if (matrix_) {
+    ReleaseStorage(matrix_, references_.load(std::memory_order_relaxed));
+    matrix_ = nullptr;
+    references_.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+// Frees heap storage of ElementCount() elements unless other matrices
+// still share it.
+template <typename T>
+void S21BasicMatrix<T>::ReleaseStorage(T* storage,
+                                       ReferenceCount* references) noexcept {
+  if (references != nullptr &&
+      references->fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+
+  resource_->deallocate(storage, ElementCount() * sizeof(T),
+                        kMatrixStorageAlignment);
+  if (references != nullptr) {
+    resource_->deallocate(references, sizeof(ReferenceCount),
+                          alignof(ReferenceCount));
+  }
+}
+
+// Expects rows_ and cols_ to match other's; leaves other empty.
+template <typename T>
+void S21BasicMatrix<T>::TakeStorage(S21BasicMatrix& other) noexcept {
+  if (other.IsInline()) {
+    matrix_ = reinterpret_cast<T*>(inline_storage_);
+    CopyElements(other);
+  } else {
+    matrix_ = other.matrix_;
+    references_.store(other.references_.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+    shareable_ = other.shareable_;
+    other.references_.store(nullptr, std::memory_order_relaxed);
+  }
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.matrix_ = nullptr;
+}
+
+template <typename T>
+[[nodiscard]] bool S21BasicMatrix<T>::IsInline() const noexcept {
+  return matrix_ == reinterpret_cast<const T*>(inline_storage_);
+}
+
+template <typename T>
+[[nodiscard]] bool S21BasicMatrix<T>::CanShare(
+    const S21BasicMatrix& other) const noexcept {
+  return other.matrix_ != nullptr && !other.IsInline() && other.shareable_ &&
+         other.resource_ == resource_;
+}
+
+// Expects rows_ and cols_ to match other's and no storage of its own.
+template <typename T>
+void S21BasicMatrix<T>::ShareStorage(const S21BasicMatrix& other) {
+  ReferenceCount* references{
+      other.references_.load(std::memory_order_acquire)};
+  if (references == nullptr) {
+    auto* created{new (resource_->allocate(sizeof(ReferenceCount),
+                                           alignof(ReferenceCount)))
+                      ReferenceCount{1}};
+    if (other.references_.compare_exchange_strong(
+            references, created, std::memory_order_acq_rel,
+            std::memory_order_acquire)) {
+      references = created;
+    } else {
+      resource_->deallocate(created, sizeof(ReferenceCount),
+                            alignof(ReferenceCount));
     }
   }
 
-  *this = result;
+  references->fetch_add(1, std::memory_order_relaxed);
+  references_.store(references, std::memory_order_relaxed);
+  matrix_ = other.matrix_;
+  shareable_ = true;
+}
+
+template <typename T>
+[[nodiscard]] bool S21BasicMatrix<T>::IsShared() const noexcept {
+  const ReferenceCount* references{
+      references_.load(std::memory_order_acquire)};
+  return references != nullptr &&
+         references->load(std::memory_order_acquire) > 1;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Unshare() {
+  ReferenceCount* references{references_.load(std::memory_order_relaxed)};
+  if (references->load(std::memory_order_acquire) == 1) {
+    // The other owners are gone; the storage is ours again.
+    resource_->deallocate(references, sizeof(ReferenceCount),
+                          alignof(ReferenceCount));
+    references_.store(nullptr, std::memory_order_relaxed);
+    return;
+  }
+
+  T* const shared{matrix_};
+  AllocateMemory();
+  std::copy_n(shared, ElementCount(), matrix_);
+  ReleaseStorage(shared, references);
+}
+
+template <typename T>
+[[nodiscard]] SubMatrixView<T> S21BasicMatrix<T>::StorageView() noexcept {
+  return {matrix_, rows_, cols_, stride()};
 }
 
-S21Matrix S21Matrix::GetMinorMatrix(int removed_row, int removed_col) const {
-  S21Matrix minor_matrix{rows_ - 1, cols_ - 1};
-  int minor_matrix_row{0};
-  for (int row{0}; row < rows_; ++row) {
-    int minor_matrix_column{0};
-    for (int column{0}; column < cols_; ++column) {
-      if (row != removed_row && column != removed_col) {
-        minor_matrix(minor_matrix_row, minor_matrix_column++) =
-            matrix_[row][column];
+template <typename T>
+void S21BasicMatrix<T>::CopyElements(const S21BasicMatrix& other) {
+  std::copy_n(other.matrix_, ElementCount(), matrix_);
+}
+
+template <typename T>
+std::size_t S21BasicMatrix<T>::ElementCount() const noexcept {
+  return static_cast<std::size_t>(rows_) * static_cast<std::size_t>(cols_);
+}
+
+template <typename T>
+LUDecomposition<T>::LUDecomposition(const S21BasicMatrix<T>& matrix)
+    : LUDecomposition{matrix, static_cast<double>(
+                                  ScalarTraits<T>::PivotTolerance(
+                                      matrix.GetRows()))} {}
+
+template <typename T>
+LUDecomposition<T>::LUDecomposition(const S21BasicMatrix<T>& matrix,
+                                    double tolerance)
+    : lu_{matrix}, permutation_(static_cast<std::size_t>(matrix.GetRows())) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::invalid_argument{
+        "LUDecomposition::LUDecomposition(const S21BasicMatrix&): Matrix "
+        "dimensions are not compatible for LU decomposition. "
+        "The matrix must be square."};
+  }
+
+  const int size{lu_.GetRows()};
+  const std::ptrdiff_t stride{lu_.stride()};
+  T* data{lu_.data()};
+  std::iota(permutation_.begin(), permutation_.end(), 0);
+
+  // Largest element of every row, swapped along with the rows.
+  using Real = typename ScalarTraits<T>::Real;
+  std::vector<Real> thresholds(static_cast<std::size_t>(size));
+  for (int i{0}; i < size; ++i) {
+    for (int j{0}; j < size; ++j) {
+      thresholds[i] = std::max(thresholds[i], std::abs(data[i * stride + j]));
+    }
+    thresholds[i] *= static_cast<Real>(tolerance);
+  }
+
+  for (int k{0}; k < size; ++k) {
+    int pivot_row{k};
+    for (int i{k + 1}; i < size; ++i) {
+      if (std::abs(data[i * stride + k]) >
+          std::abs(data[pivot_row * stride + k])) {
+        pivot_row = i;
+      }
+    }
+
+    T* pivot{data + k * stride};
+    if (pivot_row != k) {
+      std::swap_ranges(pivot, pivot + size, data + pivot_row * stride);
+      std::swap(permutation_[k], permutation_[pivot_row]);
+      std::swap(thresholds[k], thresholds[pivot_row]);
+      sign_ = -sign_;
+    }
+    if (std::abs(pivot[k]) <= thresholds[k]) singular_ = true;
+    if (pivot[k] == T{}) continue;
+
+    for (int i{k + 1}; i < size; ++i) {
+      T* row{data + i * stride};
+      const T factor{row[k] / pivot[k]};
+      row[k] = factor;
+      if (factor == T{}) continue;
+      for (int j{k + 1}; j < size; ++j) {
+        row[j] -= factor * pivot[j];
       }
     }
-    if (row != removed_row) ++minor_matrix_row;
+  }
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> LUDecomposition<T>::GetL() const {
+  const int size{lu_.GetRows()};
+  S21BasicMatrix<T> lower{size, size};
+  for (int i{0}; i < size; ++i) {
+    std::copy_n(lu_.data() + i * lu_.stride(), i,
+                lower.data() + i * lower.stride());
+    lower.AtUnchecked(i, i) = T{1};
+  }
+
+  return lower;
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> LUDecomposition<T>::GetU() const {
+  const int size{lu_.GetRows()};
+  S21BasicMatrix<T> upper{size, size};
+  for (int i{0}; i < size; ++i) {
+    std::copy(lu_.data() + i * lu_.stride() + i,
+              lu_.data() + i * lu_.stride() + size,
+              upper.data() + i * upper.stride() + i);
+  }
+
+  return upper;
+}
+
+template <typename T>
+[[nodiscard]] const std::vector<int>& LUDecomposition<T>::GetPermutation()
+    const {
+  return permutation_;
+}
+
+template <typename T>
+[[nodiscard]] int LUDecomposition<T>::GetSign() const { return sign_; }
+
+template <typename T>
+[[nodiscard]] bool LUDecomposition<T>::IsSingular() const { return singular_; }
+
+template <typename T>
+[[nodiscard]] T LUDecomposition<T>::Determinant() const {
+  if (singular_) return T{};
+
+  T determinant{static_cast<T>(sign_)};
+  for (int i{0}; i < lu_.GetRows(); ++i) {
+    determinant *= lu_.AtUnchecked(i, i);
+  }
+
+  return determinant;
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> LUDecomposition<T>::Solve(
+    const S21BasicMatrix<T>& b) const {
+  const int size{lu_.GetRows()};
+  if (b.GetRows() != size) {
+    throw std::invalid_argument{
+        "LUDecomposition::Solve(const S21BasicMatrix&): Matrix dimensions are "
+        "not compatible for solving. "
+        "The right-hand side must have as many rows as the factorized "
+        "matrix."};
+  }
+  if (singular_) {
+    throw std::runtime_error{
+        "LUDecomposition::Solve(const S21BasicMatrix&): Matrix is singular, "
+        "and the system has no unique solution."};
   }
 
-  return minor_matrix;
+  const int cols{b.GetCols()};
+  S21BasicMatrix<T> x{size, cols};
+  for (int i{0}; i < size; ++i) {
+    std::copy_n(b.data() + permutation_[i] * std::ptrdiff_t{b.stride()}, cols,
+                x.data() + i * std::ptrdiff_t{x.stride()});
+  }
+  Substitute(x);
+
+  return x;
 }
 
-void S21Matrix::AllocateMemory() {
-  matrix_ = new double* [static_cast<std::size_t>(rows_)] {};
-  for (int i{0}; i < rows_; ++i) {
-    matrix_[i] = new double[static_cast<std::size_t>(cols_)]{};
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> LUDecomposition<T>::Inverse() const {
+  if (singular_) {
+    throw std::runtime_error{
+        "LUDecomposition::Inverse(): Matrix is singular, and its inverse does "
+        "not exist."};
   }
+
+  const int size{lu_.GetRows()};
+  S21BasicMatrix<T> inverse{size, size};
+  for (int i{0}; i < size; ++i) {
+    inverse.AtUnchecked(i, permutation_[i]) = T{1};
+  }
+  Substitute(inverse);
+
+  return inverse;
 }
 
-void S21Matrix::FreeMemory() {
-  if (matrix_) {
-    for (int i{0}; i < rows_; ++i) {
-      if (matrix_[i]) {
-        delete[] matrix_[i];
+template <typename T>
+void LUDecomposition<T>::Substitute(S21BasicMatrix<T>& x) const {
+  const int size{lu_.GetRows()};
+  const int cols{x.GetCols()};
+  T* solution{x.data()};
+  const std::ptrdiff_t x_stride{x.stride()};
+  const T* lu{lu_.data()};
+  const std::ptrdiff_t lu_stride{lu_.stride()};
+
+  for (int i{0}; i < size; ++i) {
+    T* row{solution + i * x_stride};
+    for (int j{0}; j < i; ++j) {
+      const T factor{lu[i * lu_stride + j]};
+      if (factor == T{}) continue;
+      const T* other{solution + j * x_stride};
+      for (int column{0}; column < cols; ++column) {
+        row[column] -= factor * other[column];
       }
     }
-    delete[] matrix_;
-    matrix_ = nullptr;
   }
-}
 
-void S21Matrix::CopyElements(const S21Matrix& other) {
-  for (int i{0}; i < rows_; ++i) {
-    for (int j{0}; j < cols_; ++j) {
-      matrix_[i][j] = other(i, j);
+  for (int i{size - 1}; i >= 0; --i) {
+    T* row{solution + i * x_stride};
+    for (int j{i + 1}; j < size; ++j) {
+      const T factor{lu[i * lu_stride + j]};
+      if (factor == T{}) continue;
+      const T* other{solution + j * x_stride};
+      for (int column{0}; column < cols; ++column) {
+        row[column] -= factor * other[column];
+      }
+    }
+    const T diagonal{lu[i * lu_stride + i]};
+    for (int column{0}; column < cols; ++column) {
+      row[column] /= diagonal;
     }
   }
 }
 
-std::ostream& operator<<(std::ostream& out, const S21Matrix& matrix) {
+template <typename T>
+std::ostream& operator<<(std::ostream& out, const S21BasicMatrix<T>& matrix) {
   for (int i{0}; i < matrix.GetRows(); ++i) {
     for (int j{0}; j < matrix.GetCols(); ++j) {
       out << matrix(i, j) << ' ';
@@ -387,4 +1138,33 @@ std::ostream& operator<<(std::ostream& out, const S21Matrix& matrix) {
 
   return out;
 }
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
+template class S21BasicMatrix<std::int32_t>;
+template class S21BasicMatrix<std::int64_t>;
+template class S21BasicMatrix<std::complex<float>>;
+template class S21BasicMatrix<std::complex<double>>;
+
+template class LUDecomposition<float>;
+template class LUDecomposition<double>;
+template class LUDecomposition<long double>;
+template class LUDecomposition<std::complex<float>>;
+template class LUDecomposition<std::complex<double>>;
+
+template std::ostream& operator<<(std::ostream&,
+                                  const S21BasicMatrix<float>&);
+template std::ostream& operator<<(std::ostream&,
+                                  const S21BasicMatrix<double>&);
+template std::ostream& operator<<(std::ostream&,
+                                  const S21BasicMatrix<long double>&);
+template std::ostream& operator<<(std::ostream&,
+                                  const S21BasicMatrix<std::int32_t>&);
+template std::ostream& operator<<(std::ostream&,
+                                  const S21BasicMatrix<std::int64_t>&);
+template std::ostream& operator<<(std::ostream&,
+                                  const S21BasicMatrix<std::complex<float>>&);
+template std::ostream& operator<<(std::ostream&,
+                                  const S21BasicMatrix<std::complex<double>>&);
 }  // namespace s21
@@ -1,67 +1,357 @@
 #ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_OOP_H_
 #define CPP1_S21_MATRIXPLUS_S21_MATRIX_OOP_H_
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <memory_resource>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "s21_matrix_compare.h"
+#include "s21_matrix_expression.h"
+#include "s21_matrix_io.h"
+#include "s21_matrix_memory.h"
+#include "s21_matrix_mul.h"
+#include "s21_matrix_traits.h"
+#include "s21_matrix_view.h"
+#include "s21_thread_pool.h"
 
 namespace s21 {
-class S21Matrix {
+template <typename T>
+class LUDecomposition;
+
+// Dense row-major matrix of T. Instantiated for float, double, long double,
+// std::int32_t, std::int64_t, std::complex<float> and std::complex<double>.
+// Factorizations of integer matrices, and the inverses and solutions
+// derived from them, are computed in double. Storage comes from a
+// std::pmr::memory_resource: the one passed to the constructor, otherwise
+// the thread's GetDefaultMatrixResource(). Like std::pmr containers, copies
+// use the default resource, move construction carries the resource along
+// and move assignment keeps the resource of the target, copying the
+// elements when the two resources differ. Matrices of at most
+// kInlineCapacity elements are stored inside the object and never touch the
+// resource; moving such a matrix copies its elements.
+//
+// Larger matrices share storage on copy when both use the same resource,
+// and any non-const member gives the matrix storage of its own before it
+// writes (copy-on-write). Copying a matrix therefore invalidates element
+// pointers and references taken from its non-const data, operator() and
+// AtUnchecked; take them after the copy. A matrix that handed out a view
+// through Row, Col, Block or View is copied deeply until its storage is
+// replaced, so views never write into a copy.
+template <typename T>
+class S21BasicMatrix : public MatrixExpression<S21BasicMatrix<T>> {
  public:
-  S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix& other);
-  S21Matrix(S21Matrix&& other) noexcept;
-  ~S21Matrix();
-
-  [[nodiscard]] bool EqMatrix(const S21Matrix& other) const;
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double number);
-  void MulMatrix(const S21Matrix& other);
-  [[nodiscard]] S21Matrix Transpose() const;
-  [[nodiscard]] S21Matrix CalcComplements() const;
-  [[nodiscard]] double Determinant() const;
-  [[nodiscard]] S21Matrix InverseMatrix() const;
-
-  [[nodiscard]] S21Matrix operator+(const S21Matrix& other) const;
-  [[nodiscard]] S21Matrix operator-(const S21Matrix& other) const;
-  [[nodiscard]] S21Matrix operator*(const S21Matrix& other) const;
-  [[nodiscard]] S21Matrix operator*(const double number) const;
-  [[nodiscard]] bool operator==(const S21Matrix& other) const;
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix& operator=(S21Matrix&& other) noexcept;
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix& operator*=(const S21Matrix& other);
-  S21Matrix& operator*=(const double number);
-  [[nodiscard]] double& operator()(int row, int column);
-  [[nodiscard]] const double& operator()(int row, int column) const;
+  using value_type = T;
+  using Factor = typename ScalarTraits<T>::Factor;
+
+  static constexpr std::size_t kInlineCapacity{128 / sizeof(T)};
+
+  S21BasicMatrix();
+  S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(int rows, int cols, std::pmr::memory_resource* resource);
+  S21BasicMatrix(const S21BasicMatrix& other);
+  S21BasicMatrix(const S21BasicMatrix& other,
+                 std::pmr::memory_resource* resource);
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  template <typename Expression>
+  S21BasicMatrix(const MatrixExpression<Expression>& expression);
+  // Takes over the storage of a temporary operand when there is one.
+  template <typename Expression>
+  S21BasicMatrix(MatrixExpression<Expression>&& expression);
+  explicit S21BasicMatrix(SubMatrixView<const T> view);
+  // Converts every element with static_cast.
+  template <typename Other>
+  explicit S21BasicMatrix(const S21BasicMatrix<Other>& other);
+  ~S21BasicMatrix();
+
+  // Absolute differences up to ScalarTraits<T>::Precision() count as equal.
+  [[nodiscard]] bool EqMatrix(const S21BasicMatrix& other) const;
+  [[nodiscard]] bool EqMatrix(const S21BasicMatrix& other,
+                              const CompareOptions& options) const;
+  // Unlike EqMatrix, reads every element to find the largest error. Throws
+  // std::invalid_argument for matrices of different sizes.
+  [[nodiscard]] Comparison Compare(const S21BasicMatrix& other,
+                                   const CompareOptions& options) const;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void MulNumber(const T number);
+  void MulMatrix(const S21BasicMatrix& other);
+  // A num_threads of zero or less keeps the default of GetDefaultMulOptions().
+  void MulMatrix(const S21BasicMatrix& other, int num_threads);
+  void MulMatrix(const S21BasicMatrix& other, const MulOptions& options);
+  [[nodiscard]] S21BasicMatrix Transpose() const;
+  void TransposeInPlace();
+  [[nodiscard]] S21BasicMatrix CalcComplements() const;
+  [[nodiscard]] T Determinant() const;
+  [[nodiscard]] S21BasicMatrix<Factor> InverseMatrix() const;
+  [[nodiscard]] LUDecomposition<Factor> LUDecompose() const;
+  [[nodiscard]] LUDecomposition<Factor> LUDecompose(double tolerance) const;
+  [[nodiscard]] S21BasicMatrix<Factor> Solve(const S21BasicMatrix& b) const;
+  // Error bound of the product with other under options.
+  [[nodiscard]] MulErrorBound EstimateMulError(
+      const S21BasicMatrix& other,
+      const MulOptions& options = GetDefaultMulOptions()) const;
+
+  [[nodiscard]] S21BasicMatrix operator*(const S21BasicMatrix& other) const;
+  [[nodiscard]] bool operator==(const S21BasicMatrix& other) const;
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other);
+  template <typename Expression>
+  S21BasicMatrix& operator=(const MatrixExpression<Expression>& expression);
+  template <typename Expression>
+  S21BasicMatrix& operator=(MatrixExpression<Expression>&& expression);
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const T number);
+  [[nodiscard]] T& operator()(int row, int column);
+  [[nodiscard]] const T& operator()(int row, int column) const;
+
+  // Element access without bounds checks outside of debug builds.
+  [[nodiscard]] T& AtUnchecked(int row, int column);
+  [[nodiscard]] const T& AtUnchecked(int row, int column) const noexcept;
+
+  [[nodiscard]] RowView<T> Row(int row);
+  [[nodiscard]] RowView<const T> Row(int row) const;
+  [[nodiscard]] ColView<T> Col(int column);
+  [[nodiscard]] ColView<const T> Col(int column) const;
+  [[nodiscard]] SubMatrixView<T> Block(int row, int column, int rows,
+                                       int cols);
+  [[nodiscard]] SubMatrixView<const T> Block(int row, int column, int rows,
+                                             int cols) const;
+  [[nodiscard]] SubMatrixView<T> View();
+  [[nodiscard]] SubMatrixView<const T> View() const noexcept;
 
   [[nodiscard]] int GetCols() const;
   [[nodiscard]] int GetRows() const;
 
+  [[nodiscard]] T* data();
+  [[nodiscard]] const T* data() const noexcept;
+  [[nodiscard]] int stride() const noexcept;
+  [[nodiscard]] T Element(std::size_t index) const noexcept;
+  [[nodiscard]] std::pmr::memory_resource* GetResource() const noexcept;
+
   void SetRows(int new_rows);
   void SetCols(int new_cols);
 
+  // Binary matrix files, described in s21_matrix_io.h.
+  void Save(const std::string& path) const;
+  [[nodiscard]] static S21BasicMatrix Load(const std::string& path);
+  [[nodiscard]] static MappedMatrix<T> MapFile(
+      const std::string& path, MapMode mode = MapMode::kReadOnly);
+
  private:
   void ChangeSize(int rows, int cols);
+  [[nodiscard]] S21BasicMatrix Product(const S21BasicMatrix& other,
+                                       const MulOptions& options) const;
 
-  S21Matrix GetMinorMatrix(int removed_row, int removed_col) const;
+  using ReferenceCount = std::atomic<long>;
 
   void AllocateMemory();
   void FreeMemory();
-  void CopyElements(const S21Matrix& other);
+  void ReleaseStorage(T* storage, ReferenceCount* references) noexcept;
+  void TakeStorage(S21BasicMatrix& other) noexcept;
+  [[nodiscard]] bool IsInline() const noexcept;
+  [[nodiscard]] bool CanShare(const S21BasicMatrix& other) const noexcept;
+  void ShareStorage(const S21BasicMatrix& other);
+  [[nodiscard]] bool IsShared() const noexcept;
+  // Copies shared storage before a write.
+  void Detach();
+  void Unshare();
+  [[nodiscard]] SubMatrixView<T> StorageView() noexcept;
+  void CopyElements(const S21BasicMatrix& other);
+  template <typename Expression>
+  void EvaluateElements(const Expression& expression);
+  [[nodiscard]] std::size_t ElementCount() const noexcept;
 
  private:
   int rows_{};
   int cols_{};
-  double** matrix_{};
+  T* matrix_{};
+  std::pmr::memory_resource* resource_{GetDefaultMatrixResource()};
+  // Allocated from resource_ when heap storage is first shared. Copies of a
+  // const matrix may create it concurrently, hence atomic.
+  mutable std::atomic<ReferenceCount*> references_{nullptr};
+  // False once a mutable view was handed out.
+  bool shareable_{true};
+  alignas(kMatrixStorageAlignment) std::byte
+      inline_storage_[kInlineCapacity * sizeof(T)];
+};
+
+using S21Matrix = S21BasicMatrix<double>;
+
+// Partial-pivoting factorization PA = LU of a square matrix. L has a unit
+// diagonal and is stored together with U in a single matrix. The matrix is
+// singular, with a zero determinant, when a pivot is at most tolerance
+// times the largest element of its row, ScalarTraits<T>::PivotTolerance(n)
+// unless given. Scaling a row thus never changes the outcome.
+template <typename T>
+class LUDecomposition {
+ public:
+  explicit LUDecomposition(const S21BasicMatrix<T>& matrix);
+  LUDecomposition(const S21BasicMatrix<T>& matrix, double tolerance);
+
+  [[nodiscard]] S21BasicMatrix<T> GetL() const;
+  [[nodiscard]] S21BasicMatrix<T> GetU() const;
+  [[nodiscard]] const std::vector<int>& GetPermutation() const;
+  [[nodiscard]] int GetSign() const;
+  [[nodiscard]] bool IsSingular() const;
+
+  [[nodiscard]] T Determinant() const;
+  [[nodiscard]] S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  [[nodiscard]] S21BasicMatrix<T> Inverse() const;
+
+ private:
+  // Overwrites the permuted right-hand side x with the solution of LUx = x.
+  void Substitute(S21BasicMatrix<T>& x) const;
+
+  S21BasicMatrix<T> lu_;
+  std::vector<int> permutation_;
+  int sign_{1};
+  bool singular_{false};
 };
 
-std::ostream& operator<<(std::ostream& out, const S21Matrix& matrix);
-S21Matrix operator*(const double number, S21Matrix& matrix);
+template <typename T>
+struct ExpressionOperand<S21BasicMatrix<T>> {
+  using Type = const S21BasicMatrix<T>&;
+};
+
+template <typename T>
+template <typename Expression>
+S21BasicMatrix<T>::S21BasicMatrix(
+    const MatrixExpression<Expression>& expression)
+    : rows_{expression.Self().GetRows()}, cols_{expression.Self().GetCols()} {
+  static_assert(std::is_same_v<typename Expression::value_type, T>,
+                "The expression must have the element type of the matrix.");
+  AllocateMemory();
+  EvaluateElements(expression.Self());
+}
+
+template <typename T>
+template <typename Expression>
+S21BasicMatrix<T>::S21BasicMatrix(MatrixExpression<Expression>&& expression)
+    : rows_{expression.Self().GetRows()}, cols_{expression.Self().GetCols()} {
+  static_assert(std::is_same_v<typename Expression::value_type, T>,
+                "The expression must have the element type of the matrix.");
+  const Expression& source{expression.Self()};
+  S21BasicMatrix* const owned{source.Owned()};
+  if (owned == nullptr || owned->IsShared()) {
+    AllocateMemory();
+    EvaluateElements(source);
+    return;
+  }
+
+  owned->EvaluateElements(source);
+  resource_ = owned->resource_;
+  TakeStorage(*owned);
+}
+
+template <typename T>
+template <typename Other>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix<Other>& other)
+    : rows_{other.GetRows()}, cols_{other.GetCols()} {
+  AllocateMemory();
+  std::transform(other.data(), other.data() + ElementCount(), matrix_,
+                 [](const Other& value) { return static_cast<T>(value); });
+}
+
+template <typename T>
+template <typename Expression>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    const MatrixExpression<Expression>& expression) {
+  const Expression& source{expression.Self()};
+  // The expression may read this matrix, so shared storage is not copied
+  // and then overwritten in place.
+  if (rows_ != source.GetRows() || cols_ != source.GetCols() || IsShared()) {
+    S21BasicMatrix result{source};
+    return *this = std::move(result);
+  }
+
+  EvaluateElements(source);
+  return *this;
+}
+
+template <typename T>
+template <typename Expression>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    MatrixExpression<Expression>&& expression) {
+  const Expression& source{expression.Self()};
+  if (rows_ == source.GetRows() && cols_ == source.GetCols() && !IsShared()) {
+    EvaluateElements(source);
+    return *this;
+  }
+
+  S21BasicMatrix result{std::move(expression)};
+  return *this = std::move(result);
+}
+
+template <typename T>
+template <typename Expression>
+void S21BasicMatrix<T>::EvaluateElements(const Expression& expression) {
+  const std::size_t size{ElementCount()};
+  for (std::size_t i{0}; i < size; ++i) {
+    matrix_[i] = expression.Element(i);
+  }
+}
+
+template <typename T>
+inline T S21BasicMatrix<T>::Element(std::size_t index) const noexcept {
+  return matrix_[index];
+}
+
+template <typename T>
+inline T& S21BasicMatrix<T>::AtUnchecked(int row, int column) {
+  assert(row >= 0 && column >= 0 && row < rows_ && column < cols_);
+  Detach();
+  return matrix_[static_cast<std::size_t>(row) * cols_ + column];
+}
+
+template <typename T>
+inline void S21BasicMatrix<T>::Detach() {
+  if (references_.load(std::memory_order_relaxed) != nullptr) Unshare();
+}
+
+template <typename T>
+inline const T& S21BasicMatrix<T>::AtUnchecked(int row,
+                                               int column) const noexcept {
+  assert(row >= 0 && column >= 0 && row < rows_ && column < cols_);
+  return matrix_[static_cast<std::size_t>(row) * cols_ + column];
+}
+
+template <typename T>
+[[nodiscard]] const S21BasicMatrix<T>& Evaluate(
+    const S21BasicMatrix<T>& matrix) {
+  return matrix;
+}
+
+template <typename Expression>
+[[nodiscard]] S21BasicMatrix<typename Expression::value_type> Evaluate(
+    const MatrixExpression<Expression>& expression) {
+  return S21BasicMatrix<typename Expression::value_type>{expression};
+}
+
+template <typename Left, typename Right>
+[[nodiscard]] S21BasicMatrix<typename Left::value_type> operator*(
+    const MatrixExpression<Left>& left, const MatrixExpression<Right>& right) {
+  return Evaluate(left) * Evaluate(right);
+}
+
+template <typename Left, typename Right>
+[[nodiscard]] bool operator==(const MatrixExpression<Left>& left,
+                              const MatrixExpression<Right>& right) {
+  return Evaluate(left).EqMatrix(Evaluate(right));
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& out, const S21BasicMatrix<T>& matrix);
 }  // namespace s21
 
 #endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_OOP_H_
@@ -0,0 +1,224 @@
+#include "s21_matrix_profile.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace s21::profile {
+namespace {
+struct Counters {
+  std::atomic<std::uint64_t> calls{0};
+  std::atomic<std::uint64_t> elements{0};
+  std::atomic<std::uint64_t> bytes_allocated{0};
+  std::atomic<std::int64_t> nanoseconds{0};
+};
+
+struct TraceEvent {
+  Operation operation;
+  int thread;
+  std::int64_t start;
+  std::int64_t duration;
+  std::uint64_t elements;
+  std::uint64_t bytes_allocated;
+};
+
+std::array<Counters, kOperationCount> counters;
+std::atomic<std::uint64_t> allocations{0};
+std::atomic<std::uint64_t> bytes_allocated{0};
+
+const std::chrono::steady_clock::time_point epoch{
+    std::chrono::steady_clock::now()};
+
+std::atomic<bool> tracing{false};
+std::mutex trace_mutex;
+std::vector<TraceEvent> trace;
+std::size_t trace_capacity{0};
+std::uint64_t dropped_events{0};
+
+thread_local ScopedOperation* innermost{nullptr};
+
+[[nodiscard]] int ThreadNumber() noexcept {
+  static std::atomic<int> next{1};
+  thread_local const int number{next++};
+  return number;
+}
+
+[[nodiscard]] std::int64_t Nanoseconds(
+    std::chrono::steady_clock::duration duration) noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+      .count();
+}
+
+void Trace(const TraceEvent& event) noexcept {
+  const std::lock_guard lock{trace_mutex};
+  if (trace.size() == trace_capacity) {
+    ++dropped_events;
+    return;
+  }
+  trace.push_back(event);
+}
+
+using FilePointer = std::unique_ptr<std::FILE, decltype(&std::fclose)>;
+
+[[noreturn]] void ThrowWriteError(const std::string& path) {
+  throw std::system_error{
+      errno, std::generic_category(),
+      "WriteChromeTrace(const std::string&): Cannot write file. " + path};
+}
+
+void Write(std::FILE* file, std::string_view text, const std::string& path) {
+  if (std::fwrite(text.data(), 1, text.size(), file) != text.size()) {
+    ThrowWriteError(path);
+  }
+}
+}  // namespace
+
+[[nodiscard]] const char* OperationName(Operation operation) noexcept {
+  switch (operation) {
+    case Operation::kMulMatrix:
+      return "MulMatrix";
+    case Operation::kDeterminant:
+      return "Determinant";
+    case Operation::kInverseMatrix:
+      return "InverseMatrix";
+    case Operation::kCalcComplements:
+      return "CalcComplements";
+    case Operation::kCopy:
+      return "Copy";
+    case Operation::kMove:
+      return "Move";
+    case Operation::kChangeSize:
+      return "ChangeSize";
+  }
+  return "Unknown";
+}
+
+[[nodiscard]] const OperationProfile& Snapshot::operator[](
+    Operation operation) const noexcept {
+  return operations[static_cast<std::size_t>(operation)];
+}
+
+[[nodiscard]] Snapshot GetSnapshot() {
+  Snapshot snapshot;
+  for (std::size_t index{0}; index < kOperationCount; ++index) {
+    const Counters& source{counters[index]};
+    OperationProfile& profile{snapshot.operations[index]};
+    profile.calls = source.calls.load(std::memory_order_relaxed);
+    profile.elements = source.elements.load(std::memory_order_relaxed);
+    profile.bytes_allocated =
+        source.bytes_allocated.load(std::memory_order_relaxed);
+    profile.wall_time = std::chrono::nanoseconds{
+        source.nanoseconds.load(std::memory_order_relaxed)};
+  }
+  snapshot.allocations = allocations.load(std::memory_order_relaxed);
+  snapshot.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+
+  return snapshot;
+}
+
+void Reset() {
+  for (Counters& operation : counters) {
+    operation.calls = 0;
+    operation.elements = 0;
+    operation.bytes_allocated = 0;
+    operation.nanoseconds = 0;
+  }
+  allocations = 0;
+  bytes_allocated = 0;
+}
+
+void StartTrace(std::size_t max_events) {
+  const std::lock_guard lock{trace_mutex};
+  trace.clear();
+  trace.reserve(max_events);
+  trace_capacity = max_events;
+  dropped_events = 0;
+  tracing = true;
+}
+
+void StopTrace() { tracing = false; }
+
+void WriteChromeTrace(const std::string& path) {
+  std::vector<TraceEvent> events;
+  std::uint64_t dropped{0};
+  {
+    const std::lock_guard lock{trace_mutex};
+    events = trace;
+    dropped = dropped_events;
+  }
+
+  FilePointer file{std::fopen(path.c_str(), "wb"), &std::fclose};
+  if (file == nullptr) {
+    throw std::system_error{
+        errno, std::generic_category(),
+        "WriteChromeTrace(const std::string&): Cannot open file. " + path};
+  }
+
+  Write(file.get(), "{\"traceEvents\":[", path);
+  char line[256];
+  for (std::size_t index{0}; index < events.size(); ++index) {
+    const TraceEvent& event{events[index]};
+    // Timestamps and durations are in microseconds.
+    const int length{std::snprintf(
+        line, sizeof(line),
+        "%s\n{\"name\":\"%s\",\"cat\":\"s21_matrix\",\"ph\":\"X\",\"pid\":1,"
+        "\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"elements\":%llu,"
+        "\"bytes_allocated\":%llu}}",
+        index == 0 ? "" : ",", OperationName(event.operation), event.thread,
+        static_cast<double>(event.start) / 1e3,
+        static_cast<double>(event.duration) / 1e3,
+        static_cast<unsigned long long>(event.elements),
+        static_cast<unsigned long long>(event.bytes_allocated))};
+    Write(file.get(), std::string_view{line, static_cast<std::size_t>(length)},
+          path);
+  }
+  const int length{std::snprintf(
+      line, sizeof(line),
+      "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":%llu}"
+      "}\n",
+      static_cast<unsigned long long>(dropped))};
+  Write(file.get(), std::string_view{line, static_cast<std::size_t>(length)},
+        path);
+  if (std::fclose(file.release()) != 0) ThrowWriteError(path);
+}
+
+ScopedOperation::ScopedOperation(Operation operation,
+                                 std::uint64_t elements) noexcept
+    : operation_{operation},
+      elements_{elements},
+      start_{std::chrono::steady_clock::now()},
+      parent_{innermost} {
+  innermost = this;
+}
+
+ScopedOperation::~ScopedOperation() {
+  const std::chrono::steady_clock::time_point end{
+      std::chrono::steady_clock::now()};
+  innermost = parent_;
+  if (parent_ != nullptr) parent_->bytes_allocated_ += bytes_allocated_;
+
+  Counters& target{counters[static_cast<std::size_t>(operation_)]};
+  target.calls.fetch_add(1, std::memory_order_relaxed);
+  target.elements.fetch_add(elements_, std::memory_order_relaxed);
+  target.bytes_allocated.fetch_add(bytes_allocated_,
+                                   std::memory_order_relaxed);
+  target.nanoseconds.fetch_add(Nanoseconds(end - start_),
+                               std::memory_order_relaxed);
+
+  if (tracing.load(std::memory_order_relaxed)) {
+    Trace({operation_, ThreadNumber(), Nanoseconds(start_ - epoch),
+           Nanoseconds(end - start_), elements_, bytes_allocated_});
+  }
+}
+
+void ScopedOperation::RecordAllocation(std::size_t bytes) noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+  if (innermost != nullptr) innermost->bytes_allocated_ += bytes;
+}
+}  // namespace s21::profile
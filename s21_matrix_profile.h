@@ -0,0 +1,105 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_PROFILE_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_PROFILE_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Opt-in instrumentation of the costly S21BasicMatrix operations. Building
+// the library with -DS21_MATRIX_PROFILE records, per operation, the calls,
+// the elements read, the bytes of matrix storage allocated and the wall
+// time, and optionally a trace of every call in the Chrome trace-event
+// format (chrome://tracing, Perfetto). Without the flag the hooks compile
+// to nothing and the snapshot stays zero.
+//
+// Nested operations are inclusive: the copy inside a MulMatrix counts for
+// both Copy and MulMatrix.
+namespace s21::profile {
+#ifdef S21_MATRIX_PROFILE
+inline constexpr bool kEnabled{true};
+#else
+inline constexpr bool kEnabled{false};
+#endif
+
+enum class Operation {
+  kMulMatrix,
+  kDeterminant,
+  kInverseMatrix,
+  kCalcComplements,
+  // Copy and move constructors and assignments.
+  kCopy,
+  kMove,
+  // SetRows and SetCols.
+  kChangeSize
+};
+inline constexpr std::size_t kOperationCount{7};
+
+[[nodiscard]] const char* OperationName(Operation operation) noexcept;
+
+struct OperationProfile {
+  std::uint64_t calls{0};
+  std::uint64_t elements{0};
+  std::uint64_t bytes_allocated{0};
+  std::chrono::nanoseconds wall_time{0};
+};
+
+struct Snapshot {
+  std::array<OperationProfile, kOperationCount> operations{};
+  // Allocations of matrix storage inside and outside the operations.
+  // Matrices small enough for inline storage allocate nothing.
+  std::uint64_t allocations{0};
+  std::uint64_t bytes_allocated{0};
+
+  [[nodiscard]] const OperationProfile& operator[](
+      Operation operation) const noexcept;
+};
+
+// Safe to call while other threads run operations; the counters of one
+// snapshot are not taken atomically together.
+[[nodiscard]] Snapshot GetSnapshot();
+void Reset();
+
+// Buffers a trace event for every operation from now on, up to max_events;
+// later events are counted as dropped. Restarting clears the buffer.
+void StartTrace(std::size_t max_events = std::size_t{1} << 20);
+void StopTrace();
+// Writes the buffered events as a Chrome trace-event JSON object. Throws
+// std::system_error if the file cannot be written.
+void WriteChromeTrace(const std::string& path);
+
+// Records one call of operation over elements while in scope. Used by the
+// S21_PROFILE_OPERATION hook.
+class ScopedOperation {
+ public:
+  ScopedOperation(Operation operation, std::uint64_t elements) noexcept;
+  ScopedOperation(const ScopedOperation&) = delete;
+  ScopedOperation& operator=(const ScopedOperation&) = delete;
+  ~ScopedOperation();
+
+  // Charges bytes to the innermost operation running on this thread.
+  static void RecordAllocation(std::size_t bytes) noexcept;
+
+ private:
+  Operation operation_;
+  std::uint64_t elements_;
+  std::uint64_t bytes_allocated_{0};
+  std::chrono::steady_clock::time_point start_;
+  ScopedOperation* parent_;
+};
+}  // namespace s21::profile
+
+#ifdef S21_MATRIX_PROFILE
+#define S21_PROFILE_OPERATION(operation, elements)              \
+  const ::s21::profile::ScopedOperation s21_profile_operation { \
+    ::s21::profile::Operation::operation, elements              \
+  }
+#define S21_PROFILE_ALLOCATION(bytes) \
+  ::s21::profile::ScopedOperation::RecordAllocation(bytes)
+#else
+#define S21_PROFILE_OPERATION(operation, elements) static_cast<void>(0)
+#define S21_PROFILE_ALLOCATION(bytes) static_cast<void>(0)
+#endif
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_PROFILE_H_
@@ -0,0 +1,974 @@
+#include "s21_matrix_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_traits.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define S21_MATRIX_X86_SIMD
+#endif
+
+namespace s21::kernels {
+namespace {
+constexpr int kTransposeTile{8};
+// Blocks of at most this many rows and columns fit in L1 together with
+// their transpose; larger ones are halved recursively.
+constexpr int kTransposeLeaf{32};
+// Elements Compare reduces before it checks for a mismatch: 8 KB of
+// doubles per operand.
+constexpr std::size_t kCompareBlock{1024};
+constexpr std::size_t kToleranceModes{3};
+
+// Largest ElementError over [0, size) for one tolerance mode.
+template <typename T>
+using MaxErrorKernel = double (*)(std::size_t, const T*, const T*);
+
+template <typename T>
+struct ElementwiseKernels {
+  void (*add)(std::size_t, const T*, T*);
+  void (*subtract)(std::size_t, const T*, T*);
+  void (*scale)(std::size_t, T, T*);
+  // Indexed by Tolerance.
+  MaxErrorKernel<T> max_error[kToleranceModes];
+  void (*transpose_tile)(int, int, const T*, std::ptrdiff_t, T*,
+                         std::ptrdiff_t);
+};
+
+template <typename T>
+void AddScalar(std::size_t size, const T* source, T* destination) {
+  for (std::size_t i{0}; i < size; ++i) {
+    destination[i] += source[i];
+  }
+}
+
+template <typename T>
+void SubtractScalar(std::size_t size, const T* source, T* destination) {
+  for (std::size_t i{0}; i < size; ++i) {
+    destination[i] -= source[i];
+  }
+}
+
+template <typename T>
+void ScaleScalar(std::size_t size, T number, T* destination) {
+  for (std::size_t i{0}; i < size; ++i) {
+    destination[i] *= number;
+  }
+}
+
+template <typename Real>
+Real UnitInLastPlace(Real magnitude) {
+  if (!(magnitude >= std::numeric_limits<Real>::min())) {
+    return std::numeric_limits<Real>::denorm_min();
+  }
+  if (std::isinf(magnitude)) return magnitude;
+
+  return std::ldexp(Real{1}, std::ilogb(magnitude) -
+                                 std::numeric_limits<Real>::digits + 1);
+}
+
+// Difference of left and right in the unit of mode. The vector kernels
+// perform the same operations, so they agree with it to the last bit.
+template <typename T>
+double ElementError(const T& left, const T& right, Tolerance mode) {
+  if (left == right) return 0.0;
+
+  if constexpr (std::is_integral_v<T>) {
+    using Unsigned = std::make_unsigned_t<T>;
+    const Unsigned low{static_cast<Unsigned>(std::min(left, right))};
+    const Unsigned high{static_cast<Unsigned>(std::max(left, right))};
+    const double difference{static_cast<double>(high - low)};
+    if (mode != Tolerance::kRelative) return difference;
+
+    return difference / std::max(std::abs(static_cast<double>(left)),
+                                 std::abs(static_cast<double>(right)));
+  } else {
+    using Real = typename ScalarTraits<T>::Real;
+    Real error{std::abs(left - right)};
+    if (mode != Tolerance::kAbsolute) {
+      const Real magnitude{std::max(std::abs(left), std::abs(right))};
+      error /= mode == Tolerance::kUlp ? UnitInLastPlace(magnitude)
+                                       : magnitude;
+    }
+    if (std::isnan(error)) return std::numeric_limits<double>::infinity();
+
+    return static_cast<double>(error);
+  }
+}
+
+template <Tolerance kMode, typename T>
+double MaxErrorScalar(std::size_t size, const T* left, const T* right) {
+  double maximum{0.0};
+  for (std::size_t i{0}; i < size; ++i) {
+    maximum = std::max(maximum, ElementError(left[i], right[i], kMode));
+  }
+
+  return maximum;
+}
+
+template <typename T>
+void TransposeTileScalar(int rows, int cols, const T* source,
+                         std::ptrdiff_t source_stride, T* destination,
+                         std::ptrdiff_t destination_stride) {
+  for (int i{0}; i < rows; ++i) {
+    for (int j{0}; j < cols; ++j) {
+      destination[j * destination_stride + i] = source[i * source_stride + j];
+    }
+  }
+}
+
+#ifdef S21_MATRIX_X86_SIMD
+__attribute__((target("sse2"))) void AddSse2(std::size_t size,
+                                             const double* source,
+                                             double* destination) {
+  std::size_t i{0};
+  for (; i + 2 <= size; i += 2) {
+    _mm_storeu_pd(destination + i, _mm_add_pd(_mm_loadu_pd(destination + i),
+                                              _mm_loadu_pd(source + i)));
+  }
+  AddScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("sse2"))) void SubtractSse2(std::size_t size,
+                                                  const double* source,
+                                                  double* destination) {
+  std::size_t i{0};
+  for (; i + 2 <= size; i += 2) {
+    _mm_storeu_pd(destination + i, _mm_sub_pd(_mm_loadu_pd(destination + i),
+                                              _mm_loadu_pd(source + i)));
+  }
+  SubtractScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(std::size_t size,
+                                               double number,
+                                               double* destination) {
+  const __m128d factor{_mm_set1_pd(number)};
+  std::size_t i{0};
+  for (; i + 2 <= size; i += 2) {
+    _mm_storeu_pd(destination + i,
+                  _mm_mul_pd(_mm_loadu_pd(destination + i), factor));
+  }
+  ScaleScalar(size - i, number, destination + i);
+}
+
+template <Tolerance kMode>
+__attribute__((target("sse2"))) double MaxErrorSse2(std::size_t size,
+                                                    const double* left,
+                                                    const double* right) {
+  const __m128d sign_mask{_mm_set1_pd(-0.0)};
+  const __m128d infinity{_mm_set1_pd(std::numeric_limits<double>::infinity())};
+  const __m128d epsilon{_mm_set1_pd(std::numeric_limits<double>::epsilon())};
+  const __m128d smallest{
+      _mm_set1_pd(std::numeric_limits<double>::denorm_min())};
+  __m128d maximum{_mm_setzero_pd()};
+  std::size_t i{0};
+  for (; i + 2 <= size; i += 2) {
+    const __m128d a{_mm_loadu_pd(left + i)};
+    const __m128d b{_mm_loadu_pd(right + i)};
+    __m128d error{_mm_andnot_pd(sign_mask, _mm_sub_pd(a, b))};
+    if constexpr (kMode != Tolerance::kAbsolute) {
+      __m128d scale{_mm_max_pd(_mm_andnot_pd(sign_mask, a),
+                               _mm_andnot_pd(sign_mask, b))};
+      if constexpr (kMode == Tolerance::kUlp) {
+        // The power of two of the magnitude times epsilon.
+        scale = _mm_max_pd(
+            _mm_mul_pd(_mm_and_pd(scale, infinity), epsilon), smallest);
+      }
+      error = _mm_div_pd(error, scale);
+    }
+    error = _mm_andnot_pd(_mm_cmpeq_pd(a, b), error);
+    const __m128d undefined{_mm_cmpunord_pd(error, error)};
+    error = _mm_or_pd(_mm_andnot_pd(undefined, error),
+                      _mm_and_pd(undefined, infinity));
+    maximum = _mm_max_pd(maximum, error);
+  }
+
+  double lanes[2];
+  _mm_storeu_pd(lanes, maximum);
+  return std::max(*std::max_element(lanes, lanes + 2),
+                  MaxErrorScalar<kMode>(size - i, left + i, right + i));
+}
+
+__attribute__((target("sse2"))) void TransposeTileSse2(
+    int rows, int cols, const double* source, std::ptrdiff_t source_stride,
+    double* destination, std::ptrdiff_t destination_stride) {
+  if (rows != kTransposeTile || cols != kTransposeTile) {
+    TransposeTileScalar(rows, cols, source, source_stride, destination,
+                        destination_stride);
+    return;
+  }
+
+  for (int i{0}; i < kTransposeTile; i += 2) {
+    for (int j{0}; j < kTransposeTile; j += 2) {
+      const __m128d row0{_mm_loadu_pd(source + i * source_stride + j)};
+      const __m128d row1{_mm_loadu_pd(source + (i + 1) * source_stride + j)};
+      _mm_storeu_pd(destination + j * destination_stride + i,
+                    _mm_unpacklo_pd(row0, row1));
+      _mm_storeu_pd(destination + (j + 1) * destination_stride + i,
+                    _mm_unpackhi_pd(row0, row1));
+    }
+  }
+}
+
+__attribute__((target("avx2"))) void AddAvx2(std::size_t size,
+                                             const double* source,
+                                             double* destination) {
+  std::size_t i{0};
+  for (; i + 4 <= size; i += 4) {
+    _mm256_storeu_pd(destination + i,
+                     _mm256_add_pd(_mm256_loadu_pd(destination + i),
+                                   _mm256_loadu_pd(source + i)));
+  }
+  AddScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("avx2"))) void SubtractAvx2(std::size_t size,
+                                                  const double* source,
+                                                  double* destination) {
+  std::size_t i{0};
+  for (; i + 4 <= size; i += 4) {
+    _mm256_storeu_pd(destination + i,
+                     _mm256_sub_pd(_mm256_loadu_pd(destination + i),
+                                   _mm256_loadu_pd(source + i)));
+  }
+  SubtractScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(std::size_t size,
+                                               double number,
+                                               double* destination) {
+  const __m256d factor{_mm256_set1_pd(number)};
+  std::size_t i{0};
+  for (; i + 4 <= size; i += 4) {
+    _mm256_storeu_pd(destination + i,
+                     _mm256_mul_pd(_mm256_loadu_pd(destination + i), factor));
+  }
+  ScaleScalar(size - i, number, destination + i);
+}
+
+template <Tolerance kMode>
+__attribute__((target("avx2"))) double MaxErrorAvx2(std::size_t size,
+                                                    const double* left,
+                                                    const double* right) {
+  const __m256d sign_mask{_mm256_set1_pd(-0.0)};
+  const __m256d infinity{
+      _mm256_set1_pd(std::numeric_limits<double>::infinity())};
+  const __m256d epsilon{_mm256_set1_pd(std::numeric_limits<double>::epsilon())};
+  const __m256d smallest{
+      _mm256_set1_pd(std::numeric_limits<double>::denorm_min())};
+  __m256d maximum{_mm256_setzero_pd()};
+  std::size_t i{0};
+  for (; i + 4 <= size; i += 4) {
+    const __m256d a{_mm256_loadu_pd(left + i)};
+    const __m256d b{_mm256_loadu_pd(right + i)};
+    __m256d error{_mm256_andnot_pd(sign_mask, _mm256_sub_pd(a, b))};
+    if constexpr (kMode != Tolerance::kAbsolute) {
+      __m256d scale{_mm256_max_pd(_mm256_andnot_pd(sign_mask, a),
+                                  _mm256_andnot_pd(sign_mask, b))};
+      if constexpr (kMode == Tolerance::kUlp) {
+        scale = _mm256_max_pd(
+            _mm256_mul_pd(_mm256_and_pd(scale, infinity), epsilon), smallest);
+      }
+      error = _mm256_div_pd(error, scale);
+    }
+    error = _mm256_andnot_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ), error);
+    error = _mm256_blendv_pd(error, infinity,
+                             _mm256_cmp_pd(error, error, _CMP_UNORD_Q));
+    maximum = _mm256_max_pd(maximum, error);
+  }
+
+  double lanes[4];
+  _mm256_storeu_pd(lanes, maximum);
+  return std::max(*std::max_element(lanes, lanes + 4),
+                  MaxErrorScalar<kMode>(size - i, left + i, right + i));
+}
+
+__attribute__((target("avx2"))) void TransposeTileAvx2(
+    int rows, int cols, const double* source, std::ptrdiff_t source_stride,
+    double* destination, std::ptrdiff_t destination_stride) {
+  if (rows != kTransposeTile || cols != kTransposeTile) {
+    TransposeTileScalar(rows, cols, source, source_stride, destination,
+                        destination_stride);
+    return;
+  }
+
+  for (int i{0}; i < kTransposeTile; i += 4) {
+    for (int j{0}; j < kTransposeTile; j += 4) {
+      const double* from{source + i * source_stride + j};
+      const __m256d row0{_mm256_loadu_pd(from)};
+      const __m256d row1{_mm256_loadu_pd(from + source_stride)};
+      const __m256d row2{_mm256_loadu_pd(from + 2 * source_stride)};
+      const __m256d row3{_mm256_loadu_pd(from + 3 * source_stride)};
+      const __m256d low01{_mm256_unpacklo_pd(row0, row1)};
+      const __m256d high01{_mm256_unpackhi_pd(row0, row1)};
+      const __m256d low23{_mm256_unpacklo_pd(row2, row3)};
+      const __m256d high23{_mm256_unpackhi_pd(row2, row3)};
+      double* to{destination + j * destination_stride + i};
+      _mm256_storeu_pd(to, _mm256_permute2f128_pd(low01, low23, 0x20));
+      _mm256_storeu_pd(to + destination_stride,
+                       _mm256_permute2f128_pd(high01, high23, 0x20));
+      _mm256_storeu_pd(to + 2 * destination_stride,
+                       _mm256_permute2f128_pd(low01, low23, 0x31));
+      _mm256_storeu_pd(to + 3 * destination_stride,
+                       _mm256_permute2f128_pd(high01, high23, 0x31));
+    }
+  }
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(std::size_t size,
+                                                  const double* source,
+                                                  double* destination) {
+  std::size_t i{0};
+  for (; i + 8 <= size; i += 8) {
+    _mm512_storeu_pd(destination + i,
+                     _mm512_add_pd(_mm512_loadu_pd(destination + i),
+                                   _mm512_loadu_pd(source + i)));
+  }
+  AddScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("avx512f"))) void SubtractAvx512(std::size_t size,
+                                                       const double* source,
+                                                       double* destination) {
+  std::size_t i{0};
+  for (; i + 8 <= size; i += 8) {
+    _mm512_storeu_pd(destination + i,
+                     _mm512_sub_pd(_mm512_loadu_pd(destination + i),
+                                   _mm512_loadu_pd(source + i)));
+  }
+  SubtractScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(std::size_t size,
+                                                    double number,
+                                                    double* destination) {
+  const __m512d factor{_mm512_set1_pd(number)};
+  std::size_t i{0};
+  for (; i + 8 <= size; i += 8) {
+    _mm512_storeu_pd(destination + i,
+                     _mm512_mul_pd(_mm512_loadu_pd(destination + i), factor));
+  }
+  ScaleScalar(size - i, number, destination + i);
+}
+
+// GCC 12 reports its own _mm512_max_pd and _mm512_max_ps as reading an
+// uninitialized value, so the maximum is selected by comparison.
+__attribute__((target("avx512f"))) __m512d Max512(__m512d left,
+                                                  __m512d right) {
+  return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(right, left, _CMP_GT_OQ),
+                              left, right);
+}
+
+__attribute__((target("avx512f"))) __m512 Max512(__m512 left, __m512 right) {
+  return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(right, left, _CMP_GT_OQ),
+                              left, right);
+}
+
+template <Tolerance kMode>
+__attribute__((target("avx512f"))) double MaxErrorAvx512(std::size_t size,
+                                                         const double* left,
+                                                         const double* right) {
+  const __m512d infinity{
+      _mm512_set1_pd(std::numeric_limits<double>::infinity())};
+  const __m512d epsilon{_mm512_set1_pd(std::numeric_limits<double>::epsilon())};
+  const __m512d smallest{
+      _mm512_set1_pd(std::numeric_limits<double>::denorm_min())};
+  __m512d maximum{_mm512_setzero_pd()};
+  std::size_t i{0};
+  for (; i + 8 <= size; i += 8) {
+    const __m512d a{_mm512_loadu_pd(left + i)};
+    const __m512d b{_mm512_loadu_pd(right + i)};
+    __m512d error{_mm512_abs_pd(_mm512_sub_pd(a, b))};
+    if constexpr (kMode != Tolerance::kAbsolute) {
+      __m512d scale{Max512(_mm512_abs_pd(a), _mm512_abs_pd(b))};
+      if constexpr (kMode == Tolerance::kUlp) {
+        const __m512d power{_mm512_castsi512_pd(_mm512_and_si512(
+            _mm512_castpd_si512(scale), _mm512_castpd_si512(infinity)))};
+        scale = Max512(_mm512_mul_pd(power, epsilon), smallest);
+      }
+      error = _mm512_div_pd(error, scale);
+    }
+    error = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ), error,
+                                 _mm512_setzero_pd());
+    error = _mm512_mask_blend_pd(
+        _mm512_cmp_pd_mask(error, error, _CMP_UNORD_Q), error, infinity);
+    maximum = Max512(maximum, error);
+  }
+
+  double lanes[8];
+  _mm512_storeu_pd(lanes, maximum);
+  return std::max(*std::max_element(lanes, lanes + 8),
+                  MaxErrorScalar<kMode>(size - i, left + i, right + i));
+}
+
+__attribute__((target("sse2"))) void AddSse2(std::size_t size,
+                                             const float* source,
+                                             float* destination) {
+  std::size_t i{0};
+  for (; i + 4 <= size; i += 4) {
+    _mm_storeu_ps(destination + i, _mm_add_ps(_mm_loadu_ps(destination + i),
+                                              _mm_loadu_ps(source + i)));
+  }
+  AddScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("sse2"))) void SubtractSse2(std::size_t size,
+                                                  const float* source,
+                                                  float* destination) {
+  std::size_t i{0};
+  for (; i + 4 <= size; i += 4) {
+    _mm_storeu_ps(destination + i, _mm_sub_ps(_mm_loadu_ps(destination + i),
+                                              _mm_loadu_ps(source + i)));
+  }
+  SubtractScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(std::size_t size, float number,
+                                               float* destination) {
+  const __m128 factor{_mm_set1_ps(number)};
+  std::size_t i{0};
+  for (; i + 4 <= size; i += 4) {
+    _mm_storeu_ps(destination + i,
+                  _mm_mul_ps(_mm_loadu_ps(destination + i), factor));
+  }
+  ScaleScalar(size - i, number, destination + i);
+}
+
+template <Tolerance kMode>
+__attribute__((target("sse2"))) double MaxErrorSse2(std::size_t size,
+                                                    const float* left,
+                                                    const float* right) {
+  const __m128 sign_mask{_mm_set1_ps(-0.0F)};
+  const __m128 infinity{_mm_set1_ps(std::numeric_limits<float>::infinity())};
+  const __m128 epsilon{_mm_set1_ps(std::numeric_limits<float>::epsilon())};
+  const __m128 smallest{_mm_set1_ps(std::numeric_limits<float>::denorm_min())};
+  __m128 maximum{_mm_setzero_ps()};
+  std::size_t i{0};
+  for (; i + 4 <= size; i += 4) {
+    const __m128 a{_mm_loadu_ps(left + i)};
+    const __m128 b{_mm_loadu_ps(right + i)};
+    __m128 error{_mm_andnot_ps(sign_mask, _mm_sub_ps(a, b))};
+    if constexpr (kMode != Tolerance::kAbsolute) {
+      __m128 scale{_mm_max_ps(_mm_andnot_ps(sign_mask, a),
+                              _mm_andnot_ps(sign_mask, b))};
+      if constexpr (kMode == Tolerance::kUlp) {
+        // The power of two of the magnitude times epsilon.
+        scale = _mm_max_ps(
+            _mm_mul_ps(_mm_and_ps(scale, infinity), epsilon), smallest);
+      }
+      error = _mm_div_ps(error, scale);
+    }
+    error = _mm_andnot_ps(_mm_cmpeq_ps(a, b), error);
+    const __m128 undefined{_mm_cmpunord_ps(error, error)};
+    error = _mm_or_ps(_mm_andnot_ps(undefined, error),
+                      _mm_and_ps(undefined, infinity));
+    maximum = _mm_max_ps(maximum, error);
+  }
+
+  float lanes[4];
+  _mm_storeu_ps(lanes, maximum);
+  return std::max(static_cast<double>(*std::max_element(lanes, lanes + 4)),
+                  MaxErrorScalar<kMode>(size - i, left + i, right + i));
+}
+
+__attribute__((target("sse2"))) void TransposeTileSse2(
+    int rows, int cols, const float* source, std::ptrdiff_t source_stride,
+    float* destination, std::ptrdiff_t destination_stride) {
+  if (rows != kTransposeTile || cols != kTransposeTile) {
+    TransposeTileScalar(rows, cols, source, source_stride, destination,
+                        destination_stride);
+    return;
+  }
+
+  for (int i{0}; i < kTransposeTile; i += 4) {
+    for (int j{0}; j < kTransposeTile; j += 4) {
+      const float* from{source + i * source_stride + j};
+      __m128 row0{_mm_loadu_ps(from)};
+      __m128 row1{_mm_loadu_ps(from + source_stride)};
+      __m128 row2{_mm_loadu_ps(from + 2 * source_stride)};
+      __m128 row3{_mm_loadu_ps(from + 3 * source_stride)};
+      _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+      float* to{destination + j * destination_stride + i};
+      _mm_storeu_ps(to, row0);
+      _mm_storeu_ps(to + destination_stride, row1);
+      _mm_storeu_ps(to + 2 * destination_stride, row2);
+      _mm_storeu_ps(to + 3 * destination_stride, row3);
+    }
+  }
+}
+
+__attribute__((target("avx2"))) void AddAvx2(std::size_t size,
+                                             const float* source,
+                                             float* destination) {
+  std::size_t i{0};
+  for (; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(destination + i,
+                     _mm256_add_ps(_mm256_loadu_ps(destination + i),
+                                   _mm256_loadu_ps(source + i)));
+  }
+  AddScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("avx2"))) void SubtractAvx2(std::size_t size,
+                                                  const float* source,
+                                                  float* destination) {
+  std::size_t i{0};
+  for (; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(destination + i,
+                     _mm256_sub_ps(_mm256_loadu_ps(destination + i),
+                                   _mm256_loadu_ps(source + i)));
+  }
+  SubtractScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(std::size_t size, float number,
+                                               float* destination) {
+  const __m256 factor{_mm256_set1_ps(number)};
+  std::size_t i{0};
+  for (; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(destination + i,
+                     _mm256_mul_ps(_mm256_loadu_ps(destination + i), factor));
+  }
+  ScaleScalar(size - i, number, destination + i);
+}
+
+template <Tolerance kMode>
+__attribute__((target("avx2"))) double MaxErrorAvx2(std::size_t size,
+                                                    const float* left,
+                                                    const float* right) {
+  const __m256 sign_mask{_mm256_set1_ps(-0.0F)};
+  const __m256 infinity{
+      _mm256_set1_ps(std::numeric_limits<float>::infinity())};
+  const __m256 epsilon{_mm256_set1_ps(std::numeric_limits<float>::epsilon())};
+  const __m256 smallest{
+      _mm256_set1_ps(std::numeric_limits<float>::denorm_min())};
+  __m256 maximum{_mm256_setzero_ps()};
+  std::size_t i{0};
+  for (; i + 8 <= size; i += 8) {
+    const __m256 a{_mm256_loadu_ps(left + i)};
+    const __m256 b{_mm256_loadu_ps(right + i)};
+    __m256 error{_mm256_andnot_ps(sign_mask, _mm256_sub_ps(a, b))};
+    if constexpr (kMode != Tolerance::kAbsolute) {
+      __m256 scale{_mm256_max_ps(_mm256_andnot_ps(sign_mask, a),
+                                 _mm256_andnot_ps(sign_mask, b))};
+      if constexpr (kMode == Tolerance::kUlp) {
+        scale = _mm256_max_ps(
+            _mm256_mul_ps(_mm256_and_ps(scale, infinity), epsilon), smallest);
+      }
+      error = _mm256_div_ps(error, scale);
+    }
+    error = _mm256_andnot_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ), error);
+    error = _mm256_blendv_ps(error, infinity,
+                             _mm256_cmp_ps(error, error, _CMP_UNORD_Q));
+    maximum = _mm256_max_ps(maximum, error);
+  }
+
+  float lanes[8];
+  _mm256_storeu_ps(lanes, maximum);
+  return std::max(static_cast<double>(*std::max_element(lanes, lanes + 8)),
+                  MaxErrorScalar<kMode>(size - i, left + i, right + i));
+}
+
+__attribute__((target("avx2"))) void TransposeTileAvx2(
+    int rows, int cols, const float* source, std::ptrdiff_t source_stride,
+    float* destination, std::ptrdiff_t destination_stride) {
+  if (rows != kTransposeTile || cols != kTransposeTile) {
+    TransposeTileScalar(rows, cols, source, source_stride, destination,
+                        destination_stride);
+    return;
+  }
+
+  __m256 row[kTransposeTile];
+  for (int i{0}; i < kTransposeTile; ++i) {
+    row[i] = _mm256_loadu_ps(source + i * source_stride);
+  }
+  __m256 pairs[kTransposeTile];
+  for (int i{0}; i < kTransposeTile; i += 2) {
+    pairs[i] = _mm256_unpacklo_ps(row[i], row[i + 1]);
+    pairs[i + 1] = _mm256_unpackhi_ps(row[i], row[i + 1]);
+  }
+  __m256 quads[kTransposeTile];
+  for (int i{0}; i < kTransposeTile; i += 4) {
+    quads[i] = _mm256_shuffle_ps(pairs[i], pairs[i + 2], 0x44);
+    quads[i + 1] = _mm256_shuffle_ps(pairs[i], pairs[i + 2], 0xEE);
+    quads[i + 2] = _mm256_shuffle_ps(pairs[i + 1], pairs[i + 3], 0x44);
+    quads[i + 3] = _mm256_shuffle_ps(pairs[i + 1], pairs[i + 3], 0xEE);
+  }
+  for (int i{0}; i < 4; ++i) {
+    _mm256_storeu_ps(destination + i * destination_stride,
+                     _mm256_permute2f128_ps(quads[i], quads[i + 4], 0x20));
+    _mm256_storeu_ps(destination + (i + 4) * destination_stride,
+                     _mm256_permute2f128_ps(quads[i], quads[i + 4], 0x31));
+  }
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(std::size_t size,
+                                                  const float* source,
+                                                  float* destination) {
+  std::size_t i{0};
+  for (; i + 16 <= size; i += 16) {
+    _mm512_storeu_ps(destination + i,
+                     _mm512_add_ps(_mm512_loadu_ps(destination + i),
+                                   _mm512_loadu_ps(source + i)));
+  }
+  AddScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("avx512f"))) void SubtractAvx512(std::size_t size,
+                                                       const float* source,
+                                                       float* destination) {
+  std::size_t i{0};
+  for (; i + 16 <= size; i += 16) {
+    _mm512_storeu_ps(destination + i,
+                     _mm512_sub_ps(_mm512_loadu_ps(destination + i),
+                                   _mm512_loadu_ps(source + i)));
+  }
+  SubtractScalar(size - i, source + i, destination + i);
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(std::size_t size,
+                                                    float number,
+                                                    float* destination) {
+  const __m512 factor{_mm512_set1_ps(number)};
+  std::size_t i{0};
+  for (; i + 16 <= size; i += 16) {
+    _mm512_storeu_ps(destination + i,
+                     _mm512_mul_ps(_mm512_loadu_ps(destination + i), factor));
+  }
+  ScaleScalar(size - i, number, destination + i);
+}
+
+template <Tolerance kMode>
+__attribute__((target("avx512f"))) double MaxErrorAvx512(std::size_t size,
+                                                         const float* left,
+                                                         const float* right) {
+  const __m512 infinity{
+      _mm512_set1_ps(std::numeric_limits<float>::infinity())};
+  const __m512 epsilon{_mm512_set1_ps(std::numeric_limits<float>::epsilon())};
+  const __m512 smallest{
+      _mm512_set1_ps(std::numeric_limits<float>::denorm_min())};
+  __m512 maximum{_mm512_setzero_ps()};
+  std::size_t i{0};
+  for (; i + 16 <= size; i += 16) {
+    const __m512 a{_mm512_loadu_ps(left + i)};
+    const __m512 b{_mm512_loadu_ps(right + i)};
+    __m512 error{_mm512_abs_ps(_mm512_sub_ps(a, b))};
+    if constexpr (kMode != Tolerance::kAbsolute) {
+      __m512 scale{Max512(_mm512_abs_ps(a), _mm512_abs_ps(b))};
+      if constexpr (kMode == Tolerance::kUlp) {
+        const __m512 power{_mm512_castsi512_ps(_mm512_and_si512(
+            _mm512_castps_si512(scale), _mm512_castps_si512(infinity)))};
+        scale = Max512(_mm512_mul_ps(power, epsilon), smallest);
+      }
+      error = _mm512_div_ps(error, scale);
+    }
+    error = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ), error,
+                                 _mm512_setzero_ps());
+    error = _mm512_mask_blend_ps(
+        _mm512_cmp_ps_mask(error, error, _CMP_UNORD_Q), error, infinity);
+    maximum = Max512(maximum, error);
+  }
+
+  float lanes[16];
+  _mm512_storeu_ps(lanes, maximum);
+  return std::max(static_cast<double>(*std::max_element(lanes, lanes + 16)),
+                  MaxErrorScalar<kMode>(size - i, left + i, right + i));
+}
+#endif
+
+template <typename T>
+constexpr ElementwiseKernels<T> kScalarKernels{
+    AddScalar<T>,
+    SubtractScalar<T>,
+    ScaleScalar<T>,
+    {MaxErrorScalar<Tolerance::kAbsolute, T>,
+     MaxErrorScalar<Tolerance::kRelative, T>,
+     MaxErrorScalar<Tolerance::kUlp, T>},
+    TransposeTileScalar<T>};
+#ifdef S21_MATRIX_X86_SIMD
+// Only float and double have vector implementations.
+template <typename T>
+constexpr ElementwiseKernels<T> kSse2Kernels{
+    AddSse2,
+    SubtractSse2,
+    ScaleSse2,
+    {MaxErrorSse2<Tolerance::kAbsolute>, MaxErrorSse2<Tolerance::kRelative>,
+     MaxErrorSse2<Tolerance::kUlp>},
+    TransposeTileSse2};
+template <typename T>
+constexpr ElementwiseKernels<T> kAvx2Kernels{
+    AddAvx2,
+    SubtractAvx2,
+    ScaleAvx2,
+    {MaxErrorAvx2<Tolerance::kAbsolute>, MaxErrorAvx2<Tolerance::kRelative>,
+     MaxErrorAvx2<Tolerance::kUlp>},
+    TransposeTileAvx2};
+template <typename T>
+constexpr ElementwiseKernels<T> kAvx512Kernels{
+    AddAvx512,
+    SubtractAvx512,
+    ScaleAvx512,
+    {MaxErrorAvx512<Tolerance::kAbsolute>,
+     MaxErrorAvx512<Tolerance::kRelative>, MaxErrorAvx512<Tolerance::kUlp>},
+    TransposeTileAvx2};
+#endif
+
+template <typename T>
+constexpr bool kHasVectorKernels{std::is_same_v<T, float> ||
+                                 std::is_same_v<T, double>};
+
+template <typename T>
+const ElementwiseKernels<T>& KernelsFor(SimdLevel level) {
+#ifdef S21_MATRIX_X86_SIMD
+  if constexpr (kHasVectorKernels<T>) {
+    switch (level) {
+      case SimdLevel::kAvx512:
+        return kAvx512Kernels<T>;
+      case SimdLevel::kAvx2:
+        return kAvx2Kernels<T>;
+      case SimdLevel::kSse2:
+        return kSse2Kernels<T>;
+      case SimdLevel::kScalar:
+        break;
+    }
+  }
+#endif
+  static_cast<void>(level);
+  return kScalarKernels<T>;
+}
+
+std::atomic<bool> level_selected{false};
+std::atomic<SimdLevel> active_level{SimdLevel::kScalar};
+
+template <typename T>
+const ElementwiseKernels<T>& ActiveKernels() {
+  return KernelsFor<T>(GetSimdLevel());
+}
+
+template <typename T>
+using TransposeTileKernel = void (*)(int, int, const T*, std::ptrdiff_t, T*,
+                                     std::ptrdiff_t);
+
+int SplitPoint(int extent) {
+  return std::max(kTransposeTile, extent / 2 / kTransposeTile * kTransposeTile);
+}
+
+template <typename T>
+void TransposeRecursive(int rows, int cols, const T* source,
+                        std::ptrdiff_t source_stride, T* destination,
+                        std::ptrdiff_t destination_stride,
+                        TransposeTileKernel<T> transpose_tile) {
+  if (rows <= kTransposeLeaf && cols <= kTransposeLeaf) {
+    for (int i{0}; i < rows; i += kTransposeTile) {
+      for (int j{0}; j < cols; j += kTransposeTile) {
+        transpose_tile(std::min(kTransposeTile, rows - i),
+                       std::min(kTransposeTile, cols - j),
+                       source + i * source_stride + j, source_stride,
+                       destination + j * destination_stride + i,
+                       destination_stride);
+      }
+    }
+  } else if (rows >= cols) {
+    const int half{SplitPoint(rows)};
+    TransposeRecursive(half, cols, source, source_stride, destination,
+                       destination_stride, transpose_tile);
+    TransposeRecursive(rows - half, cols, source + half * source_stride,
+                       source_stride, destination + half, destination_stride,
+                       transpose_tile);
+  } else {
+    const int half{SplitPoint(cols)};
+    TransposeRecursive(rows, half, source, source_stride, destination,
+                       destination_stride, transpose_tile);
+    TransposeRecursive(rows, cols - half, source + half, source_stride,
+                       destination + half * destination_stride,
+                       destination_stride, transpose_tile);
+  }
+}
+
+// Exchanges the rows x cols block a with the transpose of the cols x rows
+// block b; both live in the same matrix and do not overlap.
+template <typename T>
+void SwapTransposed(int rows, int cols, T* a, T* b,
+                    std::ptrdiff_t stride, TransposeTileKernel<T> transpose_tile) {
+  if (rows == kTransposeTile && cols == kTransposeTile) {
+    T buffer[kTransposeTile * kTransposeTile];
+    transpose_tile(rows, cols, a, stride, buffer, kTransposeTile);
+    transpose_tile(cols, rows, b, stride, a, stride);
+    for (int i{0}; i < kTransposeTile; ++i) {
+      std::copy_n(buffer + i * kTransposeTile, kTransposeTile, b + i * stride);
+    }
+  } else if (rows <= kTransposeTile && cols <= kTransposeTile) {
+    for (int i{0}; i < rows; ++i) {
+      for (int j{0}; j < cols; ++j) {
+        std::swap(a[i * stride + j], b[j * stride + i]);
+      }
+    }
+  } else if (rows >= cols) {
+    const int half{SplitPoint(rows)};
+    SwapTransposed(half, cols, a, b, stride, transpose_tile);
+    SwapTransposed(rows - half, cols, a + half * stride, b + half, stride,
+                   transpose_tile);
+  } else {
+    const int half{SplitPoint(cols)};
+    SwapTransposed(rows, half, a, b, stride, transpose_tile);
+    SwapTransposed(rows, cols - half, a + half, b + half * stride, stride,
+                   transpose_tile);
+  }
+}
+
+template <typename T>
+void TransposeSquareRecursive(int size, T* data, std::ptrdiff_t stride,
+                              TransposeTileKernel<T> transpose_tile) {
+  if (size <= kTransposeTile) {
+    for (int i{0}; i < size; ++i) {
+      for (int j{i + 1}; j < size; ++j) {
+        std::swap(data[i * stride + j], data[j * stride + i]);
+      }
+    }
+    return;
+  }
+
+  const int half{SplitPoint(size)};
+  TransposeSquareRecursive(half, data, stride, transpose_tile);
+  TransposeSquareRecursive(size - half, data + half * stride + half, stride,
+                           transpose_tile);
+  SwapTransposed(half, size - half, data + half, data + half * stride, stride,
+                 transpose_tile);
+}
+}  // namespace
+
+SimdLevel DetectSimdLevel() {
+#ifdef S21_MATRIX_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return SimdLevel::kAvx512;
+  if (__builtin_cpu_supports("avx2")) return SimdLevel::kAvx2;
+  if (__builtin_cpu_supports("sse2")) return SimdLevel::kSse2;
+#endif
+  return SimdLevel::kScalar;
+}
+
+SimdLevel GetSimdLevel() {
+  if (!level_selected) SetSimdLevel(DetectSimdLevel());
+  return active_level;
+}
+
+void SetSimdLevel(SimdLevel level) {
+  active_level = std::min(level, DetectSimdLevel());
+  level_selected = true;
+}
+
+template <typename T>
+void Add(std::size_t size, const T* source, T* destination) {
+  ActiveKernels<T>().add(size, source, destination);
+}
+
+template <typename T>
+void Subtract(std::size_t size, const T* source, T* destination) {
+  ActiveKernels<T>().subtract(size, source, destination);
+}
+
+template <typename T>
+void Scale(std::size_t size, T number, T* destination) {
+  ActiveKernels<T>().scale(size, number, destination);
+}
+
+template <typename T>
+bool AllClose(std::size_t size, const T* left, const T* right,
+              double tolerance) {
+  return Compare(size, left, right, {Tolerance::kAbsolute, tolerance}, true)
+             .first_mismatch == size;
+}
+
+template <typename T>
+ElementComparison Compare(std::size_t size, const T* left, const T* right,
+                          const CompareOptions& options,
+                          bool stop_at_mismatch) {
+  const MaxErrorKernel<T> max_error{
+      ActiveKernels<T>().max_error[static_cast<std::size_t>(options.mode)]};
+  ElementComparison result{size, 0.0};
+  for (std::size_t start{0}; start < size; start += kCompareBlock) {
+    const std::size_t end{std::min(size, start + kCompareBlock)};
+    const double block_error{
+        max_error(end - start, left + start, right + start)};
+    result.max_error = std::max(result.max_error, block_error);
+    if (block_error <= options.tolerance || result.first_mismatch != size) {
+      continue;
+    }
+
+    std::size_t index{start};
+    while (index + 1 < end && ElementError(left[index], right[index],
+                                           options.mode) <= options.tolerance) {
+      ++index;
+    }
+    result.first_mismatch = index;
+    if (stop_at_mismatch) break;
+  }
+
+  return result;
+}
+
+template <typename T>
+void Transpose(int rows, int cols, const T* source, int source_stride,
+               T* destination, int destination_stride) {
+  TransposeRecursive(rows, cols, source, source_stride, destination,
+                     destination_stride, ActiveKernels<T>().transpose_tile);
+}
+
+template <typename T>
+void TransposeInPlace(int size, T* data, int stride) {
+  TransposeSquareRecursive(size, data, stride,
+                           ActiveKernels<T>().transpose_tile);
+}
+
+template <typename T>
+void TransposeInPlace(int rows, int cols, T* data) {
+  const std::size_t size{static_cast<std::size_t>(rows) *
+                         static_cast<std::size_t>(cols)};
+  if (size < 3 || rows == 1 || cols == 1) return;
+
+  // The element at index k of the rows x cols layout moves to
+  // k * rows mod (size - 1); follow every cycle of that permutation once.
+  const std::size_t modulus{size - 1};
+  std::vector<bool> visited(size);
+  for (std::size_t start{1}; start < modulus; ++start) {
+    if (visited[start]) continue;
+
+    T carried{data[start]};
+    std::size_t index{start};
+    do {
+      index = index * static_cast<std::size_t>(rows) % modulus;
+      std::swap(carried, data[index]);
+      visited[index] = true;
+    } while (index != start);
+  }
+}
+
+#define S21_INSTANTIATE_KERNELS(T)                                     \
+  template void Add(std::size_t, const T*, T*);                        \
+  template void Subtract(std::size_t, const T*, T*);                   \
+  template void Scale(std::size_t, T, T*);                             \
+  template bool AllClose(std::size_t, const T*, const T*, double);     \
+  template ElementComparison Compare(std::size_t, const T*, const T*,  \
+                                     const CompareOptions&, bool);     \
+  template void Transpose(int, int, const T*, int, T*, int);           \
+  template void TransposeInPlace(int, T*, int);                        \
+  template void TransposeInPlace(int, int, T*);
+
+S21_INSTANTIATE_KERNELS(float)
+S21_INSTANTIATE_KERNELS(double)
+S21_INSTANTIATE_KERNELS(long double)
+S21_INSTANTIATE_KERNELS(std::int32_t)
+S21_INSTANTIATE_KERNELS(std::int64_t)
+S21_INSTANTIATE_KERNELS(std::complex<float>)
+S21_INSTANTIATE_KERNELS(std::complex<double>)
+#undef S21_INSTANTIATE_KERNELS
+}  // namespace s21::kernels
@@ -0,0 +1,770 @@
+#include "s21_matrix_text.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace s21 {
+namespace {
+// Texts shorter than kParallelTextBytes are handled on the calling thread;
+// longer ones are split into chunks of about kTextChunkBytes, at most
+// kChunksPerThread per thread at a time.
+constexpr std::size_t kParallelTextBytes{std::size_t{1} << 20};
+constexpr std::size_t kTextChunkBytes{std::size_t{1} << 18};
+constexpr int kChunksPerThread{4};
+
+template <typename T>
+struct IsComplex : std::false_type {};
+template <typename T>
+struct IsComplex<std::complex<T>> : std::true_type {};
+
+using FilePointer = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+[[nodiscard]] int ResolveThreads(int num_threads) {
+  return num_threads > 0 ? num_threads : GetNumThreads();
+}
+
+[[noreturn]] void ThrowSystemError(const std::string& function,
+                                   const std::string& description,
+                                   const std::string& path) {
+  throw std::system_error{errno, std::generic_category(),
+                          function + ": " + description + " " + path};
+}
+
+[[nodiscard]] FilePointer OpenFile(const std::string& path, const char* mode,
+                                   const std::string& function) {
+  FilePointer file{std::fopen(path.c_str(), mode), &std::fclose};
+  if (file == nullptr) ThrowSystemError(function, "Cannot open file.", path);
+  return file;
+}
+
+void CloseFile(FilePointer& file, const std::string& function,
+               const std::string& path) {
+  if (std::fclose(file.release()) != 0) {
+    ThrowSystemError(function, "Cannot write file.", path);
+  }
+}
+
+void WriteText(std::FILE* file, std::string_view text,
+               const std::string& function, const std::string& path) {
+  if (std::fwrite(text.data(), 1, text.size(), file) != text.size()) {
+    ThrowSystemError(function, "Cannot write file.", path);
+  }
+}
+
+[[nodiscard]] std::string ReadFile(const std::string& path,
+                                   const std::string& function) {
+  FilePointer file{OpenFile(path, "rb", function)};
+  if (std::fseek(file.get(), 0, SEEK_END) != 0) {
+    ThrowSystemError(function, "Cannot read file.", path);
+  }
+  const long size{std::ftell(file.get())};
+  if (size < 0 || std::fseek(file.get(), 0, SEEK_SET) != 0) {
+    ThrowSystemError(function, "Cannot read file.", path);
+  }
+
+  std::string text(static_cast<std::size_t>(size), '\0');
+  if (std::fread(text.data(), 1, text.size(), file.get()) != text.size()) {
+    ThrowSystemError(function, "Cannot read file.", path);
+  }
+
+  return text;
+}
+
+[[nodiscard]] bool IsBlank(char character) {
+  return character == ' ' || character == '\t' || character == '\r';
+}
+
+[[nodiscard]] std::string_view TrimLine(std::string_view line) {
+  while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+  while (!line.empty() && IsBlank(line.back())) line.remove_suffix(1);
+  return line;
+}
+
+// Data lines are the non-blank lines that are not '%' comments.
+[[nodiscard]] bool IsDataLine(std::string_view trimmed_line) {
+  return !trimmed_line.empty() && trimmed_line.front() != '%';
+}
+
+template <typename Visit>
+void ForEachLine(std::string_view text, const Visit& visit) {
+  while (!text.empty()) {
+    const std::size_t end{text.find('\n')};
+    visit(text.substr(0, end));
+    if (end == std::string_view::npos) break;
+    text.remove_prefix(end + 1);
+  }
+}
+
+// Removes lines from the front of text up to and including the first data
+// line, which is returned trimmed; empty if there is none.
+[[nodiscard]] std::string_view TakeDataLine(std::string_view& text) {
+  while (!text.empty()) {
+    const std::size_t end{text.find('\n')};
+    const std::string_view line{TrimLine(text.substr(0, end))};
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    if (IsDataLine(line)) return line;
+  }
+
+  return {};
+}
+
+struct LineChunks {
+  std::vector<std::string_view> texts;
+  // Index of the first data line of every chunk, followed by the total.
+  std::vector<std::size_t> first_lines;
+};
+
+[[nodiscard]] LineChunks SplitLines(std::string_view text, int num_threads) {
+  const int chunks{
+      text.size() < kParallelTextBytes || num_threads <= 1
+          ? 1
+          : static_cast<int>(std::min<std::size_t>(
+                static_cast<std::size_t>(kChunksPerThread) * num_threads,
+                text.size() / kTextChunkBytes))};
+
+  LineChunks result;
+  std::size_t start{0};
+  for (int chunk{1}; chunk <= chunks; ++chunk) {
+    std::size_t end{text.size()};
+    if (chunk < chunks) {
+      end = text.find('\n', std::max(start, text.size() * chunk / chunks));
+      end = end == std::string_view::npos ? text.size() : end + 1;
+    }
+    result.texts.push_back(text.substr(start, end - start));
+    start = end;
+  }
+
+  std::vector<std::size_t> counts(result.texts.size());
+  ThreadPool::Global().ParallelFor(
+      static_cast<int>(result.texts.size()),
+      [&](int chunk) {
+        ForEachLine(result.texts[chunk], [&](std::string_view line) {
+          if (IsDataLine(TrimLine(line))) ++counts[chunk];
+        });
+      },
+      num_threads);
+
+  result.first_lines.push_back(0);
+  for (std::size_t count : counts) {
+    result.first_lines.push_back(result.first_lines.back() + count);
+  }
+
+  return result;
+}
+
+// Calls parse_line(index, line) with every trimmed data line and its index.
+template <typename ParseLine>
+void ParseLines(const LineChunks& chunks, int num_threads,
+                const ParseLine& parse_line) {
+  ThreadPool::Global().ParallelFor(
+      static_cast<int>(chunks.texts.size()),
+      [&](int chunk) {
+        std::size_t index{chunks.first_lines[chunk]};
+        ForEachLine(chunks.texts[chunk], [&](std::string_view line) {
+          line = TrimLine(line);
+          if (IsDataLine(line)) parse_line(index++, line);
+        });
+      },
+      num_threads);
+}
+
+// Calls format_line(index, out) for index in [0, count) in parallel
+// batches and writes the text in order. line_bytes estimates the length of
+// a line.
+template <typename FormatLine>
+void WriteLines(std::FILE* file, std::size_t count, std::size_t line_bytes,
+                int num_threads, const FormatLine& format_line,
+                const std::string& function, const std::string& path) {
+  if (count * line_bytes < kParallelTextBytes) num_threads = 1;
+  const std::size_t lines_per_chunk{
+      std::max<std::size_t>(1, kTextChunkBytes / std::max<std::size_t>(
+                                                     1, line_bytes))};
+  const std::size_t chunks_per_batch{
+      num_threads <= 1 ? 1
+                       : static_cast<std::size_t>(kChunksPerThread) *
+                             num_threads};
+
+  std::vector<std::string> buffers(chunks_per_batch);
+  for (std::size_t batch{0}; batch < count;
+       batch += lines_per_chunk * chunks_per_batch) {
+    const std::size_t chunks{std::min(
+        chunks_per_batch,
+        (count - batch + lines_per_chunk - 1) / lines_per_chunk)};
+    ThreadPool::Global().ParallelFor(
+        static_cast<int>(chunks),
+        [&](int chunk) {
+          std::string& buffer{buffers[chunk]};
+          buffer.clear();
+          const std::size_t first{batch + chunk * lines_per_chunk};
+          const std::size_t last{std::min(count, first + lines_per_chunk)};
+          for (std::size_t line{first}; line < last; ++line) {
+            format_line(line, buffer);
+          }
+        },
+        num_threads);
+
+    for (std::size_t chunk{0}; chunk < chunks; ++chunk) {
+      WriteText(file, buffers[chunk], function, path);
+    }
+  }
+}
+
+[[nodiscard]] const char* SkipBlanks(const char* first, const char* last) {
+  while (first != last && IsBlank(*first)) ++first;
+  return first;
+}
+
+// Returns the end of the number, or nullptr if there is none.
+template <typename Scalar>
+[[nodiscard]] const char* ParseScalar(const char* first, const char* last,
+                                      Scalar& value) {
+  first = SkipBlanks(first, last);
+  if (first != last && *first == '+') ++first;
+  const std::from_chars_result result{std::from_chars(first, last, value)};
+  return result.ec == std::errc{} ? result.ptr : nullptr;
+}
+
+template <typename Scalar>
+void AppendScalar(std::string& out, Scalar value) {
+  char buffer[64];
+  const std::to_chars_result result{
+      std::to_chars(buffer, buffer + sizeof(buffer), value)};
+  out.append(buffer, result.ptr);
+}
+
+// Complex values are written as the real and imaginary parts separated by
+// a space, as in Matrix Market files.
+template <typename T>
+void AppendValue(std::string& out, const T& value) {
+  if constexpr (IsComplex<T>::value) {
+    AppendScalar(out, value.real());
+    out += ' ';
+    AppendScalar(out, value.imag());
+  } else {
+    AppendScalar(out, value);
+  }
+}
+
+[[nodiscard]] bool IsBlankDelimiter(char delimiter) {
+  return delimiter == ' ' || delimiter == '\t';
+}
+
+[[nodiscard]] int CountFields(std::string_view line, char delimiter) {
+  if (!IsBlankDelimiter(delimiter)) {
+    return 1 + static_cast<int>(std::count(line.begin(), line.end(),
+                                           delimiter));
+  }
+
+  int fields{0};
+  for (std::size_t i{0}; i < line.size(); ++i) {
+    if (!IsBlank(line[i]) && (i == 0 || IsBlank(line[i - 1]))) ++fields;
+  }
+
+  return fields;
+}
+
+enum class MarketField { kReal, kInteger, kComplex, kPattern };
+enum class MarketSymmetry { kGeneral, kSymmetric, kSkewSymmetric, kHermitian };
+
+struct MarketHeader {
+  bool coordinate;
+  MarketField field;
+  MarketSymmetry symmetry;
+  int rows;
+  int cols;
+  std::size_t entries;
+  // The text after the size line.
+  std::string_view body;
+};
+
+[[noreturn]] void ThrowMarketError(const std::string& function,
+                                   const std::string& description) {
+  throw std::runtime_error{function + ": " + description};
+}
+
+template <typename T>
+[[nodiscard]] MarketHeader ParseMarketHeader(std::string_view text,
+                                             const std::string& function) {
+  const std::size_t banner_end{text.find('\n')};
+  std::string banner{TrimLine(text.substr(0, banner_end))};
+  text.remove_prefix(banner_end == std::string_view::npos ? text.size()
+                                                          : banner_end + 1);
+  std::transform(banner.begin(), banner.end(), banner.begin(),
+                 [](unsigned char character) {
+                   return static_cast<char>(std::tolower(character));
+                 });
+
+  std::vector<std::string> tokens;
+  for (std::size_t start{0}; start < banner.size();) {
+    const std::size_t end{
+        std::min(banner.find_first_of(" \t", start), banner.size())};
+    if (end > start) tokens.push_back(banner.substr(start, end - start));
+    start = end + 1;
+  }
+  if (tokens.size() != 5 || tokens[0] != "%%matrixmarket" ||
+      tokens[1] != "matrix") {
+    ThrowMarketError(function,
+                     "File is not a Matrix Market file. "
+                     "It must start with a %%MatrixMarket matrix banner.");
+  }
+
+  MarketHeader header{};
+  if (tokens[2] != "coordinate" && tokens[2] != "array") {
+    ThrowMarketError(function,
+                     "Matrix Market format is not supported. "
+                     "It must be coordinate or array.");
+  }
+  header.coordinate = tokens[2] == "coordinate";
+
+  if (tokens[3] == "real" || tokens[3] == "double") {
+    header.field = MarketField::kReal;
+  } else if (tokens[3] == "integer") {
+    header.field = MarketField::kInteger;
+  } else if (tokens[3] == "complex") {
+    header.field = MarketField::kComplex;
+  } else if (tokens[3] == "pattern" && header.coordinate) {
+    header.field = MarketField::kPattern;
+  } else {
+    ThrowMarketError(function,
+                     "Matrix Market field is not supported. "
+                     "It must be real, double, integer, complex or, in "
+                     "coordinate files, pattern.");
+  }
+  if ((std::is_integral_v<T> && (header.field == MarketField::kReal ||
+                                 header.field == MarketField::kComplex)) ||
+      (!IsComplex<T>::value && header.field == MarketField::kComplex)) {
+    ThrowMarketError(function,
+                     "Matrix Market field does not match the element type. "
+                     "Values must be representable in the matrix.");
+  }
+
+  if (tokens[4] == "general") {
+    header.symmetry = MarketSymmetry::kGeneral;
+  } else if (tokens[4] == "symmetric") {
+    header.symmetry = MarketSymmetry::kSymmetric;
+  } else if (tokens[4] == "skew-symmetric") {
+    header.symmetry = MarketSymmetry::kSkewSymmetric;
+  } else if (tokens[4] == "hermitian") {
+    header.symmetry = MarketSymmetry::kHermitian;
+  } else {
+    ThrowMarketError(function,
+                     "Matrix Market symmetry is not supported. "
+                     "It must be general, symmetric, skew-symmetric or "
+                     "hermitian.");
+  }
+
+  const std::string_view size_line{TakeDataLine(text)};
+  const char* position{size_line.data()};
+  const char* last{size_line.data() + size_line.size()};
+  long long rows{0};
+  long long cols{0};
+  long long entries{0};
+  if (position != nullptr) position = ParseScalar(position, last, rows);
+  if (position != nullptr) position = ParseScalar(position, last, cols);
+  if (position != nullptr && header.coordinate) {
+    position = ParseScalar(position, last, entries);
+  }
+  if (position == nullptr || SkipBlanks(position, last) != last ||
+      rows <= 0 || cols <= 0 || rows > INT_MAX || cols > INT_MAX ||
+      entries < 0 ||
+      (header.symmetry != MarketSymmetry::kGeneral && rows != cols)) {
+    ThrowMarketError(function,
+                     "Matrix Market size line is malformed. "
+                     "It must give positive dimensions, equal for symmetric "
+                     "matrices, and the entry count in coordinate files.");
+  }
+
+  header.rows = static_cast<int>(rows);
+  header.cols = static_cast<int>(cols);
+  header.entries = static_cast<std::size_t>(entries);
+  header.body = text;
+
+  return header;
+}
+
+template <typename T>
+[[nodiscard]] const char* ParseMarketValue(const char* first,
+                                           const char* last,
+                                           MarketField field, T& value) {
+  if (field == MarketField::kPattern) {
+    value = T{1};
+    return first;
+  }
+
+  if constexpr (IsComplex<T>::value) {
+    typename T::value_type real{};
+    typename T::value_type imaginary{};
+    first = ParseScalar(first, last, real);
+    if (first != nullptr && field == MarketField::kComplex) {
+      first = ParseScalar(first, last, imaginary);
+    }
+    value = T{real, imaginary};
+    return first;
+  } else {
+    return ParseScalar(first, last, value);
+  }
+}
+
+// Value stored at (j, i) for a value at (i, j) of a symmetric matrix.
+template <typename T>
+[[nodiscard]] T Mirror(const T& value, MarketSymmetry symmetry) {
+  if (symmetry == MarketSymmetry::kSkewSymmetric) return -value;
+  if constexpr (IsComplex<T>::value) {
+    if (symmetry == MarketSymmetry::kHermitian) return std::conj(value);
+  }
+
+  return value;
+}
+
+[[noreturn]] void ThrowEntryError(const std::string& function,
+                                  std::size_t entry) {
+  ThrowMarketError(function, "Matrix Market entry " +
+                                 std::to_string(entry + 1) +
+                                 " is malformed. "
+                                 "It must match the field and lie within "
+                                 "the matrix.");
+}
+
+void CheckEntryCount(const std::string& function, std::size_t found,
+                     std::size_t expected) {
+  if (found != expected) {
+    ThrowMarketError(function, "Matrix Market file has " +
+                                   std::to_string(found) +
+                                   " entries. "
+                                   "The size line announces " +
+                                   std::to_string(expected) + ".");
+  }
+}
+
+// Array files list the columns in order, of the lower triangle only (and
+// without the diagonal if skew-symmetric) for symmetric matrices.
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> ReadMarketArray(const MarketHeader& header,
+                                                int num_threads,
+                                                const std::string& function) {
+  const int rows{header.rows};
+  const int cols{header.cols};
+  const bool general{header.symmetry == MarketSymmetry::kGeneral};
+  const int skip_diagonal{
+      header.symmetry == MarketSymmetry::kSkewSymmetric ? 1 : 0};
+
+  std::vector<std::size_t> column_starts{0};
+  for (int column{0}; column < cols; ++column) {
+    column_starts.push_back(
+        column_starts.back() +
+        static_cast<std::size_t>(general ? rows
+                                         : rows - column - skip_diagonal));
+  }
+
+  const LineChunks chunks{SplitLines(header.body, num_threads)};
+  CheckEntryCount(function, chunks.first_lines.back(), column_starts.back());
+
+  S21BasicMatrix<T> matrix{rows, cols};
+  T* data{matrix.data()};
+  const std::ptrdiff_t stride{matrix.stride()};
+  ParseLines(chunks, num_threads, [&](std::size_t entry,
+                                      std::string_view line) {
+    const char* last{line.data() + line.size()};
+    T value{};
+    const char* position{
+        ParseMarketValue(line.data(), last, header.field, value)};
+    if (position == nullptr || SkipBlanks(position, last) != last) {
+      ThrowEntryError(function, entry);
+    }
+
+    const int column{static_cast<int>(
+        std::upper_bound(column_starts.begin(), column_starts.end(), entry) -
+        column_starts.begin() - 1)};
+    const int row{static_cast<int>(entry - column_starts[column]) +
+                  (general ? 0 : column + skip_diagonal)};
+    data[row * stride + column] = value;
+    if (!general && row != column) {
+      data[column * stride + row] = Mirror(value, header.symmetry);
+    }
+  });
+
+  return matrix;
+}
+
+template <typename T>
+[[nodiscard]] std::vector<SparseEntry<T>> ReadMarketEntries(
+    const MarketHeader& header, int num_threads,
+    const std::string& function) {
+  const LineChunks chunks{SplitLines(header.body, num_threads)};
+  CheckEntryCount(function, chunks.first_lines.back(), header.entries);
+
+  std::vector<SparseEntry<T>> entries(header.entries);
+  ParseLines(chunks, num_threads, [&](std::size_t entry,
+                                      std::string_view line) {
+    const char* last{line.data() + line.size()};
+    long long row{0};
+    long long column{0};
+    T value{};
+    const char* position{ParseScalar(line.data(), last, row)};
+    if (position != nullptr) position = ParseScalar(position, last, column);
+    if (position != nullptr) {
+      position = ParseMarketValue(position, last, header.field, value);
+    }
+    if (position == nullptr || SkipBlanks(position, last) != last ||
+        row < 1 || column < 1 || row > header.rows || column > header.cols) {
+      ThrowEntryError(function, entry);
+    }
+
+    entries[entry] = {static_cast<int>(row - 1), static_cast<int>(column - 1),
+                      value};
+  });
+
+  if (header.symmetry != MarketSymmetry::kGeneral) {
+    for (std::size_t entry{0}; entry < header.entries; ++entry) {
+      const SparseEntry<T> stored{entries[entry]};
+      if (stored.row != stored.column) {
+        entries.push_back({stored.column, stored.row,
+                           Mirror(stored.value, header.symmetry)});
+      }
+    }
+  }
+
+  return entries;
+}
+
+template <typename T>
+[[nodiscard]] const char* MarketFieldName() {
+  if constexpr (IsComplex<T>::value) {
+    return "complex";
+  } else if constexpr (std::is_integral_v<T>) {
+    return "integer";
+  } else {
+    return "real";
+  }
+}
+}  // namespace
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> ReadCsv(const std::string& path,
+                                        const CsvOptions& options) {
+  const std::string function{"ReadCsv(const string&, const CsvOptions&)"};
+  const std::string text{ReadFile(path, function)};
+  std::string_view body{text};
+  for (int line{0}; line < options.skip_lines && !body.empty(); ++line) {
+    const std::size_t end{body.find('\n')};
+    body.remove_prefix(end == std::string_view::npos ? body.size() : end + 1);
+  }
+
+  const int num_threads{ResolveThreads(options.num_threads)};
+  const char delimiter{options.delimiter};
+  const LineChunks chunks{SplitLines(body, num_threads)};
+  std::string_view rest{body};
+  const std::string_view first_row{TakeDataLine(rest)};
+  const std::size_t rows{chunks.first_lines.back()};
+  if (rows == 0 || rows > INT_MAX) {
+    throw std::runtime_error{function +
+                             ": File has no rows or too many. "
+                             "It must hold between one and INT_MAX rows."};
+  }
+
+  const int cols{CountFields(first_row, delimiter)};
+  S21BasicMatrix<T> matrix{static_cast<int>(rows), cols};
+  T* data{matrix.data()};
+  const std::ptrdiff_t stride{matrix.stride()};
+  ParseLines(chunks, num_threads, [&](std::size_t row,
+                                      std::string_view line) {
+    const char* position{line.data()};
+    const char* last{line.data() + line.size()};
+    T* out{data + static_cast<std::ptrdiff_t>(row) * stride};
+    for (int column{0}; column < cols && position != nullptr; ++column) {
+      if (column > 0) {
+        const char* separator{SkipBlanks(position, last)};
+        if (IsBlankDelimiter(delimiter)) {
+          position = separator != position ? separator : nullptr;
+        } else if (separator != last && *separator == delimiter) {
+          position = separator + 1;
+        } else {
+          position = nullptr;
+        }
+      }
+      if (position != nullptr) {
+        position = ParseScalar(position, last, out[column]);
+      }
+    }
+
+    if (position == nullptr || SkipBlanks(position, last) != last) {
+      throw std::runtime_error{
+          function + ": Row " + std::to_string(row + 1) +
+          " is malformed. "
+          "Every row must hold " +
+          std::to_string(cols) + " numbers separated by the delimiter."};
+    }
+  });
+
+  return matrix;
+}
+
+template <typename T>
+void WriteCsv(const S21BasicMatrix<T>& matrix, const std::string& path,
+              const CsvOptions& options) {
+  const std::string function{
+      "WriteCsv(const S21BasicMatrix&, const string&, const CsvOptions&)"};
+  FilePointer file{OpenFile(path, "wb", function)};
+  const T* data{matrix.data()};
+  const std::ptrdiff_t stride{matrix.stride()};
+  const int cols{matrix.GetCols()};
+
+  WriteLines(
+      file.get(), static_cast<std::size_t>(matrix.GetRows()),
+      static_cast<std::size_t>(cols) * 24,
+      ResolveThreads(options.num_threads),
+      [&](std::size_t row, std::string& out) {
+        const T* elements{data + static_cast<std::ptrdiff_t>(row) * stride};
+        for (int column{0}; column < cols; ++column) {
+          if (column > 0) out += options.delimiter;
+          AppendValue(out, elements[column]);
+        }
+        out += '\n';
+      },
+      function, path);
+  CloseFile(file, function, path);
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> ReadMatrixMarket(const std::string& path,
+                                                 int num_threads) {
+  const std::string function{"ReadMatrixMarket(const string&, int)"};
+  const std::string text{ReadFile(path, function)};
+  const MarketHeader header{ParseMarketHeader<T>(text, function)};
+  num_threads = ResolveThreads(num_threads);
+  if (!header.coordinate) {
+    return ReadMarketArray<T>(header, num_threads, function);
+  }
+
+  S21BasicMatrix<T> matrix{header.rows, header.cols};
+  for (const SparseEntry<T>& entry :
+       ReadMarketEntries<T>(header, num_threads, function)) {
+    matrix.AtUnchecked(entry.row, entry.column) += entry.value;
+  }
+
+  return matrix;
+}
+
+template <typename T>
+[[nodiscard]] S21BasicSparseMatrix<T> ReadMatrixMarketSparse(
+    const std::string& path, SparseFormat format, int num_threads) {
+  const std::string function{
+      "ReadMatrixMarketSparse(const string&, SparseFormat, int)"};
+  const std::string text{ReadFile(path, function)};
+  const MarketHeader header{ParseMarketHeader<T>(text, function)};
+  num_threads = ResolveThreads(num_threads);
+  if (!header.coordinate) {
+    return S21BasicSparseMatrix<T>{
+        ReadMarketArray<T>(header, num_threads, function), format};
+  }
+
+  return {header.rows, header.cols,
+          ReadMarketEntries<T>(header, num_threads, function), format};
+}
+
+template <typename T>
+void WriteMatrixMarket(const S21BasicMatrix<T>& matrix,
+                       const std::string& path, int num_threads) {
+  const std::string function{
+      "WriteMatrixMarket(const S21BasicMatrix&, const string&, int)"};
+  FilePointer file{OpenFile(path, "wb", function)};
+  const int rows{matrix.GetRows()};
+  const int cols{matrix.GetCols()};
+  WriteText(file.get(),
+            std::string{"%%MatrixMarket matrix array "} +
+                MarketFieldName<T>() + " general\n" + std::to_string(rows) +
+                ' ' + std::to_string(cols) + '\n',
+            function, path);
+
+  WriteLines(
+      file.get(),
+      static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols), 24,
+      ResolveThreads(num_threads),
+      [&](std::size_t entry, std::string& out) {
+        const int row{static_cast<int>(entry % rows)};
+        const int column{static_cast<int>(entry / rows)};
+        AppendValue(out, matrix.AtUnchecked(row, column));
+        out += '\n';
+      },
+      function, path);
+  CloseFile(file, function, path);
+}
+
+template <typename T>
+void WriteMatrixMarket(const S21BasicSparseMatrix<T>& matrix,
+                       const std::string& path, int num_threads) {
+  const std::string function{
+      "WriteMatrixMarket(const S21BasicSparseMatrix&, const string&, int)"};
+  FilePointer file{OpenFile(path, "wb", function)};
+  WriteText(file.get(),
+            std::string{"%%MatrixMarket matrix coordinate "} +
+                MarketFieldName<T>() + " general\n" +
+                std::to_string(matrix.GetRows()) + ' ' +
+                std::to_string(matrix.GetCols()) + ' ' +
+                std::to_string(matrix.NonZeros()) + '\n',
+            function, path);
+
+  const std::vector<std::size_t>& offsets{matrix.offsets()};
+  const bool row_major{matrix.GetFormat() == SparseFormat::kCsr};
+  WriteLines(
+      file.get(), matrix.NonZeros(), 40, ResolveThreads(num_threads),
+      [&](std::size_t entry, std::string& out) {
+        const int line{static_cast<int>(
+            std::upper_bound(offsets.begin(), offsets.end(), entry) -
+            offsets.begin() - 1)};
+        const int minor{matrix.indices()[entry]};
+        AppendScalar(out, (row_major ? line : minor) + 1);
+        out += ' ';
+        AppendScalar(out, (row_major ? minor : line) + 1);
+        out += ' ';
+        AppendValue(out, matrix.values()[entry]);
+        out += '\n';
+      },
+      function, path);
+  CloseFile(file, function, path);
+}
+
+#define S21_INSTANTIATE_CSV(T)                                            \
+  template S21BasicMatrix<T> ReadCsv(const std::string&, const CsvOptions&); \
+  template void WriteCsv(const S21BasicMatrix<T>&, const std::string&,    \
+                         const CsvOptions&);
+
+#define S21_INSTANTIATE_MATRIX_MARKET(T)                                    \
+  template S21BasicMatrix<T> ReadMatrixMarket(const std::string&, int);     \
+  template S21BasicSparseMatrix<T> ReadMatrixMarketSparse(                  \
+      const std::string&, SparseFormat, int);                               \
+  template void WriteMatrixMarket(const S21BasicMatrix<T>&,                 \
+                                  const std::string&, int);                 \
+  template void WriteMatrixMarket(const S21BasicSparseMatrix<T>&,           \
+                                  const std::string&, int);
+
+S21_INSTANTIATE_CSV(float)
+S21_INSTANTIATE_CSV(double)
+S21_INSTANTIATE_CSV(long double)
+S21_INSTANTIATE_CSV(std::int32_t)
+S21_INSTANTIATE_CSV(std::int64_t)
+S21_INSTANTIATE_MATRIX_MARKET(float)
+S21_INSTANTIATE_MATRIX_MARKET(double)
+S21_INSTANTIATE_MATRIX_MARKET(long double)
+S21_INSTANTIATE_MATRIX_MARKET(std::int32_t)
+S21_INSTANTIATE_MATRIX_MARKET(std::int64_t)
+S21_INSTANTIATE_MATRIX_MARKET(std::complex<float>)
+S21_INSTANTIATE_MATRIX_MARKET(std::complex<double>)
+#undef S21_INSTANTIATE_CSV
+#undef S21_INSTANTIATE_MATRIX_MARKET
+}  // namespace s21
@@ -0,0 +1,52 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_TEXT_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_TEXT_H_
+
+#include <string>
+
+#include "s21_matrix_oop.h"
+#include "s21_sparse_matrix.h"
+
+// Text matrix files. Numbers are parsed with std::from_chars and written
+// with std::to_chars in the shortest form that reads back to the same
+// value. Large files are split into chunks of whole lines that are parsed
+// or formatted in parallel. Blank lines are skipped. A thread count of zero
+// means GetNumThreads().
+namespace s21 {
+struct CsvOptions {
+  char delimiter{','};
+  // Lines skipped before the first row, e.g. a header with column names.
+  int skip_lines{0};
+  int num_threads{0};
+};
+
+// CSV files hold one matrix row per line. Every row must have as many
+// fields as the first. Instantiated for the real and integer element types.
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> ReadCsv(const std::string& path,
+                                        const CsvOptions& options = {});
+template <typename T>
+void WriteCsv(const S21BasicMatrix<T>& matrix, const std::string& path,
+              const CsvOptions& options = {});
+
+// Matrix Market files in array (dense) or coordinate (sparse) format with
+// real, double, integer, complex or pattern fields and general, symmetric,
+// skew-symmetric or hermitian symmetry. Lines starting with '%' are
+// comments. Either format can be read into either matrix kind. Dense
+// matrices are written in array format, sparse ones in coordinate format,
+// both as general matrices.
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> ReadMatrixMarket(const std::string& path,
+                                                 int num_threads = 0);
+template <typename T>
+[[nodiscard]] S21BasicSparseMatrix<T> ReadMatrixMarketSparse(
+    const std::string& path, SparseFormat format = SparseFormat::kCsr,
+    int num_threads = 0);
+template <typename T>
+void WriteMatrixMarket(const S21BasicMatrix<T>& matrix,
+                       const std::string& path, int num_threads = 0);
+template <typename T>
+void WriteMatrixMarket(const S21BasicSparseMatrix<T>& matrix,
+                       const std::string& path, int num_threads = 0);
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_TEXT_H_
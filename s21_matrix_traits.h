@@ -0,0 +1,55 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_TRAITS_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_TRAITS_H_
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <type_traits>
+
+// Scalar types derived from a matrix element type. Real is the type of an
+// element's magnitude, Factor the type factorizations, inverses and
+// solutions are computed in: integer matrices are factorized in double.
+namespace s21 {
+template <typename T>
+struct ScalarTraits {
+  using Real = std::conditional_t<std::is_integral_v<T>, double, T>;
+  using Factor = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+  // Absolute tolerance of EqMatrix: exact for integers, otherwise 1e-7 or a
+  // few dozen units in the last place for types coarser than double.
+  [[nodiscard]] static constexpr Real Precision() {
+    if constexpr (std::is_integral_v<T>) {
+      return Real{0};
+    } else {
+      return std::max(Real{1e-7}, 64 * std::numeric_limits<Real>::epsilon());
+    }
+  }
+
+  // Factorizations of a size x size matrix take a pivot for zero when it
+  // is at most this times the largest element of the row it came from,
+  // the rounding error elimination can leave there. Zero for integers.
+  [[nodiscard]] static constexpr Real PivotTolerance(int size) {
+    if constexpr (std::is_integral_v<T>) {
+      return Real{0};
+    } else {
+      return size * std::numeric_limits<Real>::epsilon();
+    }
+  }
+};
+
+template <typename T>
+struct ScalarTraits<std::complex<T>> {
+  using Real = T;
+  using Factor = std::complex<T>;
+
+  [[nodiscard]] static constexpr Real Precision() {
+    return ScalarTraits<T>::Precision();
+  }
+
+  [[nodiscard]] static constexpr Real PivotTolerance(int size) {
+    return ScalarTraits<T>::PivotTolerance(size);
+  }
+};
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_TRAITS_H_
@@ -0,0 +1,157 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_MATRIX_VIEW_H_
+#define CPP1_S21_MATRIXPLUS_S21_MATRIX_VIEW_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+// Non-owning views into row-major storage. Views never allocate or check
+// element indices; they stay valid only while the viewed matrix keeps its
+// storage, i.e. until it is resized, reassigned or destroyed. Value is the
+// element type, const-qualified for read-only views.
+namespace s21 {
+template <typename Value>
+class RowView {
+ public:
+  RowView(Value* data, int size) noexcept : data_{data}, size_{size} {}
+
+  [[nodiscard]] int GetSize() const noexcept { return size_; }
+  [[nodiscard]] Value* data() const noexcept { return data_; }
+  [[nodiscard]] Value& operator[](int index) const noexcept {
+    return data_[index];
+  }
+
+  [[nodiscard]] Value* begin() const noexcept { return data_; }
+  [[nodiscard]] Value* end() const noexcept { return data_ + size_; }
+
+ private:
+  Value* data_;
+  int size_;
+};
+
+template <typename Value>
+class StridedIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_const_t<Value>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = Value*;
+  using reference = Value&;
+
+  StridedIterator(Value* position, std::ptrdiff_t stride) noexcept
+      : position_{position}, stride_{stride} {}
+
+  [[nodiscard]] Value& operator*() const noexcept { return *position_; }
+  StridedIterator& operator++() noexcept {
+    position_ += stride_;
+    return *this;
+  }
+  StridedIterator operator++(int) noexcept {
+    StridedIterator previous{*this};
+    position_ += stride_;
+    return previous;
+  }
+  [[nodiscard]] bool operator==(const StridedIterator& other) const noexcept {
+    return position_ == other.position_;
+  }
+  [[nodiscard]] bool operator!=(const StridedIterator& other) const noexcept {
+    return position_ != other.position_;
+  }
+
+ private:
+  Value* position_;
+  std::ptrdiff_t stride_;
+};
+
+template <typename Value>
+class ColView {
+ public:
+  ColView(Value* data, int size, int stride) noexcept
+      : data_{data}, size_{size}, stride_{stride} {}
+
+  [[nodiscard]] int GetSize() const noexcept { return size_; }
+  [[nodiscard]] int stride() const noexcept { return stride_; }
+  [[nodiscard]] Value* data() const noexcept { return data_; }
+  [[nodiscard]] Value& operator[](int index) const noexcept {
+    return data_[static_cast<std::ptrdiff_t>(index) * stride_];
+  }
+
+  [[nodiscard]] StridedIterator<Value> begin() const noexcept {
+    return {data_, stride_};
+  }
+  [[nodiscard]] StridedIterator<Value> end() const noexcept {
+    return {data_ + static_cast<std::ptrdiff_t>(size_) * stride_, stride_};
+  }
+
+ private:
+  Value* data_;
+  int size_;
+  int stride_;
+};
+
+template <typename Value>
+class SubMatrixView {
+ public:
+  SubMatrixView(Value* data, int rows, int cols, int stride) noexcept
+      : data_{data}, rows_{rows}, cols_{cols}, stride_{stride} {}
+
+  template <typename Other,
+            typename = std::enable_if_t<std::is_convertible_v<Other*, Value*>>>
+  SubMatrixView(const SubMatrixView<Other>& other) noexcept
+      : SubMatrixView{other.data(), other.GetRows(), other.GetCols(),
+                      other.stride()} {}
+
+  [[nodiscard]] int GetRows() const noexcept { return rows_; }
+  [[nodiscard]] int GetCols() const noexcept { return cols_; }
+  [[nodiscard]] int stride() const noexcept { return stride_; }
+  [[nodiscard]] Value* data() const noexcept { return data_; }
+
+  [[nodiscard]] Value& operator()(int row, int column) const noexcept {
+    return data_[static_cast<std::ptrdiff_t>(row) * stride_ + column];
+  }
+
+  [[nodiscard]] RowView<Value> Row(int row) const noexcept {
+    return {&(*this)(row, 0), cols_};
+  }
+  [[nodiscard]] ColView<Value> Col(int column) const noexcept {
+    return {&(*this)(0, column), rows_, stride_};
+  }
+
+  [[nodiscard]] SubMatrixView Block(int row, int column, int rows,
+                                    int cols) const {
+    if (row < 0 || column < 0 || rows <= 0 || cols <= 0 ||
+        row + rows > rows_ || column + cols > cols_) {
+      throw std::out_of_range{
+          "SubMatrixView::Block(int, int, int, int): Block is out of range. "
+          "It must be non-empty and lie within the viewed matrix."};
+    }
+
+    return {&(*this)(row, column), rows, cols, stride_};
+  }
+
+  // Copies the elements of a non-overlapping view with the same dimensions
+  // into this one.
+  void Assign(SubMatrixView<const std::remove_const_t<Value>> source) const {
+    if (source.GetRows() != rows_ || source.GetCols() != cols_) {
+      throw std::invalid_argument{
+          "SubMatrixView::Assign(SubMatrixView): View dimensions are not "
+          "compatible for assignment. "
+          "Both views must have the same number of rows and columns."};
+    }
+
+    for (int i{0}; i < rows_; ++i) {
+      std::copy_n(source.Row(i).data(), cols_, Row(i).data());
+    }
+  }
+
+ private:
+  Value* data_;
+  int rows_;
+  int cols_;
+  int stride_;
+};
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_MATRIX_VIEW_H_
@@ -0,0 +1,712 @@
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_thread_pool.h"
+
+namespace s21 {
+namespace {
+// Operations touching fewer elements than this run on the calling thread.
+// Parallel ones are split into kChunksPerThread chunks per thread so that
+// uneven lines still balance.
+constexpr std::size_t kParallelSparseWork{std::size_t{1} << 14};
+constexpr int kChunksPerThread{4};
+
+[[nodiscard]] int ChunkCount(std::size_t work, int lines, int num_threads) {
+  if (num_threads <= 1 || work < kParallelSparseWork) return 1;
+
+  return std::max(1, std::min(lines, kChunksPerThread * num_threads));
+}
+
+// Chunk boundaries over lines holding about the same number of entries.
+[[nodiscard]] std::vector<int> SplitByEntries(
+    const std::vector<std::size_t>& offsets, int chunks) {
+  const int lines{static_cast<int>(offsets.size()) - 1};
+  std::vector<int> bounds(static_cast<std::size_t>(chunks) + 1, lines);
+  bounds[0] = 0;
+  for (int chunk{1}; chunk < chunks; ++chunk) {
+    const std::size_t target{offsets.back() * chunk / chunks};
+    const int line{static_cast<int>(
+        std::lower_bound(offsets.begin(), offsets.end(), target) -
+        offsets.begin())};
+    bounds[chunk] = std::clamp(line, bounds[chunk - 1], lines);
+  }
+
+  return bounds;
+}
+
+[[nodiscard]] std::vector<int> SplitEvenly(int lines, int chunks) {
+  std::vector<int> bounds(static_cast<std::size_t>(chunks) + 1);
+  for (int chunk{0}; chunk <= chunks; ++chunk) {
+    bounds[chunk] = static_cast<int>(static_cast<long long>(lines) * chunk /
+                                     chunks);
+  }
+
+  return bounds;
+}
+
+template <typename Body>
+void RunChunks(int chunks, const Body& body, int num_threads) {
+  if (chunks == 1) {
+    body(0);
+  } else {
+    ThreadPool::Global().ParallelFor(chunks, body, num_threads);
+  }
+}
+
+// Builds compressed arrays line by line. Every chunk calls make_emitter()
+// once and the returned emitter once per line of the chunk, in order; it
+// appends the entries of that line to the chunk's index and value arrays.
+// The chunks are then concatenated in parallel.
+template <typename T, typename MakeEmitter>
+void AssembleLines(const std::vector<int>& bounds,
+                   const MakeEmitter& make_emitter, int num_threads,
+                   std::vector<std::size_t>& offsets, std::vector<int>& indices,
+                   std::vector<T>& values) {
+  const int chunks{static_cast<int>(bounds.size()) - 1};
+  std::vector<std::vector<int>> chunk_indices(chunks);
+  std::vector<std::vector<T>> chunk_values(chunks);
+  offsets.assign(static_cast<std::size_t>(bounds.back()) + 1, 0);
+
+  RunChunks(
+      chunks,
+      [&](int chunk) {
+        auto emit{make_emitter()};
+        for (int line{bounds[chunk]}; line < bounds[chunk + 1]; ++line) {
+          emit(line, chunk_indices[chunk], chunk_values[chunk]);
+          offsets[line + 1] = chunk_indices[chunk].size();
+        }
+      },
+      num_threads);
+
+  std::vector<std::size_t> chunk_starts(chunks + 1, 0);
+  for (int chunk{0}; chunk < chunks; ++chunk) {
+    chunk_starts[chunk + 1] =
+        chunk_starts[chunk] + chunk_indices[chunk].size();
+    for (int line{bounds[chunk]}; line < bounds[chunk + 1]; ++line) {
+      offsets[line + 1] += chunk_starts[chunk];
+    }
+  }
+
+  indices.resize(chunk_starts.back());
+  values.resize(chunk_starts.back());
+  RunChunks(
+      chunks,
+      [&](int chunk) {
+        std::copy(chunk_indices[chunk].begin(), chunk_indices[chunk].end(),
+                  indices.begin() + chunk_starts[chunk]);
+        std::copy(chunk_values[chunk].begin(), chunk_values[chunk].end(),
+                  values.begin() + chunk_starts[chunk]);
+      },
+      num_threads);
+}
+
+[[nodiscard]] SparseFormat OtherFormat(SparseFormat format) {
+  return format == SparseFormat::kCsr ? SparseFormat::kCsc
+                                      : SparseFormat::kCsr;
+}
+}  // namespace
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(int rows, int cols,
+                                              SparseFormat format)
+    : rows_{rows}, cols_{cols}, format_{format} {
+  if (rows_ <= 0 || cols_ <= 0) {
+    throw std::invalid_argument{
+        "S21BasicSparseMatrix::S21BasicSparseMatrix(int, int, SparseFormat): "
+        "Matrix has improper dimensions. "
+        "Rows and columns must be greater than zero."};
+  }
+
+  offsets_.assign(static_cast<std::size_t>(MajorCount()) + 1, 0);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, std::vector<SparseEntry<T>> entries,
+    SparseFormat format)
+    : S21BasicSparseMatrix{rows, cols, format} {
+  const bool row_major{format_ == SparseFormat::kCsr};
+  for (SparseEntry<T>& entry : entries) {
+    if (entry.row < 0 || entry.column < 0 || entry.row >= rows_ ||
+        entry.column >= cols_) {
+      throw std::out_of_range{
+          "S21BasicSparseMatrix::S21BasicSparseMatrix(int, int, "
+          "vector<SparseEntry>, SparseFormat): Entry index out of range. "
+          "Every entry must lie within the matrix."};
+    }
+    if (!row_major) std::swap(entry.row, entry.column);
+  }
+
+  // Entries are sorted by (major, minor) position after the swap above.
+  std::sort(entries.begin(), entries.end(),
+            [](const SparseEntry<T>& left, const SparseEntry<T>& right) {
+              return left.row != right.row ? left.row < right.row
+                                           : left.column < right.column;
+            });
+  for (auto entry{entries.begin()}; entry != entries.end();) {
+    T sum{};
+    auto next{entry};
+    for (; next != entries.end() && next->row == entry->row &&
+           next->column == entry->column;
+         ++next) {
+      sum += next->value;
+    }
+    if (sum != T{}) {
+      ++offsets_[entry->row + 1];
+      indices_.push_back(entry->column);
+      values_.push_back(sum);
+    }
+    entry = next;
+  }
+  for (std::size_t line{1}; line < offsets_.size(); ++line) {
+    offsets_[line] += offsets_[line - 1];
+  }
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(const S21BasicMatrix<T>& dense,
+                                              SparseFormat format)
+    : rows_{dense.GetRows()}, cols_{dense.GetCols()}, format_{format} {
+  const bool row_major{format_ == SparseFormat::kCsr};
+  const T* data{dense.data()};
+  const std::ptrdiff_t stride{dense.stride()};
+  const int minor_count{MinorCount()};
+  const std::size_t work{static_cast<std::size_t>(rows_) *
+                         static_cast<std::size_t>(cols_)};
+  const int chunks{ChunkCount(work, MajorCount(), GetNumThreads())};
+
+  AssembleLines(
+      SplitEvenly(MajorCount(), chunks),
+      [&] {
+        return [&](int line, std::vector<int>& indices,
+                   std::vector<T>& values) {
+          for (int minor{0}; minor < minor_count; ++minor) {
+            const T value{row_major ? data[line * stride + minor]
+                                    : data[minor * stride + line]};
+            if (value != T{}) {
+              indices.push_back(minor);
+              values.push_back(value);
+            }
+          }
+        };
+      },
+      GetNumThreads(), offsets_, indices_, values_);
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> dense{rows_, cols_};
+  T* data{dense.data()};
+  const std::ptrdiff_t stride{dense.stride()};
+  const bool row_major{format_ == SparseFormat::kCsr};
+  const int chunks{ChunkCount(NonZeros(), MajorCount(), GetNumThreads())};
+  const std::vector<int> bounds{SplitByEntries(offsets_, chunks)};
+
+  RunChunks(
+      chunks,
+      [&](int chunk) {
+        for (int line{bounds[chunk]}; line < bounds[chunk + 1]; ++line) {
+          for (std::size_t k{offsets_[line]}; k < offsets_[line + 1]; ++k) {
+            const std::ptrdiff_t minor{indices_[k]};
+            data[row_major ? line * stride + minor : minor * stride + line] =
+                values_[k];
+          }
+        }
+      },
+      GetNumThreads());
+
+  return dense;
+}
+
+template <typename T>
+[[nodiscard]] S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::ToFormat(
+    SparseFormat format) const {
+  if (format == format_) return *this;
+
+  // Counting sort of the entries by minor index; scanning the major lines in
+  // order keeps the new minor indices increasing.
+  S21BasicSparseMatrix result{rows_, cols_, format};
+  for (int minor : indices_) {
+    ++result.offsets_[minor + 1];
+  }
+  for (std::size_t line{1}; line < result.offsets_.size(); ++line) {
+    result.offsets_[line] += result.offsets_[line - 1];
+  }
+
+  result.indices_.resize(NonZeros());
+  result.values_.resize(NonZeros());
+  std::vector<std::size_t> next(result.offsets_.begin(),
+                                result.offsets_.end() - 1);
+  for (int line{0}; line < MajorCount(); ++line) {
+    for (std::size_t k{offsets_[line]}; k < offsets_[line + 1]; ++k) {
+      const std::size_t position{next[indices_[k]]++};
+      result.indices_[position] = line;
+      result.values_[position] = values_[k];
+    }
+  }
+
+  return result;
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SumMatrix(const S21BasicSparseMatrix& other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument{
+        "S21BasicSparseMatrix::SumMatrix(const S21BasicSparseMatrix&): "
+        "Matrix dimensions are not compatible for addition. "
+        "Both matrices must have the same number of rows and columns."};
+  }
+
+  Merge(other, [](const T& left, const T& right) { return left + right; });
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SubMatrix(const S21BasicSparseMatrix& other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument{
+        "S21BasicSparseMatrix::SubMatrix(const S21BasicSparseMatrix&): "
+        "Matrix dimensions are not compatible for subtraction. "
+        "Both matrices must have the same number of rows and columns."};
+  }
+
+  Merge(other, [](const T& left, const T& right) { return left - right; });
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::MulNumber(const T number) {
+  if (number == T{}) {
+    std::fill(offsets_.begin(), offsets_.end(), 0);
+    indices_.clear();
+    values_.clear();
+    return;
+  }
+
+  for (T& value : values_) {
+    value *= number;
+  }
+}
+
+template <typename T>
+[[nodiscard]] S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose()
+    const {
+  // The compressed arrays of a matrix in one format are those of its
+  // transpose in the other.
+  S21BasicSparseMatrix flipped{*this};
+  std::swap(flipped.rows_, flipped.cols_);
+  flipped.format_ = OtherFormat(format_);
+
+  return flipped.ToFormat(format_);
+}
+
+template <typename T>
+[[nodiscard]] std::vector<T> S21BasicSparseMatrix<T>::Multiply(
+    const std::vector<T>& x) const {
+  return Multiply(x, GetNumThreads());
+}
+
+template <typename T>
+[[nodiscard]] std::vector<T> S21BasicSparseMatrix<T>::Multiply(
+    const std::vector<T>& x, int num_threads) const {
+  if (x.size() != static_cast<std::size_t>(cols_)) {
+    throw std::invalid_argument{
+        "S21BasicSparseMatrix::Multiply(const vector&, int): Vector size is "
+        "not compatible for multiplication. "
+        "It must be equal to the number of columns in the matrix."};
+  }
+
+  std::vector<T> y(static_cast<std::size_t>(rows_));
+  if (format_ == SparseFormat::kCsr) {
+    const int chunks{ChunkCount(NonZeros(), rows_, num_threads)};
+    const std::vector<int> bounds{SplitByEntries(offsets_, chunks)};
+    RunChunks(
+        chunks,
+        [&](int chunk) {
+          for (int row{bounds[chunk]}; row < bounds[chunk + 1]; ++row) {
+            T sum{};
+            for (std::size_t k{offsets_[row]}; k < offsets_[row + 1]; ++k) {
+              sum += values_[k] * x[indices_[k]];
+            }
+            y[row] = sum;
+          }
+        },
+        num_threads);
+    return y;
+  }
+
+  // Columns scatter into all of y, so each chunk accumulates a private copy
+  // that is summed afterwards.
+  const int chunks{std::min(ChunkCount(NonZeros(), cols_, num_threads),
+                            std::max(1, num_threads))};
+  if (chunks == 1) {
+    for (int column{0}; column < cols_; ++column) {
+      for (std::size_t k{offsets_[column]}; k < offsets_[column + 1]; ++k) {
+        y[indices_[k]] += values_[k] * x[column];
+      }
+    }
+    return y;
+  }
+
+  const std::vector<int> bounds{SplitByEntries(offsets_, chunks)};
+  std::vector<std::vector<T>> partial_sums(chunks);
+  RunChunks(
+      chunks,
+      [&](int chunk) {
+        std::vector<T>& sums{partial_sums[chunk]};
+        sums.assign(static_cast<std::size_t>(rows_), T{});
+        for (int column{bounds[chunk]}; column < bounds[chunk + 1]; ++column) {
+          for (std::size_t k{offsets_[column]}; k < offsets_[column + 1];
+               ++k) {
+            sums[indices_[k]] += values_[k] * x[column];
+          }
+        }
+      },
+      num_threads);
+
+  const std::vector<int> row_bounds{SplitEvenly(rows_, chunks)};
+  RunChunks(
+      chunks,
+      [&](int chunk) {
+        for (int row{row_bounds[chunk]}; row < row_bounds[chunk + 1]; ++row) {
+          for (const std::vector<T>& sums : partial_sums) {
+            y[row] += sums[row];
+          }
+        }
+      },
+      num_threads);
+
+  return y;
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> S21BasicSparseMatrix<T>::Multiply(
+    const S21BasicMatrix<T>& dense) const {
+  return Multiply(dense, GetNumThreads());
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> S21BasicSparseMatrix<T>::Multiply(
+    const S21BasicMatrix<T>& dense, int num_threads) const {
+  if (cols_ != dense.GetRows()) {
+    throw std::invalid_argument{
+        "S21BasicSparseMatrix::Multiply(const S21BasicMatrix&, int): Matrix "
+        "dimensions are not compatible for multiplication. "
+        "Number of columns in the first matrix must be equal to the number of "
+        "rows in the second matrix."};
+  }
+
+  const int cols{dense.GetCols()};
+  const std::size_t work{NonZeros() * static_cast<std::size_t>(cols)};
+  if (format_ == SparseFormat::kCsc &&
+      ChunkCount(work, rows_, num_threads) > 1) {
+    // Rows of the result are independent only in CSR; the conversion is
+    // linear in the number of entries and the product is not.
+    return ToFormat(SparseFormat::kCsr).Multiply(dense, num_threads);
+  }
+
+  S21BasicMatrix<T> result{rows_, cols};
+  const T* in{dense.data()};
+  const std::ptrdiff_t in_stride{dense.stride()};
+  T* out{result.data()};
+  const std::ptrdiff_t out_stride{result.stride()};
+  const bool row_major{format_ == SparseFormat::kCsr};
+  const int chunks{ChunkCount(work, MajorCount(), num_threads)};
+  const std::vector<int> bounds{SplitByEntries(offsets_, chunks)};
+
+  // out(row, :) += a(row, inner) * in(inner, :) for every stored entry.
+  RunChunks(
+      chunks,
+      [&](int chunk) {
+        for (int line{bounds[chunk]}; line < bounds[chunk + 1]; ++line) {
+          for (std::size_t k{offsets_[line]}; k < offsets_[line + 1]; ++k) {
+            const std::ptrdiff_t row{row_major ? line : indices_[k]};
+            const std::ptrdiff_t inner{row_major ? indices_[k] : line};
+            const T value{values_[k]};
+            const T* in_row{in + inner * in_stride};
+            T* out_row{out + row * out_stride};
+            for (int column{0}; column < cols; ++column) {
+              out_row[column] += value * in_row[column];
+            }
+          }
+        }
+      },
+      num_threads);
+
+  return result;
+}
+
+template <typename T>
+[[nodiscard]] S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Multiply(
+    const S21BasicSparseMatrix& other) const {
+  return Multiply(other, GetNumThreads());
+}
+
+template <typename T>
+[[nodiscard]] S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Multiply(
+    const S21BasicSparseMatrix& other, int num_threads) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument{
+        "S21BasicSparseMatrix::Multiply(const S21BasicSparseMatrix&, int): "
+        "Matrix dimensions are not compatible for multiplication. "
+        "Number of columns in the first matrix must be equal to the number of "
+        "rows in the second matrix."};
+  }
+  if (other.format_ != format_) {
+    return Multiply(other.ToFormat(format_), num_threads);
+  }
+
+  // Gustavson's algorithm over the lines of left: line i of the result is
+  // the sum of the lines of right selected by the entries of line i of
+  // left. In CSR that is C = AB directly; in CSC the arrays describe the
+  // transposes, and C^T = B^T A^T.
+  const bool row_major{format_ == SparseFormat::kCsr};
+  const S21BasicSparseMatrix& left{row_major ? *this : other};
+  const S21BasicSparseMatrix& right{row_major ? other : *this};
+  const int lines{left.MajorCount()};
+  const int minor_count{right.MinorCount()};
+
+  std::size_t work{0};
+  for (int inner : left.indices_) {
+    work += right.offsets_[inner + 1] - right.offsets_[inner];
+  }
+  const int chunks{ChunkCount(work, lines, num_threads)};
+
+  S21BasicSparseMatrix result{rows_, other.cols_, format_};
+  AssembleLines(
+      SplitByEntries(left.offsets_, chunks),
+      [&] {
+        return [&left, &right, accumulator = std::vector<T>(minor_count),
+                marker = std::vector<int>(minor_count, -1),
+                touched = std::vector<int>{}](
+                   int line, std::vector<int>& indices,
+                   std::vector<T>& values) mutable {
+          touched.clear();
+          for (std::size_t k{left.offsets_[line]};
+               k < left.offsets_[line + 1]; ++k) {
+            const int inner{left.indices_[k]};
+            const T value{left.values_[k]};
+            for (std::size_t p{right.offsets_[inner]};
+                 p < right.offsets_[inner + 1]; ++p) {
+              const int minor{right.indices_[p]};
+              if (marker[minor] != line) {
+                marker[minor] = line;
+                accumulator[minor] = value * right.values_[p];
+                touched.push_back(minor);
+              } else {
+                accumulator[minor] += value * right.values_[p];
+              }
+            }
+          }
+
+          std::sort(touched.begin(), touched.end());
+          for (int minor : touched) {
+            if (accumulator[minor] != T{}) {
+              indices.push_back(minor);
+              values.push_back(accumulator[minor]);
+            }
+          }
+        };
+      },
+      num_threads, result.offsets_, result.indices_, result.values_);
+
+  return result;
+}
+
+template <typename T>
+[[nodiscard]] S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator+(
+    const S21BasicSparseMatrix& other) const {
+  S21BasicSparseMatrix result{*this};
+  result.SumMatrix(other);
+  return result;
+}
+
+template <typename T>
+[[nodiscard]] S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator-(
+    const S21BasicSparseMatrix& other) const {
+  S21BasicSparseMatrix result{*this};
+  result.SubMatrix(other);
+  return result;
+}
+
+template <typename T>
+[[nodiscard]] S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const T number) const {
+  S21BasicSparseMatrix result{*this};
+  result.MulNumber(number);
+  return result;
+}
+
+template <typename T>
+[[nodiscard]] std::vector<T> S21BasicSparseMatrix<T>::operator*(
+    const std::vector<T>& x) const {
+  return Multiply(x);
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrix<T>& dense) const {
+  return Multiply(dense);
+}
+
+template <typename T>
+[[nodiscard]] S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicSparseMatrix& other) const {
+  return Multiply(other);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>& S21BasicSparseMatrix<T>::operator+=(
+    const S21BasicSparseMatrix& other) {
+  SumMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>& S21BasicSparseMatrix<T>::operator-=(
+    const S21BasicSparseMatrix& other) {
+  SubMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>& S21BasicSparseMatrix<T>::operator*=(const T number) {
+  MulNumber(number);
+  return *this;
+}
+
+template <typename T>
+[[nodiscard]] T S21BasicSparseMatrix<T>::operator()(int row,
+                                                    int column) const {
+  if (row < 0 || column < 0 || row >= rows_ || column >= cols_) {
+    throw std::out_of_range{
+        "S21BasicSparseMatrix::operator()(int, int): Index out of range. "
+        "Row and column must lie within the matrix."};
+  }
+
+  const bool row_major{format_ == SparseFormat::kCsr};
+  const int line{row_major ? row : column};
+  const int minor{row_major ? column : row};
+  const auto first{indices_.begin() + offsets_[line]};
+  const auto last{indices_.begin() + offsets_[line + 1]};
+  const auto position{std::lower_bound(first, last, minor)};
+  if (position == last || *position != minor) return T{};
+
+  return values_[position - indices_.begin()];
+}
+
+template <typename T>
+[[nodiscard]] int S21BasicSparseMatrix<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <typename T>
+[[nodiscard]] int S21BasicSparseMatrix<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <typename T>
+[[nodiscard]] SparseFormat S21BasicSparseMatrix<T>::GetFormat()
+    const noexcept {
+  return format_;
+}
+
+template <typename T>
+[[nodiscard]] std::size_t S21BasicSparseMatrix<T>::NonZeros() const noexcept {
+  return values_.size();
+}
+
+template <typename T>
+[[nodiscard]] const std::vector<std::size_t>&
+S21BasicSparseMatrix<T>::offsets() const noexcept {
+  return offsets_;
+}
+
+template <typename T>
+[[nodiscard]] const std::vector<int>& S21BasicSparseMatrix<T>::indices()
+    const noexcept {
+  return indices_;
+}
+
+template <typename T>
+[[nodiscard]] const std::vector<T>& S21BasicSparseMatrix<T>::values()
+    const noexcept {
+  return values_;
+}
+
+template <typename T>
+[[nodiscard]] int S21BasicSparseMatrix<T>::MajorCount() const noexcept {
+  return format_ == SparseFormat::kCsr ? rows_ : cols_;
+}
+
+template <typename T>
+[[nodiscard]] int S21BasicSparseMatrix<T>::MinorCount() const noexcept {
+  return format_ == SparseFormat::kCsr ? cols_ : rows_;
+}
+
+// Replaces *this with operation(this, other) applied over the union of the
+// stored positions, a missing entry standing for zero.
+template <typename T>
+template <typename Operation>
+void S21BasicSparseMatrix<T>::Merge(const S21BasicSparseMatrix& other,
+                                    Operation operation) {
+  if (other.format_ != format_) {
+    Merge(other.ToFormat(format_), operation);
+    return;
+  }
+
+  const int num_threads{GetNumThreads()};
+  const int chunks{
+      ChunkCount(NonZeros() + other.NonZeros(), MajorCount(), num_threads)};
+  std::vector<std::size_t> offsets;
+  std::vector<int> indices;
+  std::vector<T> values;
+  AssembleLines(
+      SplitByEntries(offsets_, chunks),
+      [&] {
+        return [&](int line, std::vector<int>& line_indices,
+                   std::vector<T>& line_values) {
+          std::size_t left{offsets_[line]};
+          std::size_t right{other.offsets_[line]};
+          const std::size_t left_end{offsets_[line + 1]};
+          const std::size_t right_end{other.offsets_[line + 1]};
+          while (left < left_end || right < right_end) {
+            int minor{};
+            T value{};
+            if (right == right_end ||
+                (left < left_end && indices_[left] < other.indices_[right])) {
+              minor = indices_[left];
+              value = operation(values_[left++], T{});
+            } else if (left == left_end ||
+                       other.indices_[right] < indices_[left]) {
+              minor = other.indices_[right];
+              value = operation(T{}, other.values_[right++]);
+            } else {
+              minor = indices_[left];
+              value = operation(values_[left++], other.values_[right++]);
+            }
+            if (value != T{}) {
+              line_indices.push_back(minor);
+              line_values.push_back(value);
+            }
+          }
+        };
+      },
+      num_threads, offsets, indices, values);
+
+  offsets_ = std::move(offsets);
+  indices_ = std::move(indices);
+  values_ = std::move(values);
+}
+
+template class S21BasicSparseMatrix<float>;
+template class S21BasicSparseMatrix<double>;
+template class S21BasicSparseMatrix<long double>;
+template class S21BasicSparseMatrix<std::int32_t>;
+template class S21BasicSparseMatrix<std::int64_t>;
+template class S21BasicSparseMatrix<std::complex<float>>;
+template class S21BasicSparseMatrix<std::complex<double>>;
+}  // namespace s21
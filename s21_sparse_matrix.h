@@ -0,0 +1,105 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_SPARSE_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_S21_SPARSE_MATRIX_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+// CSR stores the matrix row by row, CSC column by column. The "major"
+// dimension is the one the offsets run over: rows for CSR, columns for CSC.
+enum class SparseFormat { kCsr, kCsc };
+
+template <typename T>
+struct SparseEntry {
+  int row;
+  int column;
+  T value;
+};
+
+// Compressed sparse matrix of T, instantiated for the same element types as
+// S21BasicMatrix. Entry k of major line i is values()[k] at minor index
+// indices()[k] for offsets()[i] <= k < offsets()[i + 1]; the minor indices
+// of a line are strictly increasing and exact zeros are never stored.
+// Operands in different formats are converted to the format of the left
+// one, which is also the format of the result.
+template <typename T>
+class S21BasicSparseMatrix {
+ public:
+  using value_type = T;
+
+  S21BasicSparseMatrix(int rows, int cols,
+                       SparseFormat format = SparseFormat::kCsr);
+  // Entries at the same position are summed.
+  S21BasicSparseMatrix(int rows, int cols, std::vector<SparseEntry<T>> entries,
+                       SparseFormat format = SparseFormat::kCsr);
+  explicit S21BasicSparseMatrix(const S21BasicMatrix<T>& dense,
+                                SparseFormat format = SparseFormat::kCsr);
+
+  [[nodiscard]] S21BasicMatrix<T> ToDense() const;
+  [[nodiscard]] S21BasicSparseMatrix ToFormat(SparseFormat format) const;
+
+  void SumMatrix(const S21BasicSparseMatrix& other);
+  void SubMatrix(const S21BasicSparseMatrix& other);
+  void MulNumber(const T number);
+  [[nodiscard]] S21BasicSparseMatrix Transpose() const;
+
+  // y = Ax.
+  [[nodiscard]] std::vector<T> Multiply(const std::vector<T>& x) const;
+  [[nodiscard]] std::vector<T> Multiply(const std::vector<T>& x,
+                                        int num_threads) const;
+  // Sparse-dense product, returned dense.
+  [[nodiscard]] S21BasicMatrix<T> Multiply(
+      const S21BasicMatrix<T>& dense) const;
+  [[nodiscard]] S21BasicMatrix<T> Multiply(const S21BasicMatrix<T>& dense,
+                                           int num_threads) const;
+  // Sparse-sparse product.
+  [[nodiscard]] S21BasicSparseMatrix Multiply(
+      const S21BasicSparseMatrix& other) const;
+  [[nodiscard]] S21BasicSparseMatrix Multiply(const S21BasicSparseMatrix& other,
+                                              int num_threads) const;
+
+  [[nodiscard]] S21BasicSparseMatrix operator+(
+      const S21BasicSparseMatrix& other) const;
+  [[nodiscard]] S21BasicSparseMatrix operator-(
+      const S21BasicSparseMatrix& other) const;
+  [[nodiscard]] S21BasicSparseMatrix operator*(const T number) const;
+  [[nodiscard]] std::vector<T> operator*(const std::vector<T>& x) const;
+  [[nodiscard]] S21BasicMatrix<T> operator*(
+      const S21BasicMatrix<T>& dense) const;
+  [[nodiscard]] S21BasicSparseMatrix operator*(
+      const S21BasicSparseMatrix& other) const;
+  S21BasicSparseMatrix& operator+=(const S21BasicSparseMatrix& other);
+  S21BasicSparseMatrix& operator-=(const S21BasicSparseMatrix& other);
+  S21BasicSparseMatrix& operator*=(const T number);
+  // Returns zero for positions that are not stored.
+  [[nodiscard]] T operator()(int row, int column) const;
+
+  [[nodiscard]] int GetRows() const noexcept;
+  [[nodiscard]] int GetCols() const noexcept;
+  [[nodiscard]] SparseFormat GetFormat() const noexcept;
+  [[nodiscard]] std::size_t NonZeros() const noexcept;
+
+  [[nodiscard]] const std::vector<std::size_t>& offsets() const noexcept;
+  [[nodiscard]] const std::vector<int>& indices() const noexcept;
+  [[nodiscard]] const std::vector<T>& values() const noexcept;
+
+ private:
+  [[nodiscard]] int MajorCount() const noexcept;
+  [[nodiscard]] int MinorCount() const noexcept;
+  template <typename Operation>
+  void Merge(const S21BasicSparseMatrix& other, Operation operation);
+
+  int rows_;
+  int cols_;
+  SparseFormat format_;
+  std::vector<std::size_t> offsets_;
+  std::vector<int> indices_;
+  std::vector<T> values_;
+};
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_SPARSE_MATRIX_H_
@@ -0,0 +1,167 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+
+namespace s21 {
+namespace {
+thread_local bool is_pool_worker{false};
+std::atomic<int> requested_threads{0};
+
+int DefaultThreadCount() {
+  static const int default_count{[] {
+    if (const char* env{std::getenv("S21_NUM_THREADS")}) {
+      const int value{std::atoi(env)};
+      if (value > 0) return value;
+    }
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }()};
+
+  return default_count;
+}
+
+struct ParallelForState {
+  ParallelForState(int total, const std::function<void(int)>& function)
+      : count{total}, body{function} {}
+
+  const int count;
+  const std::function<void(int)>& body;
+  std::atomic<int> next{0};
+  std::atomic<int> completed{0};
+  std::mutex mutex;
+  std::condition_variable done;
+  std::exception_ptr error;
+};
+
+void RunItems(ParallelForState& state) {
+  for (int i{state.next++}; i < state.count; i = state.next++) {
+    try {
+      state.body(i);
+    } catch (...) {
+      std::lock_guard lock{state.mutex};
+      if (!state.error) state.error = std::current_exception();
+    }
+
+    if (++state.completed == state.count) {
+      std::lock_guard lock{state.mutex};
+      state.done.notify_all();
+    }
+  }
+}
+}  // namespace
+
+ThreadPool::ThreadPool(int num_workers) {
+  for (int i{0}; i < num_workers; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  for (int i{0}; i < num_workers; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock{sleep_mutex_};
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int)>& body,
+                             int num_threads) {
+  if (count <= 0) return;
+
+  const int runners{std::min({num_threads, count, GetWorkerCount() + 1})};
+  if (runners <= 1 || is_pool_worker) {
+    for (int i{0}; i < count; ++i) {
+      body(i);
+    }
+    return;
+  }
+
+  auto state{std::make_shared<ParallelForState>(count, body)};
+  for (int i{1}; i < runners; ++i) {
+    Submit([state] { RunItems(*state); });
+  }
+  RunItems(*state);
+
+  std::unique_lock lock{state->mutex};
+  state->done.wait(lock,
+                   [&state] { return state->completed == state->count; });
+  if (state->error) std::rethrow_exception(state->error);
+}
+
+[[nodiscard]] int ThreadPool::GetWorkerCount() const {
+  return static_cast<int>(workers_.size());
+}
+
+[[nodiscard]] ThreadPool& ThreadPool::Global() {
+  static ThreadPool pool{std::max(DefaultThreadCount(), GetNumThreads()) - 1};
+  return pool;
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+  ++pending_;
+  WorkerQueue& queue{*queues_[next_queue_++ % queues_.size()]};
+  {
+    std::lock_guard lock{queue.mutex};
+    queue.tasks.push_back(std::move(task));
+  }
+  {
+    // Pairs with the predicate check in WorkerLoop so that a worker about to
+    // sleep cannot miss this wake-up.
+    std::lock_guard lock{sleep_mutex_};
+  }
+  wake_.notify_one();
+}
+
+bool ThreadPool::TryPop(int worker, std::function<void()>& task) {
+  const int queue_count{static_cast<int>(queues_.size())};
+  for (int offset{0}; offset < queue_count; ++offset) {
+    WorkerQueue& queue{*queues_[(worker + offset) % queue_count]};
+    std::lock_guard lock{queue.mutex};
+    if (queue.tasks.empty()) continue;
+
+    if (offset == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    --pending_;
+    return true;
+  }
+
+  return false;
+}
+
+void ThreadPool::WorkerLoop(int worker) {
+  is_pool_worker = true;
+  std::function<void()> task;
+  while (true) {
+    if (TryPop(worker, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock lock{sleep_mutex_};
+    wake_.wait(lock, [this] { return stopping_ || pending_ > 0; });
+    if (stopping_ && pending_ == 0) return;
+  }
+}
+
+void SetNumThreads(int num_threads) {
+  requested_threads = std::max(0, num_threads);
+}
+
+[[nodiscard]] int GetNumThreads() {
+  const int requested{requested_threads};
+  return requested > 0 ? requested : DefaultThreadCount();
+}
+}  // namespace s21
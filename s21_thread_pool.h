@@ -0,0 +1,62 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_THREAD_POOL_H_
+#define CPP1_S21_MATRIXPLUS_S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_workers);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  // Calls body(i) for every i in [0, count) on up to num_threads threads,
+  // the calling thread included, and returns once all calls have finished.
+  // The pool never grows, so at most GetWorkerCount() + 1 threads run no
+  // matter how large num_threads is. The first exception thrown by body is
+  // rethrown here.
+  void ParallelFor(int count, const std::function<void(int)>& body,
+                   int num_threads);
+
+  [[nodiscard]] int GetWorkerCount() const;
+
+  // Created on first use with one worker less than the larger of the
+  // default thread count and GetNumThreads() at that time.
+  [[nodiscard]] static ThreadPool& Global();
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void Submit(std::function<void()> task);
+  bool TryPop(int worker, std::function<void()>& task);
+  void WorkerLoop(int worker);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<int> pending_{0};
+  std::atomic<unsigned> next_queue_{0};
+  bool stopping_{false};
+};
+
+// Default number of threads used by parallel kernels. Zero restores the
+// default taken from S21_NUM_THREADS or std::thread::hardware_concurrency().
+// Kernels run on ThreadPool::Global(), so a count set after its first use
+// takes effect only up to the size of that pool.
+void SetNumThreads(int num_threads);
+[[nodiscard]] int GetNumThreads();
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_THREAD_POOL_H_
@@ -0,0 +1,935 @@
+#include "s21_tiled_matrix.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "s21_matrix_kernels.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+namespace {
+// File layout: a header padded to one page, then the tiles. Header fields
+// are at the offsets below.
+constexpr std::size_t kTiledHeaderSize{4096};
+constexpr char kTiledMagic[8]{'S', '2', '1', 'T', 'I', 'L', 'E', 'D'};
+constexpr std::uint32_t kTiledVersion{1};
+constexpr std::size_t kVersionOffset{8};
+constexpr std::size_t kElementSizeOffset{12};
+constexpr std::size_t kRowsOffset{16};
+constexpr std::size_t kColsOffset{24};
+constexpr std::size_t kTileSizeOffset{32};
+
+// Prefetch requests beyond this many are dropped.
+constexpr std::size_t kMaxQueuedPrefetches{64};
+
+[[noreturn]] void ThrowSystemError(const std::string& function,
+                                   const std::string& description,
+                                   const std::string& path) {
+  throw std::system_error{errno, std::generic_category(),
+                          function + ": " + description + " " + path};
+}
+
+[[nodiscard]] int TileCount(int size, int tile_size) {
+  return (size + tile_size - 1) / tile_size;
+}
+}  // namespace
+
+// Thread-safe cache of the tiles of one file. Pinned tiles stay resident;
+// the least recently used unpinned ones are written back if modified and
+// evicted once more than capacity tiles are resident.
+template <typename T>
+class TileCache {
+ public:
+  enum class Access {
+    kRead,
+    kWrite,
+    // The caller overwrites the whole tile, so a tile that is not resident
+    // is zero-filled instead of read.
+    kOverwrite
+  };
+
+  class Pinned {
+   public:
+    Pinned(TileCache* cache, std::size_t index, T* data) noexcept
+        : cache_{cache}, index_{index}, data_{data} {}
+    Pinned(Pinned&& other) noexcept
+        : cache_{std::exchange(other.cache_, nullptr)},
+          index_{other.index_},
+          data_{other.data_} {}
+    Pinned& operator=(Pinned&&) = delete;
+    ~Pinned() {
+      if (cache_ != nullptr) cache_->Unpin(index_);
+    }
+
+    [[nodiscard]] T* data() const noexcept { return data_; }
+
+   private:
+    TileCache* cache_;
+    std::size_t index_;
+    T* data_;
+  };
+
+  TileCache(std::string path, int descriptor, int tile_size,
+            std::size_t capacity);
+  TileCache(const TileCache&) = delete;
+  TileCache& operator=(const TileCache&) = delete;
+  // Stops prefetching and closes the file without writing back.
+  ~TileCache();
+
+  [[nodiscard]] Pinned Pin(std::size_t index, Access access);
+  // Asks the background thread to load the tile.
+  void Prefetch(std::size_t index);
+  void Flush();
+
+  [[nodiscard]] int GetTileSize() const noexcept;
+  [[nodiscard]] TileCacheStatistics GetStatistics() const;
+
+ private:
+  struct Tile {
+    S21BasicMatrix<T> elements{1, 1};
+    int pins{0};
+    bool loading{false};
+    bool dirty{false};
+    std::exception_ptr error;
+    std::list<std::size_t>::iterator position;
+  };
+
+  [[nodiscard]] T* Acquire(std::size_t index, Access access);
+  void Unpin(std::size_t index) noexcept;
+  void UnpinLocked(std::size_t index) noexcept;
+  void EvictLocked();
+  void ReadTile(std::size_t index, T* data) const;
+  void WriteTile(std::size_t index, const T* data) const;
+  [[nodiscard]] off_t TileOffset(std::size_t index) const;
+  void PrefetchLoop();
+
+  const std::string path_;
+  const int descriptor_;
+  const int tile_size_;
+  const std::size_t tile_bytes_;
+  const std::size_t capacity_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable loaded_;
+  std::unordered_map<std::size_t, Tile> tiles_;
+  // Resident tiles, most recently used first.
+  std::list<std::size_t> recency_;
+  TileCacheStatistics statistics_{};
+
+  std::mutex prefetch_mutex_;
+  std::condition_variable prefetch_ready_;
+  std::deque<std::size_t> prefetch_queue_;
+  bool stopping_{false};
+  std::thread prefetcher_;
+};
+
+template <typename T>
+TileCache<T>::TileCache(std::string path, int descriptor, int tile_size,
+                        std::size_t capacity)
+    : path_{std::move(path)},
+      descriptor_{descriptor},
+      tile_size_{tile_size},
+      tile_bytes_{static_cast<std::size_t>(tile_size) * tile_size *
+                  sizeof(T)},
+      capacity_{std::max<std::size_t>(1, capacity)},
+      prefetcher_{&TileCache::PrefetchLoop, this} {}
+
+template <typename T>
+TileCache<T>::~TileCache() {
+  {
+    std::lock_guard lock{prefetch_mutex_};
+    stopping_ = true;
+  }
+  prefetch_ready_.notify_all();
+  prefetcher_.join();
+  ::close(descriptor_);
+}
+
+template <typename T>
+[[nodiscard]] typename TileCache<T>::Pinned TileCache<T>::Pin(
+    std::size_t index, Access access) {
+  return {this, index, Acquire(index, access)};
+}
+
+template <typename T>
+void TileCache<T>::Prefetch(std::size_t index) {
+  {
+    std::lock_guard lock{prefetch_mutex_};
+    if (prefetch_queue_.size() >= kMaxQueuedPrefetches) return;
+    prefetch_queue_.push_back(index);
+  }
+  prefetch_ready_.notify_one();
+}
+
+template <typename T>
+void TileCache<T>::Flush() {
+  std::lock_guard lock{mutex_};
+  for (auto& [index, tile] : tiles_) {
+    if (tile.loading || !tile.dirty) continue;
+    WriteTile(index, tile.elements.data());
+    tile.dirty = false;
+    ++statistics_.write_backs;
+  }
+}
+
+template <typename T>
+[[nodiscard]] int TileCache<T>::GetTileSize() const noexcept {
+  return tile_size_;
+}
+
+template <typename T>
+[[nodiscard]] TileCacheStatistics TileCache<T>::GetStatistics() const {
+  std::lock_guard lock{mutex_};
+  return statistics_;
+}
+
+template <typename T>
+[[nodiscard]] T* TileCache<T>::Acquire(std::size_t index, Access access) {
+  std::unique_lock lock{mutex_};
+  auto [entry, inserted] = tiles_.try_emplace(index);
+  Tile& tile{entry->second};
+  ++tile.pins;
+
+  if (!inserted) {
+    loaded_.wait(lock, [&tile] { return !tile.loading; });
+    if (tile.error) {
+      const std::exception_ptr error{tile.error};
+      UnpinLocked(index);
+      std::rethrow_exception(error);
+    }
+    ++statistics_.hits;
+    recency_.splice(recency_.begin(), recency_, tile.position);
+    if (access != Access::kRead) tile.dirty = true;
+    return tile.elements.data();
+  }
+
+  // Other threads wait on loading, so the tile is filled without the lock.
+  ++statistics_.misses;
+  tile.loading = true;
+  recency_.push_front(index);
+  tile.position = recency_.begin();
+  statistics_.peak_resident_tiles =
+      std::max(statistics_.peak_resident_tiles, tiles_.size());
+  lock.unlock();
+
+  std::exception_ptr error;
+  try {
+    S21BasicMatrix<T> elements{tile_size_, tile_size_, ThreadLocalPool()};
+    if (access != Access::kOverwrite) ReadTile(index, elements.data());
+    tile.elements = std::move(elements);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  lock.lock();
+  tile.loading = false;
+  tile.dirty = access != Access::kRead;
+  tile.error = error;
+  loaded_.notify_all();
+  if (error) {
+    UnpinLocked(index);
+    std::rethrow_exception(error);
+  }
+
+  try {
+    EvictLocked();
+  } catch (...) {
+    UnpinLocked(index);
+    throw;
+  }
+  return tile.elements.data();
+}
+
+template <typename T>
+void TileCache<T>::Unpin(std::size_t index) noexcept {
+  std::lock_guard lock{mutex_};
+  UnpinLocked(index);
+}
+
+// Tiles that failed to load are dropped with their last pin, so that the
+// next access retries.
+template <typename T>
+void TileCache<T>::UnpinLocked(std::size_t index) noexcept {
+  const auto entry{tiles_.find(index)};
+  Tile& tile{entry->second};
+  if (--tile.pins == 0 && tile.error) {
+    recency_.erase(tile.position);
+    tiles_.erase(entry);
+  }
+}
+
+template <typename T>
+void TileCache<T>::EvictLocked() {
+  auto position{recency_.end()};
+  while (tiles_.size() > capacity_ && position != recency_.begin()) {
+    --position;
+    const auto entry{tiles_.find(*position)};
+    Tile& tile{entry->second};
+    if (tile.pins > 0 || tile.loading) continue;
+
+    if (tile.dirty) {
+      WriteTile(*position, tile.elements.data());
+      ++statistics_.write_backs;
+    }
+    tiles_.erase(entry);
+    position = recency_.erase(position);
+  }
+}
+
+template <typename T>
+void TileCache<T>::ReadTile(std::size_t index, T* data) const {
+  auto* bytes{reinterpret_cast<char*>(data)};
+  std::size_t done{0};
+  while (done < tile_bytes_) {
+    const ssize_t count{::pread(descriptor_, bytes + done, tile_bytes_ - done,
+                                TileOffset(index) +
+                                    static_cast<off_t>(done))};
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) {
+      if (count == 0) errno = EIO;
+      ThrowSystemError("TileCache::ReadTile(size_t, T*)",
+                       "Cannot read tile.", path_);
+    }
+    done += static_cast<std::size_t>(count);
+  }
+}
+
+template <typename T>
+void TileCache<T>::WriteTile(std::size_t index, const T* data) const {
+  const auto* bytes{reinterpret_cast<const char*>(data)};
+  std::size_t done{0};
+  while (done < tile_bytes_) {
+    const ssize_t count{::pwrite(descriptor_, bytes + done,
+                                 tile_bytes_ - done,
+                                 TileOffset(index) +
+                                     static_cast<off_t>(done))};
+    if (count < 0 && errno == EINTR) continue;
+    if (count < 0) {
+      ThrowSystemError("TileCache::WriteTile(size_t, const T*)",
+                       "Cannot write tile.", path_);
+    }
+    done += static_cast<std::size_t>(count);
+  }
+}
+
+template <typename T>
+[[nodiscard]] off_t TileCache<T>::TileOffset(std::size_t index) const {
+  return static_cast<off_t>(kTiledHeaderSize + index * tile_bytes_);
+}
+
+template <typename T>
+void TileCache<T>::PrefetchLoop() {
+  for (;;) {
+    std::size_t index{};
+    {
+      std::unique_lock lock{prefetch_mutex_};
+      prefetch_ready_.wait(
+          lock, [this] { return stopping_ || !prefetch_queue_.empty(); });
+      if (stopping_) return;
+      index = prefetch_queue_.front();
+      prefetch_queue_.pop_front();
+    }
+
+    {
+      std::lock_guard lock{mutex_};
+      if (tiles_.count(index) != 0) continue;
+    }
+    // Errors surface when the tile is used.
+    try {
+      const Pinned pinned{Pin(index, Access::kRead)};
+    } catch (...) {
+    }
+  }
+}
+
+namespace {
+template <typename T>
+[[nodiscard]] std::unique_ptr<TileCache<T>> CreateTileFile(
+    const std::string& path, int rows, int cols,
+    const TiledMatrixOptions& options) {
+  const std::string function{
+      "TiledMatrix::TiledMatrix(const string&, int, int, "
+      "const TiledMatrixOptions&)"};
+  if (rows <= 0 || cols <= 0 || options.tile_size <= 0) {
+    throw std::invalid_argument{
+        function +
+        ": Matrix has improper dimensions. "
+        "Rows, columns and the tile size must be greater than zero."};
+  }
+
+  const int tile_size{options.tile_size};
+  const std::size_t tile_bytes{static_cast<std::size_t>(tile_size) *
+                               tile_size * sizeof(T)};
+  const std::size_t tile_count{
+      static_cast<std::size_t>(TileCount(rows, tile_size)) *
+      TileCount(cols, tile_size)};
+
+  char header[kTiledHeaderSize]{};
+  const std::uint32_t element_size{sizeof(T)};
+  const std::int64_t fields[]{rows, cols, tile_size};
+  std::memcpy(header, kTiledMagic, sizeof(kTiledMagic));
+  std::memcpy(header + kVersionOffset, &kTiledVersion, sizeof(kTiledVersion));
+  std::memcpy(header + kElementSizeOffset, &element_size,
+              sizeof(element_size));
+  std::memcpy(header + kRowsOffset, &fields[0], sizeof(std::int64_t));
+  std::memcpy(header + kColsOffset, &fields[1], sizeof(std::int64_t));
+  std::memcpy(header + kTileSizeOffset, &fields[2], sizeof(std::int64_t));
+
+  const int descriptor{
+      ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+  if (descriptor < 0) ThrowSystemError(function, "Cannot open file.", path);
+  // Tiles that are never written read back as zeros.
+  if (::pwrite(descriptor, header, kTiledHeaderSize, 0) !=
+          static_cast<ssize_t>(kTiledHeaderSize) ||
+      ::ftruncate(descriptor, static_cast<off_t>(kTiledHeaderSize +
+                                                 tile_count * tile_bytes)) !=
+          0) {
+    const int error{errno};
+    ::close(descriptor);
+    errno = error;
+    ThrowSystemError(function, "Cannot write file.", path);
+  }
+
+  return std::make_unique<TileCache<T>>(path, descriptor, tile_size,
+                                        options.cache_bytes / tile_bytes);
+}
+}  // namespace
+
+template <typename T>
+TiledMatrix<T>::TiledMatrix(const std::string& path, int rows, int cols,
+                            const TiledMatrixOptions& options)
+    : TiledMatrix{CreateTileFile<T>(path, rows, cols, options), rows, cols,
+                  options} {}
+
+template <typename T>
+TiledMatrix<T>::TiledMatrix(std::unique_ptr<TileCache<T>> cache, int rows,
+                            int cols, const TiledMatrixOptions& options)
+    : rows_{rows},
+      cols_{cols},
+      tile_rows_{TileCount(rows, cache->GetTileSize())},
+      tile_cols_{TileCount(cols, cache->GetTileSize())},
+      options_{options},
+      cache_{std::move(cache)} {
+  options_.tile_size = cache_->GetTileSize();
+  if (options_.num_threads <= 0) options_.num_threads = GetNumThreads();
+}
+
+template <typename T>
+TiledMatrix<T>::TiledMatrix(TiledMatrix&& other) noexcept = default;
+
+template <typename T>
+TiledMatrix<T>& TiledMatrix<T>::operator=(TiledMatrix&& other) noexcept {
+  if (this == &other) return *this;
+
+  if (cache_ != nullptr) {
+    try {
+      cache_->Flush();
+    } catch (...) {
+    }
+  }
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  tile_rows_ = other.tile_rows_;
+  tile_cols_ = other.tile_cols_;
+  options_ = other.options_;
+  cache_ = std::move(other.cache_);
+
+  return *this;
+}
+
+template <typename T>
+TiledMatrix<T>::~TiledMatrix() {
+  if (cache_ == nullptr) return;
+
+  try {
+    cache_->Flush();
+  } catch (...) {
+  }
+}
+
+template <typename T>
+[[nodiscard]] TiledMatrix<T> TiledMatrix<T>::Open(
+    const std::string& path, const TiledMatrixOptions& options) {
+  const std::string function{
+      "TiledMatrix::Open(const string&, const TiledMatrixOptions&)"};
+  const int descriptor{::open(path.c_str(), O_RDWR | O_CLOEXEC)};
+  if (descriptor < 0) ThrowSystemError(function, "Cannot open file.", path);
+
+  char header[kTiledHeaderSize];
+  std::uint32_t version{0};
+  std::uint32_t element_size{0};
+  std::int64_t rows{0};
+  std::int64_t cols{0};
+  std::int64_t tile_size{0};
+  const bool complete{::pread(descriptor, header, kTiledHeaderSize, 0) ==
+                      static_cast<ssize_t>(kTiledHeaderSize)};
+  std::memcpy(&version, header + kVersionOffset, sizeof(version));
+  std::memcpy(&element_size, header + kElementSizeOffset,
+              sizeof(element_size));
+  std::memcpy(&rows, header + kRowsOffset, sizeof(rows));
+  std::memcpy(&cols, header + kColsOffset, sizeof(cols));
+  std::memcpy(&tile_size, header + kTileSizeOffset, sizeof(tile_size));
+  if (!complete ||
+      std::memcmp(header, kTiledMagic, sizeof(kTiledMagic)) != 0 ||
+      version != kTiledVersion || element_size != sizeof(T) || rows <= 0 ||
+      cols <= 0 || tile_size <= 0 || rows > INT_MAX || cols > INT_MAX ||
+      tile_size > INT_MAX) {
+    ::close(descriptor);
+    throw std::runtime_error{function +
+                             ": File is not a tiled matrix of this type. "
+                             "It must be written by a TiledMatrix with the "
+                             "same element type."};
+  }
+
+  const std::size_t tile_bytes{static_cast<std::size_t>(tile_size) *
+                               tile_size * sizeof(T)};
+  return {std::make_unique<TileCache<T>>(path, descriptor,
+                                         static_cast<int>(tile_size),
+                                         options.cache_bytes / tile_bytes),
+          static_cast<int>(rows), static_cast<int>(cols), options};
+}
+
+template <typename T>
+[[nodiscard]] TiledMatrix<T> TiledMatrix<T>::FromView(
+    SubMatrixView<const T> source, const std::string& path,
+    const TiledMatrixOptions& options) {
+  TiledMatrix result{path, source.GetRows(), source.GetCols(), options};
+  result.WriteBlock(0, 0, source);
+  return result;
+}
+
+template <typename T>
+[[nodiscard]] int TiledMatrix<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <typename T>
+[[nodiscard]] int TiledMatrix<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <typename T>
+[[nodiscard]] int TiledMatrix<T>::GetTileSize() const noexcept {
+  return options_.tile_size;
+}
+
+template <typename T>
+[[nodiscard]] TileCacheStatistics TiledMatrix<T>::GetCacheStatistics() const {
+  return cache_->GetStatistics();
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> TiledMatrix<T>::ReadBlock(int row, int column,
+                                                          int rows,
+                                                          int cols) const {
+  if (row < 0 || column < 0 || rows <= 0 || cols <= 0 ||
+      row + rows > rows_ || column + cols > cols_) {
+    throw std::out_of_range{
+        "TiledMatrix::ReadBlock(int, int, int, int): Block is out of range. "
+        "It must be non-empty and lie within the matrix."};
+  }
+
+  const int tile_size{options_.tile_size};
+  S21BasicMatrix<T> block{rows, cols};
+  for (int tile_row{row / tile_size};
+       tile_row <= (row + rows - 1) / tile_size; ++tile_row) {
+    for (int tile_col{column / tile_size};
+         tile_col <= (column + cols - 1) / tile_size; ++tile_col) {
+      const typename TileCache<T>::Pinned tile{cache_->Pin(
+          TileIndex(tile_row, tile_col), TileCache<T>::Access::kRead)};
+      const int first_row{std::max(row, tile_row * tile_size)};
+      const int last_row{std::min(row + rows, (tile_row + 1) * tile_size)};
+      const int first_col{std::max(column, tile_col * tile_size)};
+      const int last_col{std::min(column + cols, (tile_col + 1) * tile_size)};
+      for (int i{first_row}; i < last_row; ++i) {
+        std::copy_n(tile.data() +
+                        static_cast<std::ptrdiff_t>(i - tile_row * tile_size) *
+                            tile_size +
+                        (first_col - tile_col * tile_size),
+                    last_col - first_col,
+                    &block.AtUnchecked(i - row, first_col - column));
+      }
+    }
+  }
+
+  return block;
+}
+
+template <typename T>
+void TiledMatrix<T>::WriteBlock(int row, int column,
+                                SubMatrixView<const T> block) {
+  if (row < 0 || column < 0 || row + block.GetRows() > rows_ ||
+      column + block.GetCols() > cols_) {
+    throw std::out_of_range{
+        "TiledMatrix::WriteBlock(int, int, SubMatrixView): Block is out of "
+        "range. "
+        "It must lie within the matrix."};
+  }
+
+  const int tile_size{options_.tile_size};
+  const int rows{block.GetRows()};
+  const int cols{block.GetCols()};
+  for (int tile_row{row / tile_size};
+       tile_row <= (row + rows - 1) / tile_size; ++tile_row) {
+    for (int tile_col{column / tile_size};
+         tile_col <= (column + cols - 1) / tile_size; ++tile_col) {
+      const int first_row{std::max(row, tile_row * tile_size)};
+      const int last_row{std::min(row + rows, (tile_row + 1) * tile_size)};
+      const int first_col{std::max(column, tile_col * tile_size)};
+      const int last_col{std::min(column + cols, (tile_col + 1) * tile_size)};
+      // Tiles the block covers up to the edge of the matrix need no read;
+      // their padding stays zero.
+      const bool covered{
+          first_row == tile_row * tile_size &&
+          last_row == std::min(rows_, (tile_row + 1) * tile_size) &&
+          first_col == tile_col * tile_size &&
+          last_col == std::min(cols_, (tile_col + 1) * tile_size)};
+      const typename TileCache<T>::Pinned tile{
+          cache_->Pin(TileIndex(tile_row, tile_col),
+                      covered ? TileCache<T>::Access::kOverwrite
+                              : TileCache<T>::Access::kWrite)};
+      for (int i{first_row}; i < last_row; ++i) {
+        std::copy_n(&block(i - row, first_col - column), last_col - first_col,
+                    tile.data() +
+                        static_cast<std::ptrdiff_t>(i - tile_row * tile_size) *
+                            tile_size +
+                        (first_col - tile_col * tile_size));
+      }
+    }
+  }
+}
+
+template <typename T>
+[[nodiscard]] S21BasicMatrix<T> TiledMatrix<T>::ToMatrix() const {
+  return ReadBlock(0, 0, rows_, cols_);
+}
+
+template <typename T>
+void TiledMatrix<T>::Flush() {
+  cache_->Flush();
+}
+
+template <typename T>
+[[nodiscard]] TiledMatrix<T> TiledMatrix<T>::Add(
+    const TiledMatrix& other, const std::string& path) const {
+  const std::string function{
+      "TiledMatrix::Add(const TiledMatrix&, const string&)"};
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument{
+        function +
+        ": Matrix dimensions are not compatible for addition. "
+        "Both matrices must have the same number of rows and columns."};
+  }
+  CheckTileSize(other, function);
+
+  using Access = typename TileCache<T>::Access;
+  const std::size_t tile_elements{static_cast<std::size_t>(
+                                      options_.tile_size) *
+                                  options_.tile_size};
+  const std::size_t tile_count{static_cast<std::size_t>(tile_rows_) *
+                               tile_cols_};
+  TiledMatrix result{path, rows_, cols_, options_};
+  for (std::size_t index{0}; index < tile_count; ++index) {
+    if (index + 1 < tile_count) {
+      cache_->Prefetch(index + 1);
+      other.cache_->Prefetch(index + 1);
+    }
+    const typename TileCache<T>::Pinned left{
+        cache_->Pin(index, Access::kRead)};
+    const typename TileCache<T>::Pinned right{
+        other.cache_->Pin(index, Access::kRead)};
+    const typename TileCache<T>::Pinned sum{
+        result.cache_->Pin(index, Access::kOverwrite)};
+    std::copy_n(left.data(), tile_elements, sum.data());
+    kernels::Add(tile_elements, right.data(), sum.data());
+  }
+
+  return result;
+}
+
+template <typename T>
+[[nodiscard]] TiledMatrix<T> TiledMatrix<T>::Multiply(
+    const TiledMatrix& other, const std::string& path) const {
+  const std::string function{
+      "TiledMatrix::Multiply(const TiledMatrix&, const string&)"};
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument{
+        function +
+        ": Matrix dimensions are not compatible for multiplication. "
+        "Number of columns in the first matrix must be equal to the number "
+        "of rows in the second matrix."};
+  }
+  CheckTileSize(other, function);
+
+  using Access = typename TileCache<T>::Access;
+  const int tile_size{options_.tile_size};
+  const int inner_tiles{tile_cols_};
+  TiledMatrix result{path, rows_, other.cols_, options_};
+  for (int i{0}; i < result.tile_rows_; ++i) {
+    for (int j{0}; j < result.tile_cols_; ++j) {
+      const typename TileCache<T>::Pinned product{
+          result.cache_->Pin(result.TileIndex(i, j), Access::kOverwrite)};
+      std::fill_n(product.data(),
+                  static_cast<std::size_t>(tile_size) * tile_size, T{});
+      for (int k{0}; k < inner_tiles; ++k) {
+        // The next pair: along k, then the first of the next output tile.
+        if (k + 1 < inner_tiles) {
+          cache_->Prefetch(TileIndex(i, k + 1));
+          other.cache_->Prefetch(other.TileIndex(k + 1, j));
+        } else if (j + 1 < result.tile_cols_) {
+          other.cache_->Prefetch(other.TileIndex(0, j + 1));
+        } else if (i + 1 < result.tile_rows_) {
+          cache_->Prefetch(TileIndex(i + 1, 0));
+          other.cache_->Prefetch(other.TileIndex(0, 0));
+        }
+
+        const typename TileCache<T>::Pinned left{
+            cache_->Pin(TileIndex(i, k), Access::kRead)};
+        const typename TileCache<T>::Pinned right{
+            other.cache_->Pin(other.TileIndex(k, j), Access::kRead)};
+        kernels::Gemm(tile_size, tile_size, tile_size, left.data(),
+                      tile_size, right.data(), tile_size, product.data(),
+                      tile_size, options_.num_threads);
+      }
+    }
+  }
+
+  return result;
+}
+
+template <typename T>
+[[nodiscard]] TiledMatrix<T> TiledMatrix<T>::Transpose(
+    const std::string& path) const {
+  using Access = typename TileCache<T>::Access;
+  const int tile_size{options_.tile_size};
+  const std::size_t tile_count{static_cast<std::size_t>(tile_rows_) *
+                               tile_cols_};
+  TiledMatrix result{path, cols_, rows_, options_};
+  for (std::size_t index{0}; index < tile_count; ++index) {
+    if (index + 1 < tile_count) cache_->Prefetch(index + 1);
+    const int i{static_cast<int>(index / tile_cols_)};
+    const int j{static_cast<int>(index % tile_cols_)};
+    const typename TileCache<T>::Pinned source{
+        cache_->Pin(index, Access::kRead)};
+    const typename TileCache<T>::Pinned destination{
+        result.cache_->Pin(result.TileIndex(j, i), Access::kOverwrite)};
+    kernels::Transpose(tile_size, tile_size, source.data(), tile_size,
+                       destination.data(), tile_size);
+  }
+
+  return result;
+}
+
+template <typename T>
+TiledLUResult TiledMatrix<T>::LUDecomposeInPlace() {
+  return LUDecomposeInPlace(ScalarTraits<T>::PivotTolerance(rows_));
+}
+
+template <typename T>
+TiledLUResult TiledMatrix<T>::LUDecomposeInPlace(double tolerance) {
+  if (rows_ != cols_) {
+    throw std::invalid_argument{
+        "TiledMatrix::LUDecomposeInPlace(): Matrix dimensions are not "
+        "compatible for LU decomposition. "
+        "The matrix must be square."};
+  }
+
+  using Access = typename TileCache<T>::Access;
+  using Pinned = typename TileCache<T>::Pinned;
+  using Real = typename ScalarTraits<T>::Real;
+  const int size{rows_};
+  const int tile_size{options_.tile_size};
+  const int tiles{tile_rows_};
+  const std::size_t tile_elements{static_cast<std::size_t>(tile_size) *
+                                  tile_size};
+
+  TiledLUResult result{std::vector<int>(static_cast<std::size_t>(size)), 1,
+                       false};
+  std::iota(result.permutation.begin(), result.permutation.end(), 0);
+
+  // Largest element of every row, swapped along with the rows as in
+  // LUDecomposition.
+  std::vector<Real> thresholds(static_cast<std::size_t>(size));
+  const std::size_t tile_count{static_cast<std::size_t>(tiles) * tiles};
+  for (std::size_t index{0}; index < tile_count; ++index) {
+    if (index + 1 < tile_count) cache_->Prefetch(index + 1);
+    const Pinned tile{cache_->Pin(index, Access::kRead)};
+    const int first_row{static_cast<int>(index / tiles) * tile_size};
+    const int row_count{std::min(tile_size, size - first_row)};
+    for (int i{0}; i < row_count; ++i) {
+      const T* row{tile.data() + static_cast<std::ptrdiff_t>(i) * tile_size};
+      Real& threshold{thresholds[first_row + i]};
+      for (int j{0}; j < tile_size; ++j) {
+        threshold = std::max(threshold, std::abs(row[j]));
+      }
+    }
+  }
+  for (Real& threshold : thresholds) {
+    threshold *= static_cast<Real>(tolerance);
+  }
+
+  std::vector<T> negated(tile_elements);
+  for (int k{0}; k < tiles; ++k) {
+    const int first{k * tile_size};
+    const int width{std::min(tile_size, size - first)};
+    std::vector<int> pivots(static_cast<std::size_t>(width));
+
+    // Unblocked factorization of the column of tiles k, the same steps as
+    // LUDecomposition restricted to the panel.
+    {
+      std::vector<Pinned> panel;
+      for (int i{k}; i < tiles; ++i) {
+        panel.push_back(cache_->Pin(TileIndex(i, k), Access::kWrite));
+      }
+      const auto row_of{[&](int row) {
+        return panel[row / tile_size - k].data() +
+               static_cast<std::ptrdiff_t>(row % tile_size) * tile_size;
+      }};
+
+      for (int c{0}; c < width; ++c) {
+        const int column{first + c};
+        int pivot_row{column};
+        for (int i{column + 1}; i < size; ++i) {
+          if (std::abs(row_of(i)[c]) > std::abs(row_of(pivot_row)[c])) {
+            pivot_row = i;
+          }
+        }
+
+        pivots[c] = pivot_row;
+        T* pivot{row_of(column)};
+        if (pivot_row != column) {
+          std::swap_ranges(pivot, pivot + tile_size, row_of(pivot_row));
+          std::swap(result.permutation[column],
+                    result.permutation[pivot_row]);
+          std::swap(thresholds[column], thresholds[pivot_row]);
+          result.sign = -result.sign;
+        }
+        if (std::abs(pivot[c]) <= thresholds[column]) result.singular = true;
+        if (pivot[c] == T{}) continue;
+
+        for (int i{column + 1}; i < size; ++i) {
+          T* row{row_of(i)};
+          const T factor{row[c] / pivot[c]};
+          row[c] = factor;
+          if (factor == T{}) continue;
+          for (int j{c + 1}; j < width; ++j) {
+            row[j] -= factor * pivot[j];
+          }
+        }
+      }
+    }
+
+    // The panel's row swaps, applied to the other columns of tiles.
+    for (int j{0}; j < tiles; ++j) {
+      if (j == k) continue;
+      for (int c{0}; c < width; ++c) {
+        const int row{first + c};
+        if (pivots[c] == row) continue;
+        const Pinned top{cache_->Pin(TileIndex(row / tile_size, j),
+                                     Access::kWrite)};
+        const Pinned bottom{cache_->Pin(TileIndex(pivots[c] / tile_size, j),
+                                        Access::kWrite)};
+        T* top_row{top.data() +
+                   static_cast<std::ptrdiff_t>(row % tile_size) * tile_size};
+        std::swap_ranges(
+            top_row, top_row + tile_size,
+            bottom.data() +
+                static_cast<std::ptrdiff_t>(pivots[c] % tile_size) *
+                    tile_size);
+      }
+    }
+
+    // Row of tiles of U: solve L(k, k) U(k, j) = A(k, j) for j > k.
+    {
+      const Pinned diagonal{cache_->Pin(TileIndex(k, k), Access::kRead)};
+      for (int j{k + 1}; j < tiles; ++j) {
+        if (j + 1 < tiles) cache_->Prefetch(TileIndex(k, j + 1));
+        const Pinned block{cache_->Pin(TileIndex(k, j), Access::kWrite)};
+        for (int r{1}; r < width; ++r) {
+          T* target{block.data() + static_cast<std::ptrdiff_t>(r) * tile_size};
+          for (int p{0}; p < r; ++p) {
+            const T factor{diagonal.data()[r * tile_size + p]};
+            if (factor == T{}) continue;
+            const T* source{block.data() +
+                            static_cast<std::ptrdiff_t>(p) * tile_size};
+            for (int column{0}; column < tile_size; ++column) {
+              target[column] -= factor * source[column];
+            }
+          }
+        }
+      }
+    }
+
+    // Trailing update A(i, j) -= L(i, k) U(k, j) for i, j > k.
+    for (int i{k + 1}; i < tiles; ++i) {
+      {
+        const Pinned lower{cache_->Pin(TileIndex(i, k), Access::kRead)};
+        std::transform(lower.data(), lower.data() + tile_elements,
+                       negated.begin(), [](const T& value) { return -value; });
+      }
+      for (int j{k + 1}; j < tiles; ++j) {
+        if (j + 1 < tiles) {
+          cache_->Prefetch(TileIndex(i, j + 1));
+        } else if (i + 1 < tiles) {
+          cache_->Prefetch(TileIndex(i + 1, k));
+          cache_->Prefetch(TileIndex(i + 1, k + 1));
+        }
+        const Pinned upper{cache_->Pin(TileIndex(k, j), Access::kRead)};
+        const Pinned target{cache_->Pin(TileIndex(i, j), Access::kWrite)};
+        kernels::Gemm(tile_size, tile_size, width, negated.data(), tile_size,
+                      upper.data(), tile_size, target.data(), tile_size,
+                      options_.num_threads);
+      }
+    }
+  }
+
+  return result;
+}
+
+template <typename T>
+[[nodiscard]] std::size_t TiledMatrix<T>::TileIndex(int tile_row,
+                                                    int tile_col) const {
+  return static_cast<std::size_t>(tile_row) * tile_cols_ + tile_col;
+}
+
+template <typename T>
+void TiledMatrix<T>::CheckTileSize(const TiledMatrix& other,
+                                   const std::string& function) const {
+  if (options_.tile_size != other.options_.tile_size) {
+    throw std::invalid_argument{function +
+                                ": Tile sizes differ. "
+                                "Both matrices must use the same tile size."};
+  }
+}
+
+template class TileCache<float>;
+template class TileCache<double>;
+template class TileCache<long double>;
+template class TileCache<std::complex<float>>;
+template class TileCache<std::complex<double>>;
+
+template class TiledMatrix<float>;
+template class TiledMatrix<double>;
+template class TiledMatrix<long double>;
+template class TiledMatrix<std::complex<float>>;
+template class TiledMatrix<std::complex<double>>;
+}  // namespace s21
@@ -0,0 +1,112 @@
+#ifndef CPP1_S21_MATRIXPLUS_S21_TILED_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_S21_TILED_MATRIX_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Out-of-core matrices. A TiledMatrix keeps its elements in a file as
+// square tiles stored one after another, row of tiles by row of tiles,
+// edge tiles padded with zeros. Only a bounded cache of recently used tiles
+// is resident; operations stream tiles through it and prefetch the next
+// ones on a background thread while the current ones are processed. Files
+// use the byte order of the machine that wrote them.
+namespace s21 {
+struct TiledMatrixOptions {
+  int tile_size{256};
+  // Memory for resident tiles. Tiles in use by an operation are never
+  // evicted, so the cache may exceed this briefly when it holds fewer
+  // tiles than an operation needs at once.
+  std::size_t cache_bytes{std::size_t{256} << 20};
+  // Threads for the tile kernels; zero means GetNumThreads().
+  int num_threads{0};
+};
+
+struct TileCacheStatistics {
+  std::size_t hits;
+  // Tiles read from the file, or created without reading.
+  std::size_t misses;
+  std::size_t write_backs;
+  std::size_t peak_resident_tiles;
+};
+
+// PA = LU computed in place: the strictly lower triangle holds L, which
+// has a unit diagonal, and the upper triangle U. Fields as in
+// LUDecomposition.
+struct TiledLUResult {
+  std::vector<int> permutation;
+  int sign;
+  bool singular;
+};
+
+template <typename T>
+class TileCache;
+
+// Instantiated for float, double, long double, std::complex<float> and
+// std::complex<double>. Operations that produce a matrix write it to a new
+// file at the given path; the operands must have the same tile size.
+template <typename T>
+class TiledMatrix {
+ public:
+  // Creates a zero matrix in a new file, replacing any existing one.
+  TiledMatrix(const std::string& path, int rows, int cols,
+              const TiledMatrixOptions& options = {});
+  TiledMatrix(TiledMatrix&& other) noexcept;
+  TiledMatrix& operator=(TiledMatrix&& other) noexcept;
+  TiledMatrix(const TiledMatrix&) = delete;
+  TiledMatrix& operator=(const TiledMatrix&) = delete;
+  // Writes modified tiles back to the file.
+  ~TiledMatrix();
+
+  // Opens a file written by a TiledMatrix; its tile size replaces the one
+  // in options.
+  [[nodiscard]] static TiledMatrix Open(
+      const std::string& path, const TiledMatrixOptions& options = {});
+  // Copies a matrix, e.g. the View() of a MappedMatrix, tile by tile.
+  [[nodiscard]] static TiledMatrix FromView(
+      SubMatrixView<const T> source, const std::string& path,
+      const TiledMatrixOptions& options = {});
+
+  [[nodiscard]] int GetRows() const noexcept;
+  [[nodiscard]] int GetCols() const noexcept;
+  [[nodiscard]] int GetTileSize() const noexcept;
+  [[nodiscard]] TileCacheStatistics GetCacheStatistics() const;
+
+  [[nodiscard]] S21BasicMatrix<T> ReadBlock(int row, int column, int rows,
+                                            int cols) const;
+  void WriteBlock(int row, int column, SubMatrixView<const T> block);
+  [[nodiscard]] S21BasicMatrix<T> ToMatrix() const;
+  void Flush();
+
+  [[nodiscard]] TiledMatrix Add(const TiledMatrix& other,
+                                const std::string& path) const;
+  [[nodiscard]] TiledMatrix Multiply(const TiledMatrix& other,
+                                     const std::string& path) const;
+  [[nodiscard]] TiledMatrix Transpose(const std::string& path) const;
+  // Right-looking blocked LU with partial pivoting. Works best when the
+  // cache holds a column of tiles. Singular by the pivot rule of
+  // LUDecomposition, with tolerance in place of the default when given.
+  TiledLUResult LUDecomposeInPlace();
+  TiledLUResult LUDecomposeInPlace(double tolerance);
+
+ private:
+  TiledMatrix(std::unique_ptr<TileCache<T>> cache, int rows, int cols,
+              const TiledMatrixOptions& options);
+
+  [[nodiscard]] std::size_t TileIndex(int tile_row, int tile_col) const;
+  void CheckTileSize(const TiledMatrix& other,
+                     const std::string& function) const;
+
+  int rows_;
+  int cols_;
+  int tile_rows_;
+  int tile_cols_;
+  TiledMatrixOptions options_;
+  std::unique_ptr<TileCache<T>> cache_;
+};
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_S21_TILED_MATRIX_H_
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../s21_fixed_matrix.h"
+#include "../s21_matrix_batch.h"
+#include "../s21_matrix_kernels.h"
+
+namespace s21 {
+namespace {
+// Not a multiple of any vector width, and more than one task.
+constexpr std::size_t kCount{5003};
+
+template <typename T>
+MatrixBatch<T> RandomBatch(std::size_t count, int rows, int cols,
+                           unsigned seed) {
+  std::mt19937 generator{seed};
+  std::uniform_real_distribution<double> distribution{-2.0, 2.0};
+  MatrixBatch<T> batch{count, rows, cols};
+  for (int i{0}; i < rows; ++i) {
+    for (int j{0}; j < cols; ++j) {
+      T* plane{batch.Plane(i, j)};
+      for (std::size_t index{0}; index < count; ++index) {
+        plane[index] = static_cast<T>(distribution(generator));
+      }
+    }
+  }
+
+  return batch;
+}
+
+// Runs body at every SIMD level the CPU has.
+template <typename Body>
+void ForEachSimdLevel(Body body) {
+  const kernels::SimdLevel detected{kernels::DetectSimdLevel()};
+  for (const kernels::SimdLevel level :
+       {kernels::SimdLevel::kScalar, kernels::SimdLevel::kSse2,
+        kernels::SimdLevel::kAvx2, kernels::SimdLevel::kAvx512}) {
+    if (level > detected) break;
+    kernels::SetSimdLevel(level);
+    body();
+  }
+  kernels::SetSimdLevel(detected);
+}
+}  // namespace
+
+TEST(MatrixBatchTest, LayoutAndAccess) {
+  MatrixBatch<double> batch{3, 2, 3};
+  ASSERT_EQ(batch.GetCount(), 3U);
+  ASSERT_GE(batch.GetPlaneStride(), 3U);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(batch.Plane(1, 2)) % 64, 0U);
+
+  S21Matrix matrix{2, 3};
+  matrix(1, 2) = 5.0;
+  batch.Set(1, matrix);
+  ASSERT_DOUBLE_EQ(batch(1, 1, 2), 5.0);
+  ASSERT_DOUBLE_EQ(batch.Plane(1, 2)[1], 5.0);
+  ASSERT_TRUE(batch.Get(1) == matrix);
+  ASSERT_THROW(static_cast<void>(batch(3, 0, 0)), std::out_of_range);
+  ASSERT_THROW(batch.Set(0, S21Matrix{3, 2}), std::invalid_argument);
+  ASSERT_THROW((MatrixBatch<double>{1, 0, 2}), std::invalid_argument);
+}
+
+TEST(MatrixBatchTest, DeterminantsMatchSingleMatrices) {
+  ForEachSimdLevel([] {
+    for (int size{1}; size <= 5; ++size) {
+      const auto batch{RandomBatch<double>(kCount, size, size, size)};
+      const std::vector<double> determinants{BatchDeterminant(batch, 4)};
+      ASSERT_EQ(determinants.size(), kCount);
+      for (std::size_t index{0}; index < kCount; index += 97) {
+        ASSERT_NEAR(determinants[index], batch.Get(index).Determinant(),
+                    1e-10);
+      }
+    }
+
+    const auto floats{RandomBatch<float>(kCount, 4, 4, 6)};
+    const std::vector<float> determinants{BatchDeterminant(floats)};
+    for (std::size_t index{kCount - 20}; index < kCount; ++index) {
+      ASSERT_NEAR(determinants[index], floats.Get(index).Determinant(), 1e-3);
+    }
+  });
+
+  MatrixBatch<std::int64_t> integers{2, 3, 3};
+  integers.Set(1, S21BasicMatrix<std::int64_t>{S21Matrix{3, 3}});
+  for (int i{0}; i < 3; ++i) integers(0, i, i) = 1000003;
+  ASSERT_EQ(BatchDeterminant(integers)[0],
+            std::int64_t{1000003} * 1000003 * 1000003);
+  ASSERT_EQ(BatchDeterminant(integers)[1], 0);
+  const MatrixBatch<double> rectangular{1, 2, 3};
+  ASSERT_THROW(static_cast<void>(BatchDeterminant(rectangular)),
+               std::invalid_argument);
+}
+
+TEST(MatrixBatchTest, InversesMatchSingleMatricesAndFlagSingular) {
+  ForEachSimdLevel([] {
+    for (int size{1}; size <= 5; ++size) {
+      auto batch{RandomBatch<double>(kCount, size, size, 10 + size)};
+      for (int j{0}; j < size; ++j) batch(kCount - 2, 0, j) = 0.0;
+
+      std::vector<bool> singular;
+      const MatrixBatch<double> inverse{BatchInverse(batch, singular, 3)};
+      ASSERT_TRUE(singular[kCount - 2]);
+      ASSERT_DOUBLE_EQ(inverse(kCount - 2, 0, 0), 0.0);
+      for (std::size_t index{0}; index < kCount; index += 101) {
+        ASSERT_FALSE(singular[index]);
+        const S21Matrix identity{batch.Get(index) * inverse.Get(index)};
+        for (int i{0}; i < size; ++i) {
+          for (int j{0}; j < size; ++j) {
+            ASSERT_NEAR(identity(i, j), i == j ? 1.0 : 0.0, 1e-8);
+          }
+        }
+      }
+      ASSERT_THROW(static_cast<void>(BatchInverse(batch)), std::runtime_error);
+    }
+  });
+
+  MatrixBatch<std::int32_t> integers{1, 2, 2};
+  integers(0, 0, 0) = 4;
+  integers(0, 0, 1) = 7;
+  integers(0, 1, 0) = 2;
+  integers(0, 1, 1) = 6;
+  const MatrixBatch<double> inverse{BatchInverse(integers)};
+  ASSERT_DOUBLE_EQ(inverse(0, 0, 0), 0.6);
+  ASSERT_DOUBLE_EQ(inverse(0, 0, 1), -0.7);
+
+  using Complex = std::complex<double>;
+  MatrixBatch<Complex> complex{1, 1, 1};
+  complex(0, 0, 0) = Complex{0.0, 2.0};
+  const Complex expected{0.0, -0.5};
+  ASSERT_EQ(BatchInverse(complex)(0, 0, 0), expected);
+}
+
+TEST(MatrixBatchTest, SingularityAgreesWithSingleAndFixedMatrices) {
+  using Fixed3x3 = FixedMatrix<double, 3, 3>;
+  const Fixed3x3 sequence{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+  const Fixed3x3 scaled{1e10, 0.0, 0.0, 0.0, 1e-7, 0.0, 0.0, 0.0, 1.0};
+  const Fixed3x3 shrunk{1e-20, 2e-20, 3e-20, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+
+  for (const auto& [fixed, expected] :
+       {std::pair{sequence, true}, std::pair{scaled, false},
+        std::pair{shrunk, true}}) {
+    const S21Matrix matrix{fixed};
+    MatrixBatch<double> batch{1, 3, 3};
+    batch.Set(0, matrix);
+    std::vector<bool> singular;
+    static_cast<void>(BatchInverse(batch, singular));
+    ASSERT_EQ(singular[0], expected);
+    ASSERT_EQ(matrix.LUDecompose().IsSingular(), expected);
+    if (expected) {
+      ASSERT_DOUBLE_EQ(matrix.Determinant(), 0.0);
+      ASSERT_THROW(static_cast<void>(matrix.InverseMatrix()),
+                   std::runtime_error);
+      ASSERT_THROW(static_cast<void>(fixed.InverseMatrix()),
+                   std::runtime_error);
+    } else {
+      ASSERT_TRUE(S21Matrix{fixed.InverseMatrix()}.EqMatrix(
+          matrix.InverseMatrix()));
+    }
+  }
+}
+
+TEST(MatrixBatchTest, ProductsMatchSingleMatrices) {
+  ForEachSimdLevel([] {
+    const auto left{RandomBatch<double>(kCount, 3, 2, 20)};
+    const auto right{RandomBatch<double>(kCount, 2, 4, 21)};
+    const MatrixBatch<double> product{BatchMul(left, right, 4)};
+    ASSERT_EQ(product.GetRows(), 3);
+    ASSERT_EQ(product.GetCols(), 4);
+    for (std::size_t index{0}; index < kCount; index += 89) {
+      ASSERT_TRUE(product.Get(index) == left.Get(index) * right.Get(index));
+    }
+
+    const auto floats{RandomBatch<float>(17, 4, 4, 22)};
+    const MatrixBatch<float> squares{BatchMul(floats, floats)};
+    ASSERT_TRUE(squares.Get(16) == floats.Get(16) * floats.Get(16));
+  });
+
+  ASSERT_THROW(static_cast<void>(BatchMul(MatrixBatch<double>{2, 2, 3},
+                                          MatrixBatch<double>{2, 2, 3})),
+               std::invalid_argument);
+  ASSERT_THROW(static_cast<void>(BatchMul(MatrixBatch<double>{2, 2, 2},
+                                          MatrixBatch<double>{3, 2, 2})),
+               std::invalid_argument);
+}
+}  // namespace s21
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <cstdint>
+#include <type_traits>
+
+#include "../s21_matrix_oop.h"
+
+namespace s21 {
+namespace {
+template <typename T>
+S21BasicMatrix<T> Sequence(int rows, int cols) {
+  S21BasicMatrix<T> matrix{rows, cols};
+  for (int i{0}; i < rows; ++i) {
+    for (int j{0}; j < cols; ++j) {
+      matrix(i, j) = static_cast<T>((i * 7 + j * 3) % 11 - 5);
+    }
+  }
+
+  return matrix;
+}
+}  // namespace
+
+TEST(ElementTypesTest, AliasIsDoubleMatrix) {
+  static_assert(std::is_same_v<S21Matrix, S21BasicMatrix<double>>);
+  static_assert(std::is_same_v<S21Matrix::value_type, double>);
+  static_assert(std::is_same_v<S21BasicMatrix<std::int32_t>::Factor, double>);
+  static_assert(std::is_same_v<S21BasicMatrix<float>::Factor, float>);
+}
+
+TEST(ElementTypesTest, FloatMatchesDouble) {
+  const S21Matrix left{Sequence<double>(37, 29)};
+  const S21Matrix right{Sequence<double>(29, 41)};
+  const S21BasicMatrix<float> left_float{left};
+  const S21BasicMatrix<float> right_float{right};
+
+  const S21Matrix product{left * right};
+  const S21BasicMatrix<float> product_float{left_float * right_float};
+  ASSERT_EQ(S21Matrix{product_float}, product);
+
+  S21BasicMatrix<float> combined{left_float + left_float * 2.0F - left_float};
+  S21BasicMatrix<float> doubled{left_float};
+  doubled.MulNumber(2.0F);
+  ASSERT_EQ(combined, doubled);
+  ASSERT_EQ(left_float.Transpose().Transpose(), left_float);
+
+  S21BasicMatrix<float> square{Sequence<float>(6, 6)};
+  for (int i{0}; i < 6; ++i) {
+    square(i, i) += 20.0F;
+  }
+  const S21BasicMatrix<float> identity{square * square.InverseMatrix()};
+  for (int i{0}; i < 6; ++i) {
+    for (int j{0}; j < 6; ++j) {
+      ASSERT_NEAR(identity(i, j), i == j ? 1.0F : 0.0F, 1e-5F);
+    }
+  }
+  const double determinant{S21Matrix{square}.Determinant()};
+  ASSERT_NEAR(square.Determinant(), determinant, 1e-5 * std::abs(determinant));
+}
+
+TEST(ElementTypesTest, IntegerMatrixIsExact) {
+  S21BasicMatrix<std::int64_t> matrix{3, 3};
+  const std::int64_t values[3][3]{{2, -3, 1}, {2, 0, -1}, {1, 4, 5}};
+  for (int i{0}; i < 3; ++i) {
+    for (int j{0}; j < 3; ++j) {
+      matrix(i, j) = values[i][j];
+    }
+  }
+  ASSERT_EQ(matrix.Determinant(), 49);
+
+  S21BasicMatrix<std::int64_t> zero_pivot{matrix};
+  zero_pivot(0, 0) = 0;
+  ASSERT_EQ(zero_pivot.Determinant(), 49 - 2 * 4);
+
+  const S21BasicMatrix<std::int64_t> complements{matrix.CalcComplements()};
+  ASSERT_EQ(complements(0, 0), 4);
+  ASSERT_EQ(complements(1, 2), -11);
+  ASSERT_EQ(complements(2, 1), 4);
+
+  const S21Matrix inverse{matrix.InverseMatrix()};
+  S21Matrix identity{3, 3};
+  for (int i{0}; i < 3; ++i) {
+    identity(i, i) = 1.0;
+  }
+  ASSERT_EQ(S21Matrix{matrix} * inverse, identity);
+
+  const S21BasicMatrix<std::int32_t> small{Sequence<std::int32_t>(9, 9)};
+  const S21Matrix small_double{Sequence<double>(9, 9)};
+  ASSERT_EQ(small * small,
+            S21BasicMatrix<std::int32_t>{small_double * small_double});
+  S21BasicMatrix<std::int32_t> singular{2, 2};
+  singular(0, 0) = 2;
+  singular(0, 1) = 4;
+  singular(1, 0) = 1;
+  singular(1, 1) = 2;
+  ASSERT_EQ(singular.Determinant(), 0);
+  ASSERT_THROW(static_cast<void>(singular.InverseMatrix()), std::runtime_error);
+}
+
+TEST(ElementTypesTest, ComplexMatrix) {
+  using Complex = std::complex<double>;
+  S21BasicMatrix<Complex> matrix{2, 2};
+  matrix(0, 0) = Complex{1.0, 1.0};
+  matrix(0, 1) = Complex{2.0, 0.0};
+  matrix(1, 0) = Complex{0.0, -1.0};
+  matrix(1, 1) = Complex{3.0, 2.0};
+
+  const Complex determinant{matrix.Determinant()};
+  const Complex expected{Complex{1.0, 1.0} * Complex{3.0, 2.0} -
+                         Complex{2.0, 0.0} * Complex{0.0, -1.0}};
+  ASSERT_NEAR(std::abs(determinant - expected), 0.0, 1e-12);
+
+  S21BasicMatrix<Complex> identity{2, 2};
+  identity(0, 0) = identity(1, 1) = Complex{1.0};
+  ASSERT_EQ(matrix * matrix.InverseMatrix(), identity);
+
+  S21BasicMatrix<Complex> complements{matrix.CalcComplements()};
+  ASSERT_NEAR(std::abs(complements(0, 0) - Complex{3.0, 2.0}), 0.0, 1e-12);
+  ASSERT_NEAR(std::abs(complements(1, 0) - Complex{-2.0, 0.0}), 0.0, 1e-12);
+
+  const Complex rotation{0.0, 1.0};
+  ASSERT_EQ(matrix * rotation * std::conj(rotation), matrix);
+}
+
+TEST(ElementTypesTest, LongDoubleSolve) {
+  S21BasicMatrix<long double> matrix{Sequence<long double>(5, 5)};
+  for (int i{0}; i < 5; ++i) {
+    matrix(i, i) += 12.0L;
+  }
+  S21BasicMatrix<long double> b{5, 1};
+  for (int i{0}; i < 5; ++i) {
+    b(i, 0) = i + 1.0L;
+  }
+
+  const S21BasicMatrix<long double> x{matrix.Solve(b)};
+  ASSERT_EQ(matrix * x, b);
+}
+}  // namespace s21
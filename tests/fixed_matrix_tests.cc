@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "../s21_fixed_matrix.h"
+
+namespace s21 {
+namespace {
+template <int N>
+FixedMatrix<double, N, N> WellConditioned() {
+  FixedMatrix<double, N, N> matrix;
+  for (int i{0}; i < N; ++i) {
+    for (int j{0}; j < N; ++j) {
+      matrix(i, j) = (i * 7 + j * 3) % 5 - 2 + (i == j ? 6 : 0);
+    }
+  }
+
+  return matrix;
+}
+
+template <int N>
+void ExpectMatchesDynamic() {
+  const FixedMatrix<double, N, N> fixed{WellConditioned<N>()};
+  const S21Matrix dynamic{fixed};
+  ASSERT_EQ(dynamic.GetRows(), N);
+
+  ASSERT_NEAR(fixed.Determinant(), dynamic.Determinant(),
+              1e-9 * std::abs(dynamic.Determinant()));
+  ASSERT_EQ(S21Matrix{fixed.InverseMatrix()}, dynamic.InverseMatrix());
+  ASSERT_EQ(S21Matrix{fixed.CalcComplements()}, dynamic.CalcComplements());
+  ASSERT_EQ(S21Matrix{fixed * fixed.Transpose()},
+            dynamic * dynamic.Transpose());
+}
+}  // namespace
+
+TEST(FixedMatrixTest, ConstexprArithmetic) {
+  constexpr FixedMatrix<int, 2, 3> left{1, 2, 3, 4, 5, 6};
+  constexpr FixedMatrix<int, 3, 2> right{left.Transpose()};
+  constexpr FixedMatrix<int, 2, 2> product{left * right};
+  static_assert(product(0, 0) == 14 && product(0, 1) == 32);
+  static_assert(product(1, 0) == 32 && product(1, 1) == 77);
+  static_assert(product.Determinant() == 14 * 77 - 32 * 32);
+  static_assert((2 * left - left + left * 3)(1, 2) == 24);
+  static_assert(-left == left * -1);
+
+  constexpr FixedMatrix<double, 2, 2> square{4.0, 7.0, 2.0, 6.0};
+  constexpr FixedMatrix<double, 2, 2> inverse{square.InverseMatrix()};
+  static_assert(inverse * square == FixedMatrix<double, 2, 2>{1.0, 0.0, 0.0,
+                                                              1.0});
+  static_assert(sizeof(FixedMatrix<float, 4, 4>) == 16 * sizeof(float));
+}
+
+TEST(FixedMatrixTest, ClosedFormsMatchDynamicMatrix) {
+  ExpectMatchesDynamic<1>();
+  ExpectMatchesDynamic<2>();
+  ExpectMatchesDynamic<3>();
+  ExpectMatchesDynamic<4>();
+  ExpectMatchesDynamic<6>();
+}
+
+TEST(FixedMatrixTest, IntegerInverseIsComputedInDouble) {
+  const FixedMatrix<std::int64_t, 3, 3> matrix{2, -3, 1, 2, 0, -1, 1, 4, 5};
+  ASSERT_EQ(matrix.Determinant(), 49);
+  const FixedMatrix<double, 3, 3> inverse{matrix.InverseMatrix()};
+  const FixedMatrix<double, 3, 3> identity{1.0, 0.0, 0.0, 0.0, 1.0,
+                                           0.0, 0.0, 0.0, 1.0};
+  const FixedMatrix<double, 3, 3> converted{
+      S21Matrix{S21BasicMatrix<std::int64_t>{matrix}}};
+  ASSERT_EQ(converted * inverse, identity);
+}
+
+TEST(FixedMatrixTest, ConversionAndErrors) {
+  S21Matrix dynamic{2, 2};
+  dynamic(0, 1) = 5.0;
+  FixedMatrix<double, 2, 2> fixed{dynamic};
+  ASSERT_DOUBLE_EQ(fixed(0, 1), 5.0);
+  fixed(1, 0) = -1.0;
+  const S21Matrix back{fixed};
+  ASSERT_DOUBLE_EQ(back(1, 0), -1.0);
+
+  using Fixed2x2 = FixedMatrix<double, 2, 2>;
+  ASSERT_THROW(Fixed2x2(S21Matrix(3, 2)), std::invalid_argument);
+  ASSERT_THROW((Fixed2x2{1.0, 2.0, 3.0, 4.0, 5.0}), std::invalid_argument);
+  ASSERT_THROW(static_cast<void>(fixed(2, 0)), std::out_of_range);
+  const Fixed2x2 singular{1.0, 2.0, 2.0, 4.0};
+  ASSERT_THROW(static_cast<void>(singular.InverseMatrix()),
+               std::runtime_error);
+  const Fixed2x2 scaled{1e10, 0.0, 0.0, 1e-7};
+  ASSERT_DOUBLE_EQ(scaled.Determinant(), 1e3);
+  ASSERT_DOUBLE_EQ(scaled.InverseMatrix()(1, 1), 1e7);
+}
+}  // namespace s21
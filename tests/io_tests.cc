@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "tests.h"
+
+namespace s21 {
+namespace {
+S21Matrix Sequence(int rows, int cols) {
+  S21Matrix matrix{rows, cols};
+  for (int i{0}; i < rows; ++i) {
+    for (int j{0}; j < cols; ++j) {
+      matrix(i, j) = i * cols + j + 0.25;
+    }
+  }
+
+  return matrix;
+}
+
+std::vector<char> ReadBytes(const std::string& path) {
+  std::ifstream file{path, std::ios::binary};
+  return {std::istreambuf_iterator<char>{file},
+          std::istreambuf_iterator<char>{}};
+}
+
+void WriteBytes(const std::string& path, const std::vector<char>& bytes) {
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+}  // namespace
+
+TEST(MatrixIoTest, SaveAndLoadRoundTripEveryElementType) {
+  const TemporaryFile file{"s21_round_trip.bin"};
+  const S21Matrix matrix{Sequence(5, 7)};
+  matrix.Save(file.path());
+  ASSERT_EQ(ReadBytes(file.path()).size(), 64U + 35 * sizeof(double));
+  ASSERT_TRUE(S21Matrix::Load(file.path()).EqMatrix(matrix));
+
+  S21BasicMatrix<std::complex<float>> complex{2, 2};
+  complex(1, 0) = std::complex<float>{1.5F, -2.0F};
+  complex.Save(file.path());
+  ASSERT_TRUE(
+      S21BasicMatrix<std::complex<float>>::Load(file.path()).EqMatrix(complex));
+
+  S21BasicMatrix<std::int32_t> integers{3, 1};
+  integers(2, 0) = -7;
+  integers.Save(file.path());
+  ASSERT_EQ(S21BasicMatrix<std::int32_t>::Load(file.path())(2, 0), -7);
+  ASSERT_THROW(static_cast<void>(S21Matrix::Load(file.path())),
+               std::runtime_error);
+}
+
+TEST(MatrixIoTest, MappedFilesShareOrCopyPages) {
+  const TemporaryFile file{"s21_mapped.bin"};
+  const S21Matrix matrix{Sequence(40, 30)};
+  matrix.Save(file.path());
+
+  MappedMatrix<double> mapped{S21Matrix::MapFile(file.path())};
+  ASSERT_EQ(mapped.GetRows(), 40);
+  ASSERT_EQ(mapped.GetCols(), 30);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % 64, 0U);
+  ASSERT_TRUE(S21Matrix{mapped.View()}.EqMatrix(matrix));
+  ASSERT_THROW(static_cast<void>(mapped.MutableView()), std::logic_error);
+  ASSERT_THROW(static_cast<void>(mapped(40, 0)), std::out_of_range);
+
+  MappedMatrix<double> private_copy{
+      S21Matrix::MapFile(file.path(), MapMode::kCopyOnWrite)};
+  private_copy.MutableView()(3, 4) = -1.0;
+  ASSERT_DOUBLE_EQ(private_copy(3, 4), -1.0);
+  ASSERT_DOUBLE_EQ(mapped(3, 4), matrix(3, 4));
+  ASSERT_TRUE(S21Matrix::Load(file.path()).EqMatrix(matrix));
+
+  MappedMatrix<double> moved{std::move(private_copy)};
+  ASSERT_EQ(private_copy.data(), nullptr);
+  ASSERT_DOUBLE_EQ(moved(3, 4), -1.0);
+}
+
+TEST(MatrixIoTest, WriterStreamsRowsAndChecksCompleteness) {
+  const TemporaryFile file{"s21_streamed.bin"};
+  const S21Matrix matrix{Sequence(9, 4)};
+  {
+    MatrixFileWriter<double> writer{file.path(), 9, 4};
+    writer.WriteRows(matrix.Block(0, 0, 5, 4));
+    writer.Write(matrix.Row(5).data(), 4);
+    writer.WriteRows(matrix.Block(6, 0, 3, 4));
+    ASSERT_EQ(writer.GetRemaining(), 0U);
+    ASSERT_THROW(writer.Write(matrix.data(), 1), std::invalid_argument);
+    writer.Close();
+  }
+  ASSERT_TRUE(S21Matrix::Load(file.path()).EqMatrix(matrix));
+
+  MatrixFileWriter<double> incomplete{file.path(), 9, 4};
+  incomplete.WriteRows(matrix.Block(0, 0, 2, 4));
+  ASSERT_THROW(incomplete.WriteRows(matrix.Block(0, 0, 2, 3)),
+               std::invalid_argument);
+  ASSERT_THROW(incomplete.Close(), std::runtime_error);
+  ASSERT_THROW(static_cast<void>(S21Matrix::Load(file.path())),
+               std::runtime_error);
+  ASSERT_THROW(static_cast<void>(S21Matrix::MapFile(file.path())),
+               std::runtime_error);
+  ASSERT_THROW(static_cast<void>(S21Matrix::Load(file.path() + ".missing")),
+               std::system_error);
+}
+
+TEST(MatrixIoTest, LoadSwapsForeignByteOrder) {
+  const TemporaryFile file{"s21_foreign.bin"};
+  const S21Matrix matrix{Sequence(3, 2)};
+  matrix.Save(file.path());
+
+  // Rewrite the header fields and elements in the other byte order.
+  std::vector<char> bytes{ReadBytes(file.path())};
+  bytes[17] = static_cast<char>(bytes[17] == 1 ? 2 : 1);
+  for (std::size_t offset : {8, 12, 24, 32}) {
+    const std::size_t width{offset < 24 ? 4U : 8U};
+    std::reverse(bytes.begin() + offset, bytes.begin() + offset + width);
+  }
+  std::reverse(bytes.begin() + 18, bytes.begin() + 20);
+  for (std::size_t offset{64}; offset < bytes.size(); offset += 8) {
+    std::reverse(bytes.begin() + offset, bytes.begin() + offset + 8);
+  }
+  WriteBytes(file.path(), bytes);
+
+  ASSERT_TRUE(S21Matrix::Load(file.path()).EqMatrix(matrix));
+  ASSERT_THROW(static_cast<void>(S21Matrix::MapFile(file.path())),
+               std::runtime_error);
+}
+}  // namespace s21
@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "../s21_matrix_kernels.h"
+
+namespace s21::kernels {
+namespace {
+const SimdLevel kLevels[]{SimdLevel::kScalar, SimdLevel::kSse2,
+                          SimdLevel::kAvx2, SimdLevel::kAvx512};
+
+std::vector<double> Sequence(std::size_t size, double offset) {
+  std::vector<double> values(size);
+  for (std::size_t i{0}; i < size; ++i) {
+    values[i] = offset + static_cast<double>(i % 17) * 0.5;
+  }
+
+  return values;
+}
+
+// Values across many binades with differences of every size, signed
+// zeros, infinities, subnormals and a NaN, spanning several blocks.
+template <typename T>
+void FillComparable(std::vector<T>& left, std::vector<T>& right) {
+  using Limits = std::numeric_limits<T>;
+  for (std::size_t i{0}; i < left.size(); ++i) {
+    const T sign{i % 3 == 0 ? T{-1} : T{1}};
+    left[i] = sign * std::ldexp(T{1} + static_cast<T>(i % 7) / 8,
+                                static_cast<int>(i % 41) - 20);
+    right[i] = left[i] + left[i] * static_cast<T>(i % 5) * Limits::epsilon();
+  }
+  left[100] = T{0};
+  right[100] = -T{0};
+  left[101] = right[101] = Limits::infinity();
+  left[102] = Limits::infinity();
+  left[103] = Limits::denorm_min();
+  right[103] = 4 * Limits::denorm_min();
+  right[104] = std::nextafter(left[104], T{0});
+  left[2200] = Limits::quiet_NaN();
+}
+
+template <typename T>
+void ExpectCompareAgreesAcrossSimdLevels() {
+  const SimdLevel detected{DetectSimdLevel()};
+  std::vector<T> left(2500);
+  std::vector<T> right(left.size());
+  FillComparable(left, right);
+  for (const Tolerance mode :
+       {Tolerance::kAbsolute, Tolerance::kRelative, Tolerance::kUlp}) {
+    for (const bool stop : {false, true}) {
+      // From index 1050 on, the only absolute mismatch is the NaN in the
+      // second block.
+      for (const auto& [start, size] :
+           {std::array<std::size_t, 2>{0, 0}, std::array<std::size_t, 2>{0, 5},
+            std::array<std::size_t, 2>{0, 99},
+            std::array<std::size_t, 2>{0, 2500},
+            std::array<std::size_t, 2>{1050, 1450}}) {
+        const T* const first{left.data() + start};
+        const T* const second{right.data() + start};
+        const CompareOptions options{mode, 4.0};
+        SetSimdLevel(SimdLevel::kScalar);
+        const ElementComparison expected{
+            Compare(size, first, second, options, stop)};
+        if (mode == Tolerance::kAbsolute && start == 1050) {
+          ASSERT_EQ(expected.first_mismatch, 1150U);
+        }
+        for (SimdLevel level : kLevels) {
+          if (level > detected) continue;
+          SetSimdLevel(level);
+          const ElementComparison actual{
+              Compare(size, first, second, options, stop)};
+          ASSERT_EQ(actual.first_mismatch, expected.first_mismatch);
+          ASSERT_EQ(actual.max_error, expected.max_error);
+        }
+      }
+    }
+  }
+  SetSimdLevel(detected);
+}
+}  // namespace
+
+TEST(KernelsTest, CompareMeasuresErrorsInTheUnitOfTheMode) {
+  constexpr double kInfinity{std::numeric_limits<double>::infinity()};
+  const std::vector<double> left{1.0, 1e10, 0.0, kInfinity, -2.0};
+  const std::vector<double> right{std::nextafter(1.0, 2.0), 1e10 + 1.0, -0.0,
+                                  kInfinity, -2.0};
+  const std::size_t size{left.size()};
+  const ElementComparison absolute{Compare(
+      size, left.data(), right.data(), {Tolerance::kAbsolute, 1e-7}, false)};
+  ASSERT_EQ(absolute.first_mismatch, 1U);
+  ASSERT_EQ(absolute.max_error, 1.0);
+  const ElementComparison relative{Compare(
+      size, left.data(), right.data(), {Tolerance::kRelative, 1e-9}, false)};
+  ASSERT_EQ(relative.first_mismatch, size);
+  ASSERT_DOUBLE_EQ(relative.max_error, 1.0 / (1e10 + 1.0));
+  // The spacing of doubles in [2^33, 2^34) is 2^-19.
+  const ElementComparison ulp{Compare(size, left.data(), right.data(),
+                                      {Tolerance::kUlp, 1.0}, false)};
+  ASSERT_EQ(ulp.first_mismatch, 1U);
+  ASSERT_EQ(ulp.max_error, 524288.0);
+  ASSERT_FALSE(AllClose(1, &left[2], &kInfinity, 1e300));
+
+  const double undefined{std::numeric_limits<double>::quiet_NaN()};
+  const ElementComparison nan{
+      Compare(1, &undefined, &undefined, {Tolerance::kUlp, 1e300}, true)};
+  ASSERT_EQ(nan.first_mismatch, 0U);
+  ASSERT_EQ(nan.max_error, kInfinity);
+
+  const std::int64_t low{std::numeric_limits<std::int64_t>::min()};
+  const std::int64_t high{std::numeric_limits<std::int64_t>::max()};
+  ASSERT_EQ(Compare(1, &low, &high, {Tolerance::kUlp, 0.0}, false).max_error,
+            18446744073709551615.0);
+  ASSERT_EQ(
+      Compare(1, &low, &low, {Tolerance::kAbsolute, 0.0}, false).max_error,
+      0.0);
+}
+
+TEST(KernelsTest, CompareAgreesAcrossSimdLevels) {
+  ExpectCompareAgreesAcrossSimdLevels<double>();
+  ExpectCompareAgreesAcrossSimdLevels<float>();
+}
+
+TEST(KernelsTest, ElementwiseKernelsAgreeAcrossSimdLevels) {
+  const SimdLevel detected{DetectSimdLevel()};
+  for (SimdLevel level : kLevels) {
+    if (level > detected) continue;
+    SetSimdLevel(level);
+    ASSERT_EQ(GetSimdLevel(), level);
+
+    for (std::size_t size : {0U, 1U, 7U, 8U, 33U}) {
+      const std::vector<double> source{Sequence(size, 1.0)};
+      std::vector<double> sum{Sequence(size, -2.0)};
+      std::vector<double> difference{sum};
+      std::vector<double> scaled{sum};
+      Add(size, source.data(), sum.data());
+      Subtract(size, source.data(), difference.data());
+      Scale(size, -3.0, scaled.data());
+      for (std::size_t i{0}; i < size; ++i) {
+        const double initial{-2.0 + static_cast<double>(i % 17) * 0.5};
+        ASSERT_DOUBLE_EQ(sum[i], initial + source[i]);
+        ASSERT_DOUBLE_EQ(difference[i], initial - source[i]);
+        ASSERT_DOUBLE_EQ(scaled[i], initial * -3.0);
+      }
+
+      std::vector<double> close{source};
+      ASSERT_TRUE(AllClose(size, source.data(), close.data(), 1e-7));
+      if (size > 0) {
+        close[size - 1] += 1e-3;
+        ASSERT_FALSE(AllClose(size, source.data(), close.data(), 1e-7));
+        ASSERT_TRUE(AllClose(size, source.data(), close.data(), 1e-2));
+      }
+    }
+  }
+  SetSimdLevel(detected);
+}
+
+TEST(KernelsTest, TransposeAgreesAcrossSimdLevels) {
+  const SimdLevel detected{DetectSimdLevel()};
+  const int rows{19};
+  const int cols{26};
+  const std::vector<double> source{Sequence(rows * cols, 0.0)};
+  for (SimdLevel level : kLevels) {
+    if (level > detected) continue;
+    SetSimdLevel(level);
+
+    std::vector<double> transposed(rows * cols);
+    Transpose(rows, cols, source.data(), cols, transposed.data(), rows);
+    for (int i{0}; i < rows; ++i) {
+      for (int j{0}; j < cols; ++j) {
+        ASSERT_EQ(transposed[j * rows + i], source[i * cols + j]);
+      }
+    }
+  }
+  SetSimdLevel(detected);
+}
+
+TEST(KernelsTest, FloatKernelsAgreeAcrossSimdLevels) {
+  const SimdLevel detected{DetectSimdLevel()};
+  const int rows{23};
+  const int cols{40};
+  const std::size_t size{static_cast<std::size_t>(rows) * cols};
+  std::vector<float> source(size);
+  std::vector<float> initial(size);
+  for (std::size_t i{0}; i < size; ++i) {
+    source[i] = 1.0F + static_cast<float>(i % 17) * 0.5F;
+    initial[i] = -2.0F + static_cast<float>(i % 13) * 0.25F;
+  }
+
+  for (SimdLevel level : kLevels) {
+    if (level > detected) continue;
+    SetSimdLevel(level);
+
+    std::vector<float> sum{initial};
+    std::vector<float> difference{initial};
+    std::vector<float> scaled{initial};
+    Add(size, source.data(), sum.data());
+    Subtract(size, source.data(), difference.data());
+    Scale(size, -3.0F, scaled.data());
+    for (std::size_t i{0}; i < size; ++i) {
+      ASSERT_FLOAT_EQ(sum[i], initial[i] + source[i]);
+      ASSERT_FLOAT_EQ(difference[i], initial[i] - source[i]);
+      ASSERT_FLOAT_EQ(scaled[i], initial[i] * -3.0F);
+    }
+
+    std::vector<float> close{source};
+    ASSERT_TRUE(AllClose(size, source.data(), close.data(), 1e-5));
+    close[size - 1] += 1e-2F;
+    ASSERT_FALSE(AllClose(size, source.data(), close.data(), 1e-5));
+    close[size - 1] = source[size - 1];
+    close[3] -= 1e-2F;
+    ASSERT_FALSE(AllClose(size, source.data(), close.data(), 1e-5));
+
+    std::vector<float> transposed(size);
+    Transpose(rows, cols, source.data(), cols, transposed.data(), rows);
+    for (int i{0}; i < rows; ++i) {
+      for (int j{0}; j < cols; ++j) {
+        ASSERT_EQ(transposed[j * rows + i], source[i * cols + j]);
+      }
+    }
+  }
+  SetSimdLevel(detected);
+}
+
+TEST(KernelsTest, StrassenGemmMatchesGemmForAnyShape) {
+  for (const auto& [m, n, k] : {std::array<int, 3>{64, 64, 64},
+                                std::array<int, 3>{67, 45, 53},
+                                std::array<int, 3>{33, 80, 17}}) {
+    const std::vector<double> a{Sequence(static_cast<std::size_t>(m) * k,
+                                         -4.0)};
+    const std::vector<double> b{Sequence(static_cast<std::size_t>(k) * n,
+                                         -2.5)};
+    std::vector<double> expected(static_cast<std::size_t>(m) * n);
+    Gemm(m, n, k, a.data(), k, b.data(), n, expected.data(), n, 1);
+
+    for (const int cutoff : {1, 4, 16}) {
+      std::vector<double> product(expected.size(), 99.0);
+      StrassenGemm(m, n, k, a.data(), k, b.data(), n, product.data(), n,
+                   cutoff, 3);
+      for (std::size_t i{0}; i < product.size(); ++i) {
+        ASSERT_NEAR(product[i], expected[i], 1e-9 * std::abs(expected[i]));
+      }
+    }
+  }
+  ASSERT_EQ(StrassenLevels(67, 45, 53, 16), 2);
+  ASSERT_EQ(StrassenLevels(8, 1024, 1024, 16), 0);
+
+  const std::vector<std::int64_t> integers(25 * 25, 3);
+  std::vector<std::int64_t> square(integers.size());
+  StrassenGemm(25, 25, 25, integers.data(), 25, integers.data(), 25,
+               square.data(), 25, 2, 1);
+  for (const std::int64_t element : square) ASSERT_EQ(element, 225);
+}
+}  // namespace s21::kernels
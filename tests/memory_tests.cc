@@ -0,0 +1,335 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../s21_matrix_oop.h"
+
+namespace s21 {
+namespace {
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  int allocations{0};
+  int deallocations{0};
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* pointer, std::size_t bytes,
+                     std::size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+void RunRequest(const S21Matrix& left, const S21Matrix& right) {
+  S21Matrix sum{left + right};
+  S21Matrix product{left * right};
+  product.SetCols(7);
+  S21Matrix transposed{product.Transpose()};
+  ASSERT_EQ(transposed.GetRows(), 7);
+}
+}  // namespace
+
+TEST(MemoryTest, ExplicitResourceIsUsedAndMovesWithTheMatrix) {
+  CountingResource resource;
+  {
+    S21Matrix matrix{4, 5, &resource};
+    ASSERT_EQ(matrix.GetResource(), &resource);
+    ASSERT_EQ(resource.allocations, 1);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(matrix.data()) %
+                  kMatrixStorageAlignment,
+              0U);
+
+    matrix.SetRows(6);
+    ASSERT_EQ(matrix.GetResource(), &resource);
+
+    S21Matrix moved{std::move(matrix)};
+    ASSERT_EQ(moved.GetResource(), &resource);
+    S21Matrix copy{moved};
+    ASSERT_EQ(copy.GetResource(), GetDefaultMatrixResource());
+    S21Matrix copy_with_resource{moved, &resource};
+    ASSERT_EQ(copy_with_resource.GetResource(), &resource);
+  }
+  ASSERT_EQ(resource.allocations, 3);
+  ASSERT_EQ(resource.deallocations, 3);
+}
+
+TEST(MemoryTest, MoveAssignmentKeepsTheResourceOfTheTarget) {
+  CountingResource resource;
+  MatrixArena arena{1024};
+  {
+    S21Matrix target{8, 8, &resource};
+    S21Matrix source{8, 8, &arena};
+    source(1, 2) = 3.0;
+    const double* storage{std::as_const(source).data()};
+    target = std::move(source);
+    ASSERT_EQ(target.GetResource(), &resource);
+    ASSERT_NE(std::as_const(target).data(), storage);
+    ASSERT_DOUBLE_EQ(target(1, 2), 3.0);
+    ASSERT_EQ(resource.allocations, 1);
+
+    S21Matrix same_resource{16, 16, &resource};
+    storage = std::as_const(same_resource).data();
+    target = std::move(same_resource);
+    ASSERT_EQ(std::as_const(target).data(), storage);
+    ASSERT_EQ(resource.deallocations, 1);
+  }
+  ASSERT_EQ(resource.allocations, resource.deallocations);
+}
+
+TEST(MemoryTest, ThreadLocalPoolReachesSteadyState) {
+  S21Matrix left{24, 24};
+  S21Matrix right{24, 24};
+  for (int i{0}; i < 24; ++i) {
+    left(i, i) = 2.0;
+    right(i, (i + 1) % 24) = 1.0;
+  }
+
+  RunRequest(left, right);
+  const PoolStatistics warm{GetPoolStatistics()};
+  for (int i{0}; i < 100; ++i) {
+    RunRequest(left, right);
+  }
+  const PoolStatistics steady{GetPoolStatistics()};
+  ASSERT_EQ(steady.upstream_allocations, warm.upstream_allocations);
+  ASSERT_EQ(steady.upstream_deallocations, warm.upstream_deallocations);
+}
+
+TEST(MemoryTest, PoolBlocksCanBeFreedOnAnotherThread) {
+  S21Matrix* matrix{nullptr};
+  std::thread producer{[&matrix] { matrix = new S21Matrix{16, 16}; }};
+  producer.join();
+  (*matrix)(3, 3) = 1.0;
+  delete matrix;
+
+  S21Matrix reused{16, 16};
+  ASSERT_DOUBLE_EQ(reused(3, 3), 0.0);
+}
+
+TEST(MemoryTest, ArenaResetReusesItsLargestChunk) {
+  CountingResource upstream;
+  MatrixArena arena{1024, &upstream};
+  S21Matrix left{8, 8};
+  S21Matrix right{8, 8};
+
+  for (int request{0}; request < 5; ++request) {
+    {
+      ScopedMatrixResource scope{&arena};
+      ASSERT_EQ(GetDefaultMatrixResource(), &arena);
+      RunRequest(left, right);
+      ASSERT_GT(arena.GetBytesAllocated(), 0U);
+    }
+    ASSERT_EQ(GetDefaultMatrixResource(), ThreadLocalPool());
+    arena.Reset();
+    ASSERT_EQ(arena.GetBytesAllocated(), 0U);
+  }
+
+  const int allocations{upstream.allocations};
+  for (int request{0}; request < 5; ++request) {
+    ScopedMatrixResource scope{&arena};
+    RunRequest(left, right);
+    arena.Reset();
+  }
+  ASSERT_EQ(upstream.allocations, allocations);
+  ASSERT_EQ(upstream.allocations - upstream.deallocations, 1);
+}
+
+TEST(MemoryTest, SmallMatricesAreStoredInline) {
+  CountingResource resource;
+  {
+    S21Matrix matrix{4, 4, &resource};
+    ASSERT_EQ(S21Matrix::kInlineCapacity, 16U);
+    ASSERT_EQ(resource.allocations, 0);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(matrix.data()) %
+                  kMatrixStorageAlignment,
+              0U);
+    matrix(3, 3) = 5.0;
+
+    S21Matrix moved{std::move(matrix)};
+    ASSERT_EQ(matrix.data(), nullptr);
+    ASSERT_EQ(moved.GetResource(), &resource);
+    ASSERT_DOUBLE_EQ(moved(3, 3), 5.0);
+
+    moved.SetCols(5);
+    ASSERT_EQ(resource.allocations, 1);
+    ASSERT_DOUBLE_EQ(moved(3, 3), 5.0);
+    const double* heap_data{moved.data()};
+    S21Matrix stolen{std::move(moved)};
+    ASSERT_EQ(stolen.data(), heap_data);
+
+    stolen.SetRows(2);
+    ASSERT_EQ(resource.deallocations, 1);
+    stolen(1, 4) = 7.0;
+    S21Matrix assigned{8, 8, &resource};
+    assigned = std::move(stolen);
+    ASSERT_EQ(resource.deallocations, 2);
+    ASSERT_DOUBLE_EQ(assigned(1, 4), 7.0);
+    ASSERT_EQ(assigned.GetRows(), 2);
+  }
+  ASSERT_EQ(resource.allocations, 2);
+  ASSERT_EQ(resource.deallocations, 2);
+}
+
+TEST(MemoryTest, CopiesShareStorageUntilWritten) {
+  CountingResource resource;
+  {
+    const ScopedMatrixResource scope{&resource};
+    S21Matrix matrix{16, 16};
+    matrix(1, 2) = 3.0;
+    const S21Matrix copy{matrix};
+    S21Matrix other{copy};
+    ASSERT_EQ(copy.data(), std::as_const(matrix).data());
+    ASSERT_EQ(std::as_const(other).data(), copy.data());
+    // The storage and the shared reference count.
+    ASSERT_EQ(resource.allocations, 2);
+
+    other(1, 2) = 4.0;
+    ASSERT_NE(std::as_const(other).data(), copy.data());
+    ASSERT_DOUBLE_EQ(copy(1, 2), 3.0);
+    other = matrix;
+    ASSERT_EQ(std::as_const(other).data(), copy.data());
+    other.SumMatrix(copy);
+    matrix.MulNumber(2.0);
+    ASSERT_DOUBLE_EQ(other(1, 2), 6.0);
+    ASSERT_DOUBLE_EQ(matrix(1, 2), 6.0);
+    ASSERT_DOUBLE_EQ(copy(1, 2), 3.0);
+
+    S21Matrix transposed{copy};
+    transposed.TransposeInPlace();
+    transposed = transposed + copy;
+    ASSERT_DOUBLE_EQ(transposed(2, 1), 3.0);
+    ASSERT_DOUBLE_EQ(copy(2, 1), 0.0);
+    S21Matrix resized{copy};
+    resized.SetRows(20);
+    ASSERT_DOUBLE_EQ(resized(1, 2), 3.0);
+    ASSERT_EQ(resource.allocations, 7);
+
+    // Copies from another resource, and copies into one, never share.
+    const S21Matrix pooled{S21Matrix{copy, ThreadLocalPool()}};
+    ASSERT_NE(pooled.data(), copy.data());
+    ASSERT_NE((S21Matrix{copy, &resource}.data()), copy.data());
+  }
+  ASSERT_EQ(resource.allocations, resource.deallocations);
+
+  S21Matrix small{4, 4};
+  const S21Matrix small_copy{small};
+  ASSERT_NE(small_copy.data(), std::as_const(small).data());
+}
+
+TEST(MemoryTest, MatricesWithMutableViewsAreCopiedDeeply) {
+  S21Matrix matrix{16, 16};
+  const SubMatrixView<double> view{matrix.View()};
+  const S21Matrix copy{matrix};
+  ASSERT_NE(copy.data(), std::as_const(matrix).data());
+  view(0, 0) = 1.0;
+  ASSERT_DOUBLE_EQ(copy(0, 0), 0.0);
+
+  matrix.SetCols(8);
+  const S21Matrix shared{matrix};
+  ASSERT_EQ(shared.data(), std::as_const(matrix).data());
+}
+
+TEST(MemoryTest, FilledMatricesShareStorage) {
+  S21Matrix matrix{16, 16};
+  for (int i{0}; i < 16; ++i) {
+    for (int j{0}; j < 16; ++j) {
+      matrix(i, j) = i * 16 + j;
+    }
+  }
+  matrix.AtUnchecked(0, 0) = -1.0;
+  double* const elements{matrix.data()};
+  elements[1] = -2.0;
+
+  const S21Matrix copy{matrix};
+  ASSERT_EQ(copy.data(), std::as_const(matrix).data());
+  S21Matrix passed{copy};
+  ASSERT_EQ(std::as_const(passed).data(), copy.data());
+  ASSERT_DOUBLE_EQ(passed(0, 1), -2.0);
+  ASSERT_NE(std::as_const(passed).data(), copy.data());
+  ASSERT_DOUBLE_EQ(copy(15, 15), 255.0);
+}
+
+TEST(MemoryTest, SharedStorageCanBeCopiedOnManyThreads) {
+  S21Matrix source{64, 64};
+  source(5, 5) = 1.0;
+  const S21Matrix& matrix{source};
+
+  std::vector<std::thread> threads;
+  for (int t{0}; t < 4; ++t) {
+    threads.emplace_back([&matrix, t] {
+      for (int i{0}; i < 100; ++i) {
+        S21Matrix copy{matrix};
+        copy(5, 5) += t;
+        S21Matrix shared{copy};
+        ASSERT_DOUBLE_EQ(shared(5, 5), 1.0 + t);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  ASSERT_DOUBLE_EQ(matrix(5, 5), 1.0);
+}
+
+TEST(MemoryTest, TemporaryOperandsLendTheirStorage) {
+  CountingResource resource;
+  const ScopedMatrixResource scope{&resource};
+  S21Matrix a{16, 16};
+  S21Matrix b{16, 16};
+  S21Matrix c{16, 16};
+  for (int i{0}; i < 16; ++i) {
+    for (int j{0}; j < 16; ++j) {
+      a(i, j) = i + j;
+      b(i, j) = 1.0;
+      c(i, j) = 2.0;
+    }
+  }
+
+  int allocations{resource.allocations};
+  const S21Matrix chain{(a + b) * 2.0 - c};
+  ASSERT_EQ(resource.allocations, allocations + 1);
+  ASSERT_DOUBLE_EQ(chain(2, 3), 10.0);
+
+  S21Matrix temporary{a + b};
+  const double* storage{std::as_const(temporary).data()};
+  allocations = resource.allocations;
+  const S21Matrix reused{(std::move(temporary) - c) * 2.0};
+  ASSERT_EQ(resource.allocations, allocations);
+  ASSERT_EQ(reused.data(), storage);
+  ASSERT_DOUBLE_EQ(reused(2, 3), 8.0);
+
+  allocations = resource.allocations;
+  const S21Matrix product{a * b};
+  const int product_allocations{resource.allocations - allocations};
+  allocations = resource.allocations;
+  const S21Matrix scaled_product{(a * b) * 2.0 - c};
+  ASSERT_EQ(resource.allocations - allocations, product_allocations);
+  ASSERT_TRUE(scaled_product == S21Matrix{product * 2.0 - c});
+
+  S21Matrix twice{a};
+  twice(0, 0) = 1.0;
+  S21Matrix target{4, 4};
+  target = std::move(twice) + twice;
+  ASSERT_DOUBLE_EQ(target(0, 0), 2.0);
+  ASSERT_DOUBLE_EQ(target(2, 3), 10.0);
+
+  // Storage shared with a named matrix is left alone.
+  S21Matrix shared{a};
+  allocations = resource.allocations;
+  const S21Matrix sum{std::move(shared) + b};
+  ASSERT_EQ(resource.allocations, allocations + 1);
+  ASSERT_DOUBLE_EQ(a(2, 3), 5.0);
+
+  const S21Matrix scaled{2.0 * a};
+  ASSERT_DOUBLE_EQ(scaled(2, 3), 10.0);
+  ASSERT_DOUBLE_EQ(a(2, 3), 5.0);
+}
+}  // namespace s21
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "../s21_matrix_oop.h"
+#include "../s21_matrix_profile.h"
+
+namespace s21::profile {
+namespace {
+S21Matrix Diagonal(int size) {
+  S21Matrix matrix{size, size};
+  for (int i{0}; i < size; ++i) matrix(i, i) = 2.0;
+  return matrix;
+}
+
+void RunOperations() {
+  const S21Matrix matrix{Diagonal(32)};
+  S21Matrix copy{matrix};
+  copy.MulMatrix(matrix);
+  static_cast<void>(copy.Determinant());
+  static_cast<void>(copy.InverseMatrix());
+  static_cast<void>(Diagonal(4).CalcComplements());
+  S21Matrix moved{std::move(copy)};
+  moved.SetRows(40);
+}
+}  // namespace
+
+TEST(ProfileTest, CountsOperationsOnlyWhenEnabled) {
+  Reset();
+  RunOperations();
+  const Snapshot snapshot{GetSnapshot()};
+  if constexpr (!kEnabled) {
+    for (const OperationProfile& operation : snapshot.operations) {
+      ASSERT_EQ(operation.calls, 0U);
+    }
+    ASSERT_EQ(snapshot.bytes_allocated, 0U);
+    return;
+  }
+
+  const OperationProfile& product{snapshot[Operation::kMulMatrix]};
+  ASSERT_EQ(product.calls, 1U);
+  ASSERT_EQ(product.elements, 2U * 32 * 32);
+  ASSERT_EQ(product.bytes_allocated, 32U * 32 * sizeof(double));
+  ASSERT_GT(product.wall_time.count(), 0);
+  ASSERT_EQ(snapshot[Operation::kDeterminant].calls, 1U);
+  ASSERT_EQ(snapshot[Operation::kInverseMatrix].calls, 1U);
+  ASSERT_EQ(snapshot[Operation::kCalcComplements].calls, 1U);
+  ASSERT_GE(snapshot[Operation::kCopy].calls, 1U);
+  ASSERT_GE(snapshot[Operation::kMove].calls, 2U);
+  const OperationProfile& resize{snapshot[Operation::kChangeSize]};
+  ASSERT_EQ(resize.calls, 1U);
+  ASSERT_EQ(resize.elements, 32U * 32);
+  ASSERT_EQ(resize.bytes_allocated, 40U * 32 * sizeof(double));
+  ASSERT_GE(snapshot.bytes_allocated,
+            product.bytes_allocated + resize.bytes_allocated);
+  ASSERT_GT(snapshot.allocations, 2U);
+  ASSERT_STREQ(OperationName(Operation::kChangeSize), "ChangeSize");
+
+  Reset();
+  ASSERT_EQ(GetSnapshot()[Operation::kMulMatrix].calls, 0U);
+}
+
+TEST(ProfileTest, WritesChromeTrace) {
+  StartTrace(4);
+  std::thread worker{RunOperations};
+  worker.join();
+  RunOperations();
+  StopTrace();
+  RunOperations();
+
+  const std::string path{"profile_test_trace.json"};
+  WriteChromeTrace(path);
+  std::ifstream file{path};
+  const std::string text{std::istreambuf_iterator<char>{file},
+                         std::istreambuf_iterator<char>{}};
+  std::remove(path.c_str());
+
+  ASSERT_EQ(text.rfind("{\"traceEvents\":[", 0), 0U);
+  ASSERT_NE(text.find("\"dropped_events\":"), std::string::npos);
+  if constexpr (kEnabled) {
+    ASSERT_NE(text.find("\"ph\":\"X\""), std::string::npos);
+    ASSERT_EQ(text.find("\"dropped_events\":0"), std::string::npos);
+  } else {
+    ASSERT_NE(text.find("\"traceEvents\":[\n]"), std::string::npos);
+  }
+  ASSERT_THROW(WriteChromeTrace("/nonexistent/trace.json"),
+               std::system_error);
+}
+}  // namespace s21::profile
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "../s21_sparse_matrix.h"
+
+namespace s21 {
+namespace {
+S21Matrix RandomSparseDense(int rows, int cols, double density,
+                            unsigned seed) {
+  std::mt19937 generator{seed};
+  std::uniform_real_distribution<double> distribution{-1.0, 1.0};
+  std::bernoulli_distribution is_stored{density};
+  S21Matrix matrix{rows, cols};
+  for (int i{0}; i < rows; ++i) {
+    for (int j{0}; j < cols; ++j) {
+      if (is_stored(generator)) matrix(i, j) = distribution(generator);
+    }
+  }
+
+  return matrix;
+}
+
+std::vector<double> Column(const S21Matrix& matrix) {
+  std::vector<double> column;
+  for (int i{0}; i < matrix.GetRows(); ++i) {
+    column.push_back(matrix(i, 0));
+  }
+
+  return column;
+}
+}  // namespace
+
+TEST(SparseMatrixTest, EntriesAreSummedSortedAndCompressed) {
+  const S21SparseMatrix matrix{
+      3, 4, {{2, 1, 5.0}, {0, 3, 1.0}, {0, 0, 2.0}, {2, 1, -5.0}, {0, 3, 2.0}}};
+
+  ASSERT_EQ(matrix.NonZeros(), 2U);
+  ASSERT_EQ(matrix.offsets(), (std::vector<std::size_t>{0, 2, 2, 2}));
+  ASSERT_EQ(matrix.indices(), (std::vector<int>{0, 3}));
+  ASSERT_DOUBLE_EQ(matrix(0, 3), 3.0);
+  ASSERT_DOUBLE_EQ(matrix(2, 1), 0.0);
+
+  const S21SparseMatrix csc{matrix.ToFormat(SparseFormat::kCsc)};
+  ASSERT_EQ(csc.offsets(), (std::vector<std::size_t>{0, 1, 1, 1, 2}));
+  ASSERT_EQ(csc.indices(), (std::vector<int>{0, 0}));
+  ASSERT_DOUBLE_EQ(csc(0, 3), 3.0);
+
+  ASSERT_THROW(static_cast<void>(matrix(3, 0)), std::out_of_range);
+  ASSERT_THROW(S21SparseMatrix(2, 2, {{0, 2, 1.0}}), std::out_of_range);
+  ASSERT_THROW(S21SparseMatrix(0, 2), std::invalid_argument);
+}
+
+TEST(SparseMatrixTest, DenseConversionRoundTrips) {
+  const S21Matrix dense{RandomSparseDense(37, 23, 0.1, 1)};
+  for (SparseFormat format : {SparseFormat::kCsr, SparseFormat::kCsc}) {
+    const S21SparseMatrix sparse{dense, format};
+    ASSERT_EQ(sparse.GetFormat(), format);
+    ASSERT_TRUE(sparse.ToDense().EqMatrix(dense));
+    ASSERT_TRUE(sparse.Transpose().ToDense().EqMatrix(dense.Transpose()));
+    ASSERT_EQ(sparse.Transpose().GetFormat(), format);
+  }
+}
+
+TEST(SparseMatrixTest, ElementwiseOperationsMatchDense) {
+  const S21Matrix left{RandomSparseDense(40, 30, 0.2, 2)};
+  const S21Matrix right{RandomSparseDense(40, 30, 0.2, 3)};
+  const S21SparseMatrix sparse_left{left};
+  const S21SparseMatrix sparse_right{right, SparseFormat::kCsc};
+
+  ASSERT_TRUE((sparse_left + sparse_right).ToDense().EqMatrix(left + right));
+  ASSERT_TRUE((sparse_left - sparse_right).ToDense().EqMatrix(left - right));
+  ASSERT_TRUE((sparse_left * 3.0).ToDense().EqMatrix(left * 3.0));
+  ASSERT_EQ((sparse_left - sparse_left).NonZeros(), 0U);
+  ASSERT_EQ((sparse_left * 0.0).NonZeros(), 0U);
+  ASSERT_THROW(static_cast<void>(sparse_left + S21SparseMatrix(30, 40)),
+               std::invalid_argument);
+}
+
+TEST(SparseMatrixTest, ProductsMatchDenseOnAllThreadCounts) {
+  const S21Matrix left{RandomSparseDense(600, 500, 0.06, 4)};
+  const S21Matrix right{RandomSparseDense(500, 70, 0.06, 5)};
+  const S21Matrix expected{left * right};
+  const S21Matrix vector{RandomSparseDense(500, 1, 1.0, 6)};
+  const std::vector<double> expected_vector{Column(left * vector)};
+
+  for (SparseFormat format : {SparseFormat::kCsr, SparseFormat::kCsc}) {
+    const S21SparseMatrix sparse_left{left, format};
+    const S21SparseMatrix sparse_right{right, SparseFormat::kCsr};
+    for (int threads : {1, 4}) {
+      ASSERT_TRUE(sparse_left.Multiply(right, threads).EqMatrix(expected));
+      ASSERT_TRUE(
+          sparse_left.Multiply(sparse_right, threads).ToDense().EqMatrix(
+              expected));
+
+      const std::vector<double> product{
+          sparse_left.Multiply(Column(vector), threads)};
+      ASSERT_EQ(product.size(), expected_vector.size());
+      for (std::size_t i{0}; i < product.size(); ++i) {
+        ASSERT_NEAR(product[i], expected_vector[i], 1e-9);
+      }
+    }
+  }
+
+  ASSERT_THROW(static_cast<void>(S21SparseMatrix(left) * left),
+               std::invalid_argument);
+  const std::vector<double> short_vector(3);
+  ASSERT_THROW(static_cast<void>(S21SparseMatrix(left) * short_vector),
+               std::invalid_argument);
+}
+
+TEST(SparseMatrixTest, ComplexProductMatchesDense) {
+  using Complex = std::complex<double>;
+  S21BasicMatrix<Complex> left{3, 3};
+  S21BasicMatrix<Complex> right{3, 2};
+  left(0, 1) = Complex{0.0, 1.0};
+  left(2, 0) = Complex{2.0, -1.0};
+  right(1, 0) = Complex{3.0, 0.0};
+  right(0, 1) = Complex{1.0, 1.0};
+
+  const S21BasicSparseMatrix<Complex> sparse_left{left};
+  const S21BasicSparseMatrix<Complex> sparse_right{right};
+  ASSERT_TRUE((sparse_left * sparse_right).ToDense().EqMatrix(left * right));
+}
+}  // namespace s21
@@ -1,5 +1,10 @@
 #include "tests.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
 namespace s21 {
 void S21MatrixTest::SetUp() {
   matrix1x1(0, 0) = 5;
@@ -10,6 +15,25 @@ void S21MatrixTest::SetUp() {
   SetUp7x7Matrix();
 }
 
+TemporaryFile::TemporaryFile(const std::string& name)
+    : path_{::testing::TempDir() + name} {}
+
+TemporaryFile::~TemporaryFile() { std::remove(path_.c_str()); }
+
+void TemporaryFile::Write(const std::string& text) const {
+  std::ofstream file{path_, std::ios::binary | std::ios::trunc};
+  file << text;
+}
+
+S21Matrix RandomMatrix(int rows, int cols, unsigned seed, double range) {
+  std::mt19937 generator{seed};
+  std::uniform_real_distribution<double> distribution{-range, range};
+  S21Matrix matrix{rows, cols};
+  std::generate_n(matrix.data(), rows * cols,
+                  [&] { return distribution(generator); });
+  return matrix;
+}
+
 void S21MatrixTest::SetUp2x2Matrix() {
   matrix2x2(0, 0) = 1;
   matrix2x2(0, 1) = 2;
@@ -73,6 +97,39 @@ TEST_F(S21MatrixTest, EqMatrixTest) {
   ASSERT_FALSE(matrix3x3.EqMatrix(matrix));
 }
 
+TEST_F(S21MatrixTest, CompareTest) {
+  S21Matrix other{matrix3x3};
+  other(1, 2) += 1e-3;
+  other(2, 0) += 2e-3;
+  const Comparison comparison{
+      matrix3x3.Compare(other, {Tolerance::kAbsolute, 1e-7})};
+  ASSERT_FALSE(comparison.equal);
+  ASSERT_EQ(comparison.row, 1);
+  ASSERT_EQ(comparison.column, 2);
+  ASSERT_NEAR(comparison.max_error, 2e-3, 1e-12);
+  const Comparison same{matrix3x3.Compare(matrix3x3, {})};
+  ASSERT_TRUE(same.equal);
+  ASSERT_EQ(same.row, -1);
+  ASSERT_EQ(same.max_error, 0.0);
+  ASSERT_TRUE(matrix3x3.EqMatrix(other, {Tolerance::kRelative, 1e-3}));
+  ASSERT_FALSE(matrix3x3.EqMatrix(other, {Tolerance::kUlp, 1e6}));
+  EXPECT_THROW(static_cast<void>(matrix3x3.Compare(matrix2x2, {})),
+               std::invalid_argument);
+
+  const S21Matrix large{matrix3x3 * 1e12};
+  S21Matrix nudged{large};
+  nudged(0, 0) = std::nextafter(large(0, 0), 0.0);
+  ASSERT_FALSE(large.EqMatrix(nudged));
+  ASSERT_TRUE(large.EqMatrix(nudged, {Tolerance::kUlp, 1.0}));
+  ASSERT_TRUE(large.EqMatrix(nudged, {Tolerance::kRelative, 1e-15}));
+
+  S21Matrix undefined{matrix2x2};
+  undefined(1, 1) = std::numeric_limits<double>::quiet_NaN();
+  ASSERT_FALSE(undefined.EqMatrix(undefined));
+  ASSERT_EQ(undefined.Compare(matrix2x2, {Tolerance::kAbsolute, 1.0}).max_error,
+            std::numeric_limits<double>::infinity());
+}
+
 TEST_F(S21MatrixTest, SumMatrixTest) {
   matrix3x3.SumMatrix(matrix3x3);
   s21::S21Matrix result{3, 3};
@@ -121,6 +178,89 @@ TEST_F(S21MatrixTest, MulMatrixTest) {
   EXPECT_THROW(matrix3x3.MulMatrix(matrix2x2), std::invalid_argument);
 }
 
+TEST_F(S21MatrixTest, MulMatrixNonSquareTest) {
+  S21Matrix other{3, 4};
+  for (int i{0}; i < 3; ++i) {
+    for (int j{0}; j < 4; ++j) {
+      other(i, j) = i - j;
+    }
+  }
+
+  matrix2x3.MulMatrix(other);
+  ASSERT_EQ(matrix2x3.GetRows(), 2);
+  ASSERT_EQ(matrix2x3.GetCols(), 4);
+  s21::S21Matrix result{2, 4};
+  result(0, 0) = 8;
+  result(0, 1) = 2;
+  result(0, 2) = -4;
+  result(0, 3) = -10;
+
+  result(1, 0) = 11;
+  result(1, 1) = 0;
+  result(1, 2) = -11;
+  result(1, 3) = -22;
+
+  ASSERT_EQ(matrix2x3, result);
+}
+
+TEST_F(S21MatrixTest, MulMatrixBlockedTest) {
+  const int m{131};
+  const int k{263};
+  const int n{70};
+  S21Matrix left{m, k};
+  S21Matrix right{k, n};
+  for (int i{0}; i < m; ++i) {
+    for (int j{0}; j < k; ++j) {
+      left(i, j) = ((i * 7 + j * 3) % 11) - 5;
+    }
+  }
+  for (int i{0}; i < k; ++i) {
+    for (int j{0}; j < n; ++j) {
+      right(i, j) = ((i * 5 + j * 2) % 13) - 6;
+    }
+  }
+
+  S21Matrix product{left * right};
+  ASSERT_EQ(product.GetRows(), m);
+  ASSERT_EQ(product.GetCols(), n);
+  for (int i{0}; i < m; ++i) {
+    for (int j{0}; j < n; ++j) {
+      double expected{0.0};
+      for (int p{0}; p < k; ++p) {
+        expected += left(i, p) * right(p, j);
+      }
+      ASSERT_DOUBLE_EQ(product(i, j), expected);
+    }
+  }
+
+  EXPECT_THROW([[maybe_unused]] auto discard{right * right},
+               std::invalid_argument);
+}
+
+TEST_F(S21MatrixTest, MulMatrixThreadedTest) {
+  const int size{200};
+  S21Matrix left{size, size};
+  S21Matrix right{size, size + 7};
+  for (int i{0}; i < size; ++i) {
+    for (int j{0}; j < size; ++j) {
+      left(i, j) = (i + 2 * j) % 9 - 4;
+    }
+    for (int j{0}; j < size + 7; ++j) {
+      right(i, j) = (3 * i + j) % 7 - 3;
+    }
+  }
+
+  S21Matrix single{left};
+  single.MulMatrix(right, 1);
+  S21Matrix threaded{left};
+  threaded.MulMatrix(right, 4);
+  ASSERT_EQ(single, threaded);
+  ASSERT_EQ(single, left * right);
+  S21Matrix by_default{left};
+  by_default.MulMatrix(right, 0);
+  ASSERT_EQ(single, by_default);
+}
+
 TEST_F(S21MatrixTest, MulNumberTest) {
   matrix3x3.MulNumber(-10);
   s21::S21Matrix result{3, 3};
@@ -154,6 +294,112 @@ TEST_F(S21MatrixTest, TransposeTest) {
   ASSERT_EQ(transposed, result);
 }
 
+TEST_F(S21MatrixTest, TransposeLargeTest) {
+  S21Matrix matrix{77, 130};
+  for (int i{0}; i < matrix.GetRows(); ++i) {
+    for (int j{0}; j < matrix.GetCols(); ++j) {
+      matrix(i, j) = i * 1000 + j;
+    }
+  }
+
+  S21Matrix transposed{matrix.Transpose()};
+  ASSERT_EQ(transposed.GetRows(), 130);
+  ASSERT_EQ(transposed.GetCols(), 77);
+  for (int i{0}; i < matrix.GetRows(); ++i) {
+    for (int j{0}; j < matrix.GetCols(); ++j) {
+      ASSERT_EQ(transposed(j, i), matrix(i, j));
+    }
+  }
+  ASSERT_EQ(transposed.Transpose(), matrix);
+}
+
+TEST_F(S21MatrixTest, TransposeInPlaceTest) {
+  S21Matrix expected{matrix2x3.Transpose()};
+  const double* storage{matrix2x3.data()};
+  matrix2x3.TransposeInPlace();
+  ASSERT_EQ(matrix2x3, expected);
+  ASSERT_EQ(matrix2x3.data(), storage);
+
+  for (int size : {1, 8, 45, 100}) {
+    S21Matrix square{size, size};
+    for (int i{0}; i < size; ++i) {
+      for (int j{0}; j < size; ++j) {
+        square(i, j) = i * size + j;
+      }
+    }
+    S21Matrix square_expected{square.Transpose()};
+    square.TransposeInPlace();
+    ASSERT_EQ(square, square_expected);
+  }
+
+  for (auto [rows, cols] : {std::pair{1, 9}, {9, 1}, {5, 12}, {64, 37}}) {
+    S21Matrix rectangle{rows, cols};
+    for (int i{0}; i < rows; ++i) {
+      for (int j{0}; j < cols; ++j) {
+        rectangle(i, j) = i * cols + j;
+      }
+    }
+    S21Matrix rectangle_expected{rectangle.Transpose()};
+    rectangle.TransposeInPlace();
+    ASSERT_EQ(rectangle.GetRows(), cols);
+    ASSERT_EQ(rectangle.GetCols(), rows);
+    ASSERT_EQ(rectangle, rectangle_expected);
+  }
+}
+
+TEST_F(S21MatrixTest, AtUncheckedTest) {
+  ASSERT_DOUBLE_EQ(matrix3x3.AtUnchecked(1, 2), matrix3x3(1, 2));
+  matrix3x3.AtUnchecked(2, 0) = 42.0;
+  ASSERT_DOUBLE_EQ(matrix3x3(2, 0), 42.0);
+}
+
+TEST_F(S21MatrixTest, ViewsTest) {
+  S21Matrix matrix{4, 5};
+  for (int i{0}; i < 4; ++i) {
+    for (int j{0}; j < 5; ++j) {
+      matrix(i, j) = i * 5 + j;
+    }
+  }
+
+  double row_sum{0.0};
+  for (double value : matrix.Row(2)) {
+    row_sum += value;
+  }
+  ASSERT_DOUBLE_EQ(row_sum, 10.0 + 11.0 + 12.0 + 13.0 + 14.0);
+
+  double column_sum{0.0};
+  for (double value : matrix.Col(3)) {
+    column_sum += value;
+  }
+  ASSERT_DOUBLE_EQ(column_sum, 3.0 + 8.0 + 13.0 + 18.0);
+
+  SubMatrixView<double> block{matrix.Block(1, 1, 2, 3)};
+  ASSERT_EQ(block.GetRows(), 2);
+  ASSERT_EQ(block.GetCols(), 3);
+  ASSERT_DOUBLE_EQ(block(1, 2), matrix(2, 3));
+  block.Col(0)[1] = -1.0;
+  ASSERT_DOUBLE_EQ(matrix(2, 1), -1.0);
+
+  S21Matrix copy{matrix.Block(1, 1, 2, 3)};
+  ASSERT_EQ(copy.GetRows(), 2);
+  ASSERT_EQ(copy.GetCols(), 3);
+  for (int i{0}; i < 2; ++i) {
+    for (int j{0}; j < 3; ++j) {
+      ASSERT_DOUBLE_EQ(copy(i, j), matrix(i + 1, j + 1));
+    }
+  }
+
+  matrix.Block(0, 0, 2, 3).Assign(copy.View());
+  ASSERT_DOUBLE_EQ(matrix(0, 0), copy(0, 0));
+  ASSERT_DOUBLE_EQ(matrix(1, 2), copy(1, 2));
+
+  ASSERT_THROW(static_cast<void>(matrix.Row(4)), std::out_of_range);
+  ASSERT_THROW(static_cast<void>(matrix.Col(-1)), std::out_of_range);
+  ASSERT_THROW(static_cast<void>(matrix.Block(3, 0, 2, 1)), std::out_of_range);
+  ASSERT_THROW(matrix.Block(0, 0, 2, 2).Assign(copy.View()),
+               std::invalid_argument);
+}
+
 TEST_F(S21MatrixTest, CalcComplementsTest) {
   S21Matrix matrix{matrix1x1.CalcComplements()};
   S21Matrix identity{1, 1};
@@ -174,6 +420,78 @@ TEST_F(S21MatrixTest, CalcComplementsTest) {
                std::invalid_argument);
 }
 
+TEST_F(S21MatrixTest, CalcComplementsSingularTest) {
+  S21Matrix complements{matrix3x3.CalcComplements()};
+  s21::S21Matrix result{3, 3};
+  result(0, 0) = -3;
+  result(0, 1) = 6;
+  result(0, 2) = -3;
+
+  result(1, 0) = 6;
+  result(1, 1) = -12;
+  result(1, 2) = 6;
+
+  result(2, 0) = -3;
+  result(2, 1) = 6;
+  result(2, 2) = -3;
+
+  ASSERT_EQ(complements, result);
+  ASSERT_EQ(matrix7x7.CalcComplements(), (S21Matrix{7, 7}));
+
+  S21Matrix zero_pivot{3, 3};
+  zero_pivot(0, 1) = 1;
+  zero_pivot(1, 2) = 1;
+  s21::S21Matrix zero_pivot_result{3, 3};
+  zero_pivot_result(2, 0) = 1;
+  ASSERT_EQ(zero_pivot.CalcComplements(), zero_pivot_result);
+}
+
+TEST_F(S21MatrixTest, CalcComplementsRankDeficientTest) {
+  const int size{5};
+  S21Matrix matrix{size, size};
+  for (int i{0}; i < size - 1; ++i) {
+    for (int j{0}; j < size; ++j) {
+      matrix(i, j) = (i * 3 + j * j) % 7 - 3 + (i == j ? 2 : 0);
+    }
+  }
+  for (int j{0}; j < size; ++j) {
+    matrix(size - 1, j) = matrix(0, j) - 2 * matrix(2, j);
+  }
+
+  S21Matrix complements{matrix.CalcComplements()};
+  for (int row{0}; row < size; ++row) {
+    for (int column{0}; column < size; ++column) {
+      S21Matrix minor_matrix{size - 1, size - 1};
+      for (int i{0}, minor_row{0}; i < size; ++i) {
+        if (i == row) continue;
+        for (int j{0}, minor_column{0}; j < size; ++j) {
+          if (j == column) continue;
+          minor_matrix(minor_row, minor_column++) = matrix(i, j);
+        }
+        ++minor_row;
+      }
+      const double sign{(row + column) % 2 == 0 ? 1.0 : -1.0};
+      ASSERT_NEAR(complements(row, column), sign * minor_matrix.Determinant(),
+                  1e-9);
+    }
+  }
+}
+
+TEST_F(S21MatrixTest, CalcComplementsLargeTest) {
+  const int size{12};
+  S21Matrix matrix{size, size};
+  S21Matrix identity{size, size};
+  for (int i{0}; i < size; ++i) {
+    for (int j{0}; j < size; ++j) {
+      matrix(i, j) = (i * 7 + j * 3) % 5 - 2 + (i == j ? 4 : 0);
+    }
+    identity(i, i) = 1;
+  }
+
+  S21Matrix adjugate{matrix.CalcComplements().Transpose()};
+  ASSERT_EQ(matrix * adjugate * (1.0 / matrix.Determinant()), identity);
+}
+
 TEST_F(S21MatrixTest, DeterminantTest) {
   double determinant2x2{matrix2x2.Determinant()};
   double determinant3x3{matrix3x3.Determinant()};
@@ -187,6 +505,94 @@ TEST_F(S21MatrixTest, DeterminantTest) {
                std::invalid_argument);
 }
 
+TEST_F(S21MatrixTest, BadlyScaledMatrixTest) {
+  S21Matrix tiny{2, 2};
+  tiny(0, 0) = 1.0;
+  tiny(1, 1) = 1e-16;
+  ASSERT_DOUBLE_EQ(tiny.Determinant(), 1e-16);
+  ASSERT_FALSE(tiny.LUDecompose().IsSingular());
+  ASSERT_DOUBLE_EQ(tiny.InverseMatrix()(1, 1), 1e16);
+
+  S21Matrix scaled{2, 2};
+  scaled(0, 0) = 1e10;
+  scaled(1, 1) = 1e-7;
+  ASSERT_DOUBLE_EQ(scaled.Determinant(), 1e3);
+  const S21Matrix inverse{scaled.InverseMatrix()};
+  ASSERT_DOUBLE_EQ(inverse(0, 0), 1e-10);
+  ASSERT_DOUBLE_EQ(inverse(1, 1), 1e7);
+  const S21Matrix complements{scaled.CalcComplements()};
+  ASSERT_DOUBLE_EQ(complements(0, 0), 1e-7);
+  ASSERT_DOUBLE_EQ(complements(1, 1), 1e10);
+  ASSERT_DOUBLE_EQ(complements(0, 1), 0.0);
+  ASSERT_DOUBLE_EQ(complements(1, 0), 0.0);
+
+  // A tolerance replaces the default rounding-level threshold.
+  S21Matrix close{2, 2};
+  close(0, 0) = 1.0;
+  close(0, 1) = 1.0;
+  close(1, 0) = 1.0;
+  close(1, 1) = 1.0 + 1e-13;
+  ASSERT_FALSE(close.LUDecompose().IsSingular());
+  ASSERT_TRUE(close.LUDecompose(1e-12).IsSingular());
+  ASSERT_DOUBLE_EQ(close.LUDecompose(1e-12).Determinant(), 0.0);
+}
+
+TEST_F(S21MatrixTest, DeterminantLargeTest) {
+  const int size{40};
+  S21Matrix tridiagonal{size, size};
+  for (int i{0}; i < size; ++i) {
+    tridiagonal(i, i) = 2;
+    if (i > 0) tridiagonal(i, i - 1) = -1;
+    if (i + 1 < size) tridiagonal(i, i + 1) = -1;
+  }
+
+  ASSERT_NEAR(tridiagonal.Determinant(), size + 1, 1e-9);
+}
+
+TEST_F(S21MatrixTest, LUDecomposeTest) {
+  S21Matrix matrix{4, 4};
+  const double values[4][4]{
+      {2, -1, 0, 3}, {4, 1, -2, 1}, {-6, 3, 5, 0}, {1, 7, 2, -4}};
+  for (int i{0}; i < 4; ++i) {
+    for (int j{0}; j < 4; ++j) {
+      matrix(i, j) = values[i][j];
+    }
+  }
+
+  LUDecomposition lu{matrix.LUDecompose()};
+  ASSERT_FALSE(lu.IsSingular());
+  S21Matrix permuted{4, 4};
+  for (int i{0}; i < 4; ++i) {
+    for (int j{0}; j < 4; ++j) {
+      permuted(i, j) = matrix(lu.GetPermutation()[i], j);
+    }
+  }
+  ASSERT_EQ(lu.GetL() * lu.GetU(), permuted);
+  ASSERT_DOUBLE_EQ(lu.GetU()(1, 0), 0.0);
+  ASSERT_DOUBLE_EQ(lu.GetL()(0, 1), 0.0);
+  ASSERT_DOUBLE_EQ(lu.GetL()(2, 2), 1.0);
+  ASSERT_TRUE(lu.GetSign() == 1 || lu.GetSign() == -1);
+  ASSERT_NEAR(lu.Determinant(), matrix.Determinant(), 1e-9);
+  ASSERT_NEAR(lu.Determinant(), -168.0, 1e-9);
+
+  S21Matrix rhs{4, 2};
+  for (int i{0}; i < 4; ++i) {
+    rhs(i, 0) = i + 1;
+    rhs(i, 1) = -i;
+  }
+  ASSERT_EQ(matrix * lu.Solve(rhs), rhs);
+
+  ASSERT_TRUE(matrix3x3.LUDecompose().IsSingular());
+  ASSERT_TRUE(matrix7x7.LUDecompose().IsSingular());
+  EXPECT_THROW([[maybe_unused]] auto discard{matrix3x3.LUDecompose().Solve(
+                   matrix3x3)},
+               std::runtime_error);
+  EXPECT_THROW([[maybe_unused]] auto discard{lu.Solve(matrix3x3)},
+               std::invalid_argument);
+  EXPECT_THROW([[maybe_unused]] auto discard{matrix2x3.LUDecompose()},
+               std::invalid_argument);
+}
+
 TEST_F(S21MatrixTest, InverseMatrixTest) {
   S21Matrix inverse1x1{matrix1x1.InverseMatrix()};
   s21::S21Matrix result1x1{1, 1};
@@ -209,6 +615,48 @@ TEST_F(S21MatrixTest, InverseMatrixTest) {
                std::runtime_error);
 }
 
+TEST_F(S21MatrixTest, InverseMatrixLargeTest) {
+  const int size{30};
+  S21Matrix matrix{size, size};
+  S21Matrix identity{size, size};
+  for (int i{0}; i < size; ++i) {
+    for (int j{0}; j < size; ++j) {
+      matrix(i, j) = 1.0 / (1 + (i * 3 + j * 5) % 17);
+    }
+    matrix(i, i) += size;
+    identity(i, i) = 1;
+  }
+
+  S21Matrix inverse{matrix.InverseMatrix()};
+  ASSERT_EQ(matrix * inverse, identity);
+  ASSERT_EQ(inverse * matrix, identity);
+}
+
+TEST_F(S21MatrixTest, SolveTest) {
+  S21Matrix rhs{2, 3};
+  rhs(0, 0) = 5;
+  rhs(0, 1) = 1;
+  rhs(0, 2) = 0;
+  rhs(1, 0) = 11;
+  rhs(1, 1) = 0;
+  rhs(1, 2) = 1;
+
+  S21Matrix solution{matrix2x2.Solve(rhs)};
+  ASSERT_EQ(solution.GetRows(), 2);
+  ASSERT_EQ(solution.GetCols(), 3);
+  ASSERT_EQ(matrix2x2 * solution, rhs);
+  ASSERT_DOUBLE_EQ(solution(0, 0), 1.0);
+  ASSERT_DOUBLE_EQ(solution(1, 0), 2.0);
+
+  EXPECT_THROW([[maybe_unused]] auto discard{matrix2x3.Solve(rhs)},
+               std::invalid_argument);
+  EXPECT_THROW([[maybe_unused]] auto discard{matrix3x3.Solve(rhs)},
+               std::invalid_argument);
+  S21Matrix column_rhs{matrix2x3.Transpose()};
+  EXPECT_THROW([[maybe_unused]] auto discard{matrix3x3.Solve(column_rhs)},
+               std::runtime_error);
+}
+
 TEST_F(S21MatrixTest, OperatorPlusTest) {
   matrix3x3 = matrix3x3 + matrix3x3;
   s21::S21Matrix result{3, 3};
@@ -282,6 +730,37 @@ TEST_F(S21MatrixTest, OperatorMulMatrixTest) {
   ASSERT_EQ(result, matrix3x3);
 }
 
+TEST_F(S21MatrixTest, ExpressionChainTest) {
+  S21Matrix doubled{matrix3x3 * 2.0};
+  S21Matrix chained{matrix3x3 + doubled - matrix3x3 * 2.0 + 0.5 * matrix3x3};
+  s21::S21Matrix result{3, 3};
+  for (int i{0}; i < 3; ++i) {
+    for (int j{0}; j < 3; ++j) {
+      result(i, j) = 1.5 * matrix3x3(i, j);
+    }
+  }
+  ASSERT_EQ(chained, result);
+
+  S21Matrix target{1, 1};
+  target = (matrix2x3 - matrix2x3) * 4.0 + matrix2x3;
+  ASSERT_EQ(target, matrix2x3);
+
+  S21Matrix product{(matrix2x2 + matrix2x2) * matrix2x3};
+  ASSERT_EQ(product, matrix2x2 * matrix2x3 * 2.0);
+
+  EXPECT_THROW([[maybe_unused]] auto discard{matrix2x2 + matrix2x3},
+               std::invalid_argument);
+  EXPECT_THROW([[maybe_unused]] auto discard{matrix3x3 - matrix2x2 * 2.0},
+               std::invalid_argument);
+}
+
+TEST_F(S21MatrixTest, ScalarLeftMulDoesNotMutateTest) {
+  S21Matrix original{matrix2x2};
+  S21Matrix tripled{3 * matrix2x2};
+  ASSERT_EQ(matrix2x2, original);
+  ASSERT_EQ(tripled, matrix2x2 * 3);
+}
+
 TEST_F(S21MatrixTest, OperatorEqualsTest) {
   ASSERT_TRUE(matrix3x3 == matrix3x3);
   ASSERT_FALSE(matrix2x3 == matrix3x3);
@@ -411,6 +890,71 @@ TEST_F(S21MatrixTest, MutatorsTest) {
   EXPECT_THROW(matrix3x3.SetRows(-5), std::out_of_range);
   EXPECT_THROW(matrix3x3.SetCols(-5), std::out_of_range);
 }
+
+TEST_F(S21MatrixTest, ContiguousStorageTest) {
+  ASSERT_EQ(matrix2x3.stride(), 3);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(matrix2x3.data()) % 64, 0U);
+  for (int i{0}; i < matrix2x3.GetRows(); ++i) {
+    for (int j{0}; j < matrix2x3.GetCols(); ++j) {
+      ASSERT_EQ(&matrix2x3(i, j),
+                matrix2x3.data() + i * matrix2x3.stride() + j);
+    }
+  }
+
+  matrix2x3.SetCols(2);
+  ASSERT_EQ(matrix2x3.stride(), 2);
+  ASSERT_EQ(matrix2x3(1, 0), 4);
+  ASSERT_EQ(matrix2x3(1, 1), 3);
+
+  matrix2x3.SetRows(3);
+  ASSERT_EQ(matrix2x3(1, 1), 3);
+  ASSERT_EQ(matrix2x3(2, 1), 0);
+
+  S21Matrix copy{3, 2};
+  copy = matrix2x3;
+  ASSERT_EQ(copy, matrix2x3);
+  ASSERT_NE(copy.data(), matrix2x3.data());
+}
+
+TEST_F(S21MatrixTest, StrassenWinogradMultiplicationTest) {
+  S21Matrix left{70, 61};
+  S21Matrix right{61, 83};
+  for (int i{0}; i < 70; ++i) {
+    for (int j{0}; j < 61; ++j) left(i, j) = std::sin(i * 61.0 + j);
+  }
+  for (int i{0}; i < 61; ++i) {
+    for (int j{0}; j < 83; ++j) right(i, j) = std::cos(i * 83.0 + j);
+  }
+  const S21Matrix expected{left * right};
+
+  MulOptions options;
+  options.algorithm = MulAlgorithm::kStrassenWinograd;
+  options.strassen_cutoff = 8;
+  const MulErrorBound estimate{left.EstimateMulError(right, options)};
+  ASSERT_EQ(estimate.recursion_levels, 3);
+  ASSERT_GT(estimate.bound,
+            left.EstimateMulError(right, MulOptions{}).bound);
+
+  S21Matrix product{left};
+  product.MulMatrix(right, options);
+  for (int i{0}; i < 70; ++i) {
+    for (int j{0}; j < 83; ++j) {
+      ASSERT_LE(std::abs(product(i, j) - expected(i, j)), estimate.bound);
+    }
+  }
+
+  SetDefaultMulOptions(options);
+  ASSERT_EQ(GetDefaultMulOptions().algorithm,
+            MulAlgorithm::kStrassenWinograd);
+  ASSERT_TRUE(left * right == expected);
+  SetDefaultMulOptions({});
+
+  options.strassen_cutoff = 0;
+  ASSERT_THROW(SetDefaultMulOptions(options), std::invalid_argument);
+  ASSERT_THROW(product.MulMatrix(right, options), std::invalid_argument);
+  const S21BasicMatrix<std::int32_t> integers{2, 2};
+  ASSERT_EQ(integers.EstimateMulError(integers).bound, 0.0);
+}
 }  // namespace s21
 
 int main(int argc, char* argv[]) {
@@ -3,6 +3,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <string>
+
 #include "../s21_matrix_oop.h"
 
 namespace s21 {
@@ -22,6 +25,25 @@ class S21MatrixTest : public ::testing::Test {
   void SetUp3x3Matrix();
   void SetUp7x7Matrix();
 };
+
+// File in the test temporary directory, removed on destruction.
+class TemporaryFile {
+ public:
+  explicit TemporaryFile(const std::string& name);
+  ~TemporaryFile();
+
+  [[nodiscard]] const std::string& path() const { return path_; }
+
+  // Replaces the contents of the file with text.
+  void Write(const std::string& text) const;
+
+ private:
+  std::string path_;
+};
+
+// Elements drawn uniformly from [-range, range), the same for equal seeds.
+[[nodiscard]] S21Matrix RandomMatrix(int rows, int cols, unsigned seed,
+                                     double range = 1.0);
 }  // namespace s21
 
 #endif
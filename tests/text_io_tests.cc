@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <string>
+
+#include "../s21_matrix_text.h"
+#include "tests.h"
+
+namespace s21 {
+namespace {
+bool BitwiseEqual(const S21Matrix& left, const S21Matrix& right) {
+  return left.GetRows() == right.GetRows() &&
+         left.GetCols() == right.GetCols() &&
+         std::equal(left.data(), left.data() + left.GetRows() * left.GetCols(),
+                    right.data());
+}
+}  // namespace
+
+TEST(TextIoTest, CsvRoundTripsExactlyInParallel) {
+  const TemporaryFile file{"s21_round_trip.csv"};
+  const S21Matrix matrix{RandomMatrix(700, 300, 7, 1e6)};
+  CsvOptions options;
+  options.num_threads = 4;
+
+  WriteCsv(matrix, file.path(), options);
+  ASSERT_TRUE(BitwiseEqual(ReadCsv<double>(file.path(), options), matrix));
+
+  options.num_threads = 1;
+  options.delimiter = '\t';
+  WriteCsv(matrix, file.path(), options);
+  ASSERT_TRUE(BitwiseEqual(ReadCsv<double>(file.path(), options), matrix));
+}
+
+TEST(TextIoTest, CsvParsingOptionsAndErrors) {
+  const TemporaryFile file{"s21_options.csv"};
+  file.Write("a;b;c\r\n1; +2.5 ;-3e2\r\n\r\n4;5;6\r\n");
+  CsvOptions options;
+  options.delimiter = ';';
+  options.skip_lines = 1;
+  const S21Matrix matrix{ReadCsv<double>(file.path(), options)};
+  ASSERT_EQ(matrix.GetRows(), 2);
+  ASSERT_EQ(matrix.GetCols(), 3);
+  ASSERT_DOUBLE_EQ(matrix(0, 1), 2.5);
+  ASSERT_DOUBLE_EQ(matrix(0, 2), -300.0);
+  ASSERT_DOUBLE_EQ(matrix(1, 0), 4.0);
+
+  file.Write("1 2   3\n4\t5 6\n");
+  options = {};
+  options.delimiter = ' ';
+  const S21BasicMatrix<std::int64_t> integers{
+      ReadCsv<std::int64_t>(file.path(), options)};
+  ASSERT_EQ(integers(1, 2), 6);
+
+  file.Write("1,2\n3,x\n");
+  ASSERT_THROW(static_cast<void>(ReadCsv<double>(file.path())),
+               std::runtime_error);
+  file.Write("1,2\n3,4,5\n");
+  ASSERT_THROW(static_cast<void>(ReadCsv<double>(file.path())),
+               std::runtime_error);
+  file.Write("\n\n");
+  ASSERT_THROW(static_cast<void>(ReadCsv<double>(file.path())),
+               std::runtime_error);
+}
+
+TEST(TextIoTest, MatrixMarketSymmetriesAreExpanded) {
+  const TemporaryFile file{"s21_symmetric.mtx"};
+  file.Write(
+      "%%MatrixMarket matrix coordinate real symmetric\n"
+      "% comment\n"
+      "3 3 3\n"
+      "1 1 2.0\n"
+      "3 1 -1.5\n"
+      "2 2 4\n");
+  const S21SparseMatrix sparse{ReadMatrixMarketSparse<double>(file.path())};
+  ASSERT_EQ(sparse.NonZeros(), 4U);
+  ASSERT_DOUBLE_EQ(sparse(0, 2), -1.5);
+  ASSERT_DOUBLE_EQ(ReadMatrixMarket<double>(file.path())(2, 0), -1.5);
+
+  file.Write(
+      "%%MatrixMarket matrix array integer skew-symmetric\n"
+      "3 3\n"
+      "1\n2\n3\n");
+  const S21BasicMatrix<std::int32_t> skew{
+      ReadMatrixMarket<std::int32_t>(file.path())};
+  ASSERT_EQ(skew(1, 0), 1);
+  ASSERT_EQ(skew(0, 1), -1);
+  ASSERT_EQ(skew(2, 1), 3);
+  ASSERT_EQ(skew(1, 1), 0);
+
+  file.Write(
+      "%%MatrixMarket matrix coordinate complex hermitian\n"
+      "2 2 1\n"
+      "2 1 1.0 2.0\n");
+  using Complex = std::complex<double>;
+  const S21BasicMatrix<Complex> hermitian{
+      ReadMatrixMarket<Complex>(file.path())};
+  const Complex lower{1.0, 2.0};
+  const Complex upper{1.0, -2.0};
+  ASSERT_EQ(hermitian(1, 0), lower);
+  ASSERT_EQ(hermitian(0, 1), upper);
+
+  file.Write("%%MatrixMarket matrix coordinate pattern general\n2 2 1\n1 2\n");
+  ASSERT_DOUBLE_EQ(ReadMatrixMarket<double>(file.path())(0, 1), 1.0);
+  ASSERT_EQ(ReadMatrixMarket<std::int32_t>(file.path())(0, 1), 1);
+
+  file.Write("%%MatrixMarket matrix array real general\n1 1\n0.5\n");
+  ASSERT_THROW(static_cast<void>(ReadMatrixMarket<std::int32_t>(file.path())),
+               std::runtime_error);
+}
+
+TEST(TextIoTest, MatrixMarketRoundTripsAndRejectsBadFiles) {
+  const TemporaryFile file{"s21_round_trip.mtx"};
+  const S21Matrix dense{RandomMatrix(300, 200, 8, 1e6)};
+  WriteMatrixMarket(dense, file.path(), 4);
+  ASSERT_TRUE(BitwiseEqual(ReadMatrixMarket<double>(file.path(), 4), dense));
+
+  S21Matrix mostly_zero{dense};
+  for (int i{0}; i < mostly_zero.GetRows(); ++i) {
+    for (int j{0}; j < mostly_zero.GetCols(); ++j) {
+      if ((i + j) % 3 != 0) mostly_zero(i, j) = 0.0;
+    }
+  }
+  const S21SparseMatrix sparse{mostly_zero, SparseFormat::kCsc};
+  WriteMatrixMarket(sparse, file.path(), 4);
+  ASSERT_TRUE(BitwiseEqual(
+      ReadMatrixMarketSparse<double>(file.path(), SparseFormat::kCsr, 4)
+          .ToDense(),
+      mostly_zero));
+
+  file.Write("%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1\n");
+  ASSERT_THROW(static_cast<void>(ReadMatrixMarket<double>(file.path())),
+               std::runtime_error);
+  file.Write("%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n");
+  ASSERT_THROW(static_cast<void>(ReadMatrixMarket<double>(file.path())),
+               std::runtime_error);
+  file.Write("1 2\n3 4\n");
+  ASSERT_THROW(static_cast<void>(ReadMatrixMarket<double>(file.path())),
+               std::runtime_error);
+}
+}  // namespace s21
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../s21_thread_pool.h"
+
+namespace s21 {
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+  ThreadPool pool{3};
+  ASSERT_EQ(pool.GetWorkerCount(), 3);
+
+  std::vector<std::atomic<int>> visits(1000);
+  pool.ParallelFor(
+      static_cast<int>(visits.size()), [&visits](int i) { ++visits[i]; }, 4);
+  for (const std::atomic<int>& count : visits) {
+    ASSERT_EQ(count, 1);
+  }
+
+  pool.ParallelFor(0, [](int) { FAIL(); }, 4);
+}
+
+TEST(ThreadPoolTest, ParallelForRunsOnAtMostTheWorkersAndTheCaller) {
+  ThreadPool pool{1};
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  std::atomic<int> calls{0};
+  pool.ParallelFor(
+      64,
+      [&](int) {
+        ++calls;
+        std::lock_guard lock{mutex};
+        threads.insert(std::this_thread::get_id());
+      },
+      8);
+  ASSERT_EQ(calls, 64);
+  ASSERT_LE(threads.size(), 2U);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrows) {
+  ThreadPool pool{2};
+  std::atomic<int> calls{0};
+  EXPECT_THROW(pool.ParallelFor(
+                   16,
+                   [&calls](int i) {
+                     ++calls;
+                     if (i == 5) throw std::runtime_error{"task failed"};
+                   },
+                   3),
+               std::runtime_error);
+  ASSERT_EQ(calls, 16);
+}
+
+TEST(ThreadPoolTest, NumThreadsSetting) {
+  const int initial{GetNumThreads()};
+  ASSERT_GE(initial, 1);
+
+  SetNumThreads(7);
+  ASSERT_EQ(GetNumThreads(), 7);
+  SetNumThreads(0);
+  ASSERT_EQ(GetNumThreads(), initial);
+}
+}  // namespace s21
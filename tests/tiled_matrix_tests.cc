@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "../s21_tiled_matrix.h"
+#include "tests.h"
+
+namespace s21 {
+namespace {
+double MaxDifference(const S21Matrix& left, const S21Matrix& right) {
+  double difference{0.0};
+  for (int i{0}; i < left.GetRows(); ++i) {
+    for (int j{0}; j < left.GetCols(); ++j) {
+      difference = std::max(difference, std::abs(left(i, j) - right(i, j)));
+    }
+  }
+
+  return difference;
+}
+
+// Eight tiles of 8x8 doubles, so that the operations below evict.
+TiledMatrixOptions SmallCache() {
+  TiledMatrixOptions options;
+  options.tile_size = 8;
+  options.cache_bytes = 8 * 8 * 8 * sizeof(double);
+  options.num_threads = 2;
+  return options;
+}
+}  // namespace
+
+TEST(TiledMatrixTest, BlocksRoundTripThroughTheFile) {
+  const TemporaryFile file{"s21_tiled_blocks.tiles"};
+  const S21Matrix matrix{RandomMatrix(37, 29, 1)};
+  {
+    auto tiled{TiledMatrix<double>::FromView(matrix.View(), file.path(),
+                                             SmallCache())};
+    ASSERT_EQ(tiled.GetRows(), 37);
+    ASSERT_EQ(tiled.GetCols(), 29);
+    ASSERT_TRUE(tiled.ToMatrix() == matrix);
+
+    const S21Matrix patch{RandomMatrix(11, 13, 2)};
+    tiled.WriteBlock(5, 3, patch.View());
+    ASSERT_TRUE(tiled.ReadBlock(5, 3, 11, 13) == patch);
+    ASSERT_DOUBLE_EQ(tiled.ReadBlock(4, 2, 1, 1)(0, 0), matrix(4, 2));
+    ASSERT_THROW(static_cast<void>(tiled.ReadBlock(30, 0, 8, 1)),
+                 std::out_of_range);
+  }
+
+  TiledMatrix<double> reopened{TiledMatrix<double>::Open(file.path())};
+  ASSERT_EQ(reopened.GetTileSize(), 8);
+  ASSERT_DOUBLE_EQ(reopened.ReadBlock(36, 28, 1, 1)(0, 0), matrix(36, 28));
+  ASSERT_THROW(static_cast<void>(TiledMatrix<float>::Open(file.path())),
+               std::runtime_error);
+}
+
+TEST(TiledMatrixTest, OperationsMatchInCoreResults) {
+  const TemporaryFile left_file{"s21_tiled_left.tiles"};
+  const TemporaryFile right_file{"s21_tiled_right.tiles"};
+  const TemporaryFile result_file{"s21_tiled_result.tiles"};
+  const S21Matrix left{RandomMatrix(37, 29, 3)};
+  const S21Matrix right{RandomMatrix(29, 21, 4)};
+  const S21Matrix other{RandomMatrix(37, 29, 5)};
+  const TiledMatrixOptions options{SmallCache()};
+  const auto tiled_left{
+      TiledMatrix<double>::FromView(left.View(), left_file.path(), options)};
+
+  {
+    const auto tiled_right{TiledMatrix<double>::FromView(
+        right.View(), right_file.path(), options)};
+    const auto product{tiled_left.Multiply(tiled_right, result_file.path())};
+    ASSERT_LT(MaxDifference(product.ToMatrix(), left * right), 1e-12);
+  }
+  {
+    const auto tiled_other{TiledMatrix<double>::FromView(
+        other.View(), right_file.path(), options)};
+    const auto sum{tiled_left.Add(tiled_other, result_file.path())};
+    ASSERT_TRUE(sum.ToMatrix() == S21Matrix{left + other});
+  }
+  {
+    const auto transpose{tiled_left.Transpose(result_file.path())};
+    ASSERT_TRUE(transpose.ToMatrix() == left.Transpose());
+  }
+
+  const TileCacheStatistics statistics{tiled_left.GetCacheStatistics()};
+  ASSERT_GT(statistics.hits, 0U);
+  ASSERT_LE(statistics.peak_resident_tiles, 8U + 4U);
+  ASSERT_THROW(
+      static_cast<void>(tiled_left.Multiply(tiled_left, result_file.path())),
+      std::invalid_argument);
+}
+
+TEST(TiledMatrixTest, LUDecompositionMatchesInCoreFactorization) {
+  const TemporaryFile file{"s21_tiled_lu.tiles"};
+  const S21Matrix matrix{RandomMatrix(45, 45, 6)};
+  TiledMatrixOptions options{SmallCache()};
+  // A column of tiles plus the ones the trailing update pins.
+  options.cache_bytes = 10 * 8 * 8 * sizeof(double);
+  auto tiled{
+      TiledMatrix<double>::FromView(matrix.View(), file.path(), options)};
+
+  const TiledLUResult result{tiled.LUDecomposeInPlace()};
+  const LUDecomposition<double> expected{matrix};
+  ASSERT_EQ(result.permutation, expected.GetPermutation());
+  ASSERT_EQ(result.sign, expected.GetSign());
+  ASSERT_FALSE(result.singular);
+
+  const S21Matrix factors{tiled.ToMatrix()};
+  S21Matrix lower{45, 45};
+  S21Matrix upper{45, 45};
+  for (int i{0}; i < 45; ++i) {
+    for (int j{0}; j < 45; ++j) {
+      if (i > j) {
+        lower(i, j) = factors(i, j);
+      } else {
+        upper(i, j) = factors(i, j);
+      }
+    }
+    lower(i, i) = 1.0;
+  }
+  ASSERT_LT(MaxDifference(lower, expected.GetL()), 1e-10);
+  ASSERT_LT(MaxDifference(upper, expected.GetU()), 1e-10);
+}
+
+TEST(TiledMatrixTest, SingularMatricesAreReported) {
+  const TemporaryFile file{"s21_tiled_singular.tiles"};
+  S21Matrix matrix{RandomMatrix(20, 20, 7)};
+  for (int j{0}; j < 20; ++j) matrix(19, j) = 2.0 * matrix(3, j);
+  auto tiled{
+      TiledMatrix<double>::FromView(matrix.View(), file.path(), SmallCache())};
+  ASSERT_TRUE(tiled.LUDecomposeInPlace().singular);
+
+  const TemporaryFile rectangular{"s21_tiled_rectangular.tiles"};
+  TiledMatrix<double> wide{rectangular.path(), 3, 5};
+  ASSERT_THROW(static_cast<void>(wide.LUDecomposeInPlace()),
+               std::invalid_argument);
+}
+}  // namespace s21